@@ -0,0 +1,111 @@
+#include <array>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#define CGLTF_IMPLEMENTATION
+#include <cgltf.h>
+
+#define CGLTF_WRITE_IMPLEMENTATION
+#include <cgltf_write.h>
+
+import gltf_asset;
+import log;
+
+namespace {
+
+using UniqueCgltfData = std::unique_ptr<cgltf_data, decltype(&cgltf_free)>;
+
+const std::filesystem::path kAssetsDirectory = VKTF_ASSETS_DIRECTORY;
+
+const std::array kSponzaGltfFilepaths{kAssetsDirectory / "Main.1_Sponza" / "NewSponza_Main_glTF_002.gltf",
+                                      kAssetsDirectory / "PKG_A_Curtains" / "NewSponza_Curtains_glTF.gltf",
+                                      kAssetsDirectory / "PKG_B_Ivy" / "NewSponza_IvyGrowth_glTF.gltf"};
+
+vktf::Log& GetNullLog() {
+  static std::ostream null_ostream{nullptr};  // discard messages to avoid measuring console output
+  static vktf::Log null_log{null_ostream, null_ostream, null_ostream};
+  return null_log;
+}
+
+std::filesystem::path CreateGlbFile(const std::filesystem::path& gltf_filepath) {
+  static constexpr cgltf_options kDefaultOptions{};
+  UniqueCgltfData cgltf_data{nullptr, cgltf_free};
+  const auto gltf_filepath_string = gltf_filepath.string();
+
+  if (cgltf_parse_file(&kDefaultOptions, gltf_filepath_string.c_str(), std::out_ptr(cgltf_data)) != cgltf_result_success
+      || cgltf_load_buffers(&kDefaultOptions, cgltf_data.get(), gltf_filepath_string.c_str()) != cgltf_result_success) {
+    throw std::runtime_error{std::format("Failed to load {}", gltf_filepath_string)};
+  }
+  if (cgltf_data->buffers_count != 1) {
+    throw std::runtime_error{std::format("Failed to convert {} with {} buffers to a binary glTF file",
+                                         gltf_filepath_string,
+                                         cgltf_data->buffers_count)};
+  }
+
+  // write the only glTF buffer to the BIN chunk which is sufficient because glTF loading does not read image files
+  auto& cgltf_buffer = cgltf_data->buffers[0];
+  auto* const cgltf_buffer_uri = std::exchange(cgltf_buffer.uri, nullptr);
+  cgltf_data->bin = cgltf_buffer.data;
+  cgltf_data->bin_size = cgltf_buffer.size;
+
+  auto glb_filepath = std::filesystem::temp_directory_path() / gltf_filepath.filename();
+  glb_filepath.replace_extension(".glb");
+
+  cgltf_options glb_options{};
+  glb_options.type = cgltf_file_type_glb;
+  const auto cgltf_result = cgltf_write_file(&glb_options, glb_filepath.string().c_str(), cgltf_data.get());
+
+  cgltf_buffer.uri = cgltf_buffer_uri;  // restore ownership of the buffer URI before it's released by cgltf_free
+  cgltf_data->bin = nullptr;
+  cgltf_data->bin_size = 0;
+
+  if (cgltf_result != cgltf_result_success) {
+    throw std::runtime_error{std::format("Failed to write {}", glb_filepath.string())};
+  }
+  return glb_filepath;
+}
+
+const std::vector<std::filesystem::path>& GetSponzaGlbFilepaths() {
+  static const auto kSponzaGlbFilepaths =
+      kSponzaGltfFilepaths | std::views::transform(CreateGlbFile) | std::ranges::to<std::vector>();
+  return kSponzaGlbFilepaths;
+}
+
+// load times are measured with a warm page cache after the first iteration to compare parsing rather than disk speed
+void LoadSponza(benchmark::State& state, const std::span<const std::filesystem::path> gltf_filepaths) {
+  const vktf::gltf::LoadOptions load_options{.map_buffers = state.range(0) != 0};
+  auto& log = GetNullLog();
+
+  for (auto _ : state) {
+    for (const auto& gltf_filepath : gltf_filepaths) {
+      auto gltf_asset = vktf::gltf::Load(gltf_filepath, log, load_options);
+      benchmark::DoNotOptimize(gltf_asset);
+    }
+  }
+}
+
+void LoadSponzaGltf(benchmark::State& state) { LoadSponza(state, kSponzaGltfFilepaths); }
+
+void LoadSponzaGlb(benchmark::State& state) {
+  try {
+    LoadSponza(state, GetSponzaGlbFilepaths());
+  } catch (const std::exception& exception) {
+    state.SkipWithError(exception.what());
+  }
+}
+
+BENCHMARK(LoadSponzaGltf)->ArgName("map_buffers")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(LoadSponzaGlb)->ArgName("map_buffers")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+}  // namespace
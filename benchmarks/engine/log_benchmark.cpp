@@ -0,0 +1,106 @@
+#include <filesystem>
+#include <format>
+#include <ios>
+#include <ostream>
+#include <streambuf>
+
+#include <benchmark/benchmark.h>
+
+import log;
+import trace_log;
+
+namespace {
+
+using Severity = vktf::Log::Severity;
+
+// a stream buffer that accepts and discards all characters to measure logging overhead without console output
+class NullStreamBuffer final : public std::streambuf {
+protected:
+  int_type overflow(const int_type value) override { return traits_type::not_eof(value); }
+  std::streamsize xsputn(const char_type*, const std::streamsize size) override { return size; }
+};
+
+std::ostream& GetNullOstream() {
+  static NullStreamBuffer null_stream_buffer;
+  static std::ostream null_ostream{&null_stream_buffer};
+  return null_ostream;
+}
+
+vktf::Log& GetNullLog(const vktf::Log::Mode mode) {
+  static vktf::Log synchronous_log{GetNullOstream(), GetNullOstream(), GetNullOstream()};
+  static vktf::Log asynchronous_log{GetNullOstream(),
+                                    GetNullOstream(),
+                                    GetNullOstream(),
+                                    vktf::Log::Mode::kAsynchronous};
+  return mode == vktf::Log::Mode::kSynchronous ? synchronous_log : asynchronous_log;
+}
+
+vktf::Log& GetTracedLog() {
+  static const auto trace_filepath = std::filesystem::temp_directory_path() / "vktf_log_benchmark.trace";
+  static vktf::TraceLog trace_log{vktf::TraceLog::CreateInfo{.trace_filepath = trace_filepath}};
+  static vktf::Log traced_log{GetNullOstream(), GetNullOstream(), GetNullOstream()};
+  traced_log.SetTraceLog(&trace_log);
+  return traced_log;
+}
+
+vktf::Log& GetDisabledInfoLog() {
+  static vktf::Log disabled_info_log{GetNullOstream(), GetNullOstream(), GetNullOstream()};
+  disabled_info_log.SetMinSeverity(Severity::kWarning);
+  return disabled_info_log;
+}
+
+void LogMessages(benchmark::State& state, const vktf::Log::Mode mode) {
+  auto& log = GetNullLog(mode);
+  const auto thread_index = state.thread_index();
+
+  for (auto _ : state) {
+    log(Severity::kInfo).Print("Thread {} logged message {} with value {:.3f}", thread_index, state.iterations(), 0.5f);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+// measures the cost of recording raw format arguments to a memory-mapped trace file instead of formatting text
+void LogTracedMessages(benchmark::State& state) {
+  auto& log = GetTracedLog();
+  const auto thread_index = state.thread_index();
+
+  for (auto _ : state) {
+    log(Severity::kInfo).Print("Thread {} logged message {} with value {:.3f}", thread_index, state.iterations(), 0.5f);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+// measures the cost of a hot-path log call filtered by the runtime minimum severity with deferred formatting
+void LogDisabledMessages(benchmark::State& state) {
+  auto& log = GetDisabledInfoLog();
+  const auto thread_index = state.thread_index();
+
+  for (auto _ : state) {
+    log(Severity::kInfo).Print("Thread {} logged message {} with value {:.3f}", thread_index, 42, 0.5f);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+// measures the same filtered log call when the message is eagerly formatted before being inserted
+void LogDisabledEagerlyFormattedMessages(benchmark::State& state) {
+  auto& log = GetDisabledInfoLog();
+  const auto thread_index = state.thread_index();
+
+  for (auto _ : state) {
+    log(Severity::kInfo) << std::format("Thread {} logged message {} with value {:.3f}", thread_index, 42, 0.5f);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+// asynchronous logs only measure the time producer threads spend logging since messages are written in the background
+BENCHMARK_CAPTURE(LogMessages, Synchronous, vktf::Log::Mode::kSynchronous)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_CAPTURE(LogMessages, Asynchronous, vktf::Log::Mode::kAsynchronous)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(LogTracedMessages)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(LogDisabledMessages)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(LogDisabledEagerlyFormattedMessages)->ThreadRange(1, 16)->UseRealTime();
+
+}  // namespace
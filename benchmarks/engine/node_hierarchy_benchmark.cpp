@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+import node_hierarchy;
+import thread_pool;
+
+namespace {
+
+// a heap-allocated node linked to its children by pointer which is how nodes were previously stored
+struct LinkedNode {
+  glm::mat4 local_transform{1.0f};
+  glm::mat4 global_transform{1.0f};
+  std::vector<LinkedNode*> children;
+};
+
+void UpdateRecursively(LinkedNode& node, const glm::mat4& parent_transform) {
+  node.global_transform = parent_transform * node.local_transform;
+  for (auto* const child_node : node.children) {
+    UpdateRecursively(*child_node, node.global_transform);
+  }
+}
+
+// parents are chosen uniformly from previously created nodes in the same tree which produces random trees with
+// logarithmic depth where each tree represents an independent root subtree (e.g., a building in a city scene)
+std::vector<std::uint32_t> CreateParentIndices(const std::size_t node_count,
+                                               const std::uint32_t tree_node_count = 1'000'000) {
+  std::mt19937 random_engine{42};  // use a fixed seed to compare results across runs
+  std::vector<std::uint32_t> parent_indices(node_count, vktf::NodeHierarchy::kNoParent);
+
+  for (auto node_index = 0u; node_index < node_count; ++node_index) {
+    const auto root_index = node_index - node_index % tree_node_count;
+    if (node_index == root_index) continue;
+    std::uniform_int_distribution<std::uint32_t> parent_index_distribution{root_index, node_index - 1};
+    parent_indices[node_index] = parent_index_distribution(random_engine);
+  }
+
+  return parent_indices;
+}
+
+glm::mat4 GetLocalTransform(const std::uint32_t node_index) {
+  return glm::translate(glm::mat4{1.0f}, glm::vec3{static_cast<float>(node_index % 7), 0.0f, 1.0f});
+}
+
+void UpdateLinkedNodes(benchmark::State& state) {
+  const auto node_count = static_cast<std::size_t>(state.range(0));
+  const auto parent_indices = CreateParentIndices(node_count);
+
+  // nodes are allocated in a shuffled order to reflect heap fragmentation in long-running applications
+  std::vector<std::uint32_t> allocation_order(node_count);
+  std::iota(allocation_order.begin(), allocation_order.end(), 0u);
+  std::ranges::shuffle(allocation_order, std::mt19937{42});
+
+  std::vector<std::unique_ptr<LinkedNode>> nodes(node_count);
+  for (const auto node_index : allocation_order) {
+    nodes[node_index] = std::make_unique<LinkedNode>(LinkedNode{.local_transform = GetLocalTransform(node_index)});
+  }
+
+  std::vector<LinkedNode*> root_nodes;
+  for (auto node_index = 0u; node_index < node_count; ++node_index) {
+    auto* const node = nodes[node_index].get();
+    if (const auto parent_index = parent_indices[node_index]; parent_index == vktf::NodeHierarchy::kNoParent) {
+      root_nodes.push_back(node);
+    } else {
+      nodes[parent_index]->children.push_back(node);
+    }
+  }
+
+  for (auto _ : state) {
+    for (auto* const root_node : root_nodes) {
+      UpdateRecursively(*root_node, glm::mat4{1.0f});
+    }
+    benchmark::DoNotOptimize(nodes.back()->global_transform);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+vktf::NodeHierarchy CreateNodeHierarchy(const std::size_t node_count, const std::uint32_t tree_node_count = 1'000'000) {
+  const auto parent_indices = CreateParentIndices(node_count, tree_node_count);
+
+  vktf::NodeHierarchy node_hierarchy;
+  node_hierarchy.Reserve(node_count);
+  for (auto node_index = 0u; node_index < node_count; ++node_index) {
+    node_hierarchy.Add(GetLocalTransform(node_index), parent_indices[node_index]);
+  }
+  node_hierarchy.Update();
+
+  return node_hierarchy;
+}
+
+void UpdateNodeHierarchy(benchmark::State& state) {
+  auto node_hierarchy = CreateNodeHierarchy(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    node_hierarchy.SetRootTransform(glm::mat4{1.0f});  // mark all nodes dirty to measure a full update
+    node_hierarchy.Update();
+    benchmark::DoNotOptimize(node_hierarchy.global_transforms().back());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void UpdateNodeHierarchyAsync(benchmark::State& state) {
+  static constexpr auto kTreeNodeCount = 1'000u;
+  auto node_hierarchy = CreateNodeHierarchy(static_cast<std::size_t>(state.range(0)), kTreeNodeCount);
+  vktf::ThreadPool thread_pool;
+
+  for (auto _ : state) {
+    node_hierarchy.SetRootTransform(glm::mat4{1.0f});  // mark all nodes dirty to measure a full update
+    for (auto& update_future : node_hierarchy.UpdateAsync(thread_pool)) {
+      update_future.get();
+    }
+    benchmark::DoNotOptimize(node_hierarchy.global_transforms().back());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// measures the common case where a single leaf node moves at the end of an otherwise static hierarchy
+void UpdateSingleNodeHierarchy(benchmark::State& state) {
+  auto node_hierarchy = CreateNodeHierarchy(static_cast<std::size_t>(state.range(0)));
+  const auto node_index = static_cast<std::uint32_t>(node_hierarchy.size() - 1);
+
+  for (auto _ : state) {
+    node_hierarchy.SetLocalTransform(node_index, GetLocalTransform(node_index));
+    node_hierarchy.Update();
+    benchmark::DoNotOptimize(node_hierarchy.global_transforms().back());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void UpdateStaticNodeHierarchy(benchmark::State& state) {
+  auto node_hierarchy = CreateNodeHierarchy(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(node_hierarchy.Update());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(UpdateLinkedNodes)
+    ->ArgName("nodes")
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(UpdateNodeHierarchy)
+    ->ArgName("nodes")
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(UpdateNodeHierarchyAsync)
+    ->ArgName("nodes")
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+BENCHMARK(UpdateSingleNodeHierarchy)
+    ->ArgName("nodes")
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(UpdateStaticNodeHierarchy)
+    ->ArgName("nodes")
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+import bounding_box;
+import bounding_volume_hierarchy;
+import view_frustum;
+
+namespace {
+
+constexpr auto kVisibilityMaskBits = 64uz;
+
+vktf::ViewFrustum CreateViewFrustum() {
+  const auto projection_transform = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1'000.0f);
+  const auto view_transform = glm::lookAt(glm::vec3{0.0f}, glm::vec3{0.0f, 0.0f, -1.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+  return vktf::ViewFrustum{projection_transform * view_transform};
+}
+
+// bounding boxes are uniformly distributed around the camera so roughly a tenth of them intersect the view frustum
+std::vector<vktf::BoundingBox> CreateBoundingBoxes(const std::size_t bounding_box_count) {
+  std::mt19937 random_engine{42};  // use a fixed seed to compare results across runs
+  std::uniform_real_distribution position_distribution{-1'000.0f, 1'000.0f};
+  std::uniform_real_distribution extent_distribution{0.0f, 10.0f};
+
+  std::vector<vktf::BoundingBox> bounding_boxes;
+  bounding_boxes.reserve(bounding_box_count);
+
+  for (auto index = 0uz; index < bounding_box_count; ++index) {
+    const glm::vec3 min{position_distribution(random_engine),
+                        position_distribution(random_engine),
+                        position_distribution(random_engine)};
+    const glm::vec3 extent{extent_distribution(random_engine),
+                           extent_distribution(random_engine),
+                           extent_distribution(random_engine)};
+    bounding_boxes.emplace_back(min, min + extent);
+  }
+
+  return bounding_boxes;
+}
+
+std::vector<std::uint64_t> CreateVisibilityMask(const std::size_t bounding_box_count) {
+  return std::vector<std::uint64_t>((bounding_box_count + kVisibilityMaskBits - 1) / kVisibilityMaskBits);
+}
+
+void IntersectsIndividually(benchmark::State& state) {
+  const auto bounding_box_count = static_cast<std::size_t>(state.range(0));
+  const auto bounding_boxes = CreateBoundingBoxes(bounding_box_count);
+  const auto view_frustum = CreateViewFrustum();
+  auto visibility_mask = CreateVisibilityMask(bounding_box_count);
+
+  for (auto _ : state) {
+    std::ranges::fill(visibility_mask, 0);
+    for (auto index = 0uz; index < bounding_box_count; ++index) {
+      if (view_frustum.Intersects(bounding_boxes[index])) {
+        visibility_mask[index / kVisibilityMaskBits] |= std::uint64_t{1} << index % kVisibilityMaskBits;
+      }
+    }
+    benchmark::DoNotOptimize(visibility_mask.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void IntersectsBatched(benchmark::State& state) {
+  const auto bounding_box_count = static_cast<std::size_t>(state.range(0));
+  const auto view_frustum = CreateViewFrustum();
+  auto visibility_mask = CreateVisibilityMask(bounding_box_count);
+
+  vktf::BoundingBoxes bounding_boxes;
+  bounding_boxes.Reserve(bounding_box_count);
+  for (const auto& bounding_box : CreateBoundingBoxes(bounding_box_count)) {
+    bounding_boxes.Add(bounding_box);
+  }
+
+  for (auto _ : state) {
+    view_frustum.Intersects(bounding_boxes, visibility_mask);
+    benchmark::DoNotOptimize(visibility_mask.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// refitting is measured with culling because hierarchy bounds must be updated whenever bounding boxes move
+void IntersectsHierarchically(benchmark::State& state) {
+  const auto bounding_box_count = static_cast<std::size_t>(state.range(0));
+  const auto view_frustum = CreateViewFrustum();
+  auto visibility_mask = CreateVisibilityMask(bounding_box_count);
+
+  vktf::BoundingBoxes bounding_boxes;
+  bounding_boxes.Reserve(bounding_box_count);
+  for (const auto& bounding_box : CreateBoundingBoxes(bounding_box_count)) {
+    bounding_boxes.Add(bounding_box);
+  }
+  vktf::BoundingVolumeHierarchy bounding_volume_hierarchy{bounding_boxes};
+
+  for (auto _ : state) {
+    if (state.range(1) != 0) bounding_volume_hierarchy.Refit(bounding_boxes);
+    bounding_volume_hierarchy.Cull(view_frustum, visibility_mask);
+    benchmark::DoNotOptimize(visibility_mask.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(IntersectsIndividually)
+    ->ArgName("bounding_boxes")
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(IntersectsBatched)
+    ->ArgName("bounding_boxes")
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(IntersectsHierarchically)
+    ->ArgNames({"bounding_boxes", "refit"})
+    ->ArgsProduct({benchmark::CreateRange(10'000, 1'000'000, 10), {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
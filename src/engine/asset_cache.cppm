@@ -0,0 +1,803 @@
+module;
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <ios>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+
+export module asset_cache;
+
+import bounding_box;
+import gltf_asset;
+import hash;
+import ktx_texture;
+import log;
+import mapped_file;
+import profiler;
+import thread_pool;
+
+namespace vktf {
+
+/**
+ * @brief A persistent cache of engine-ready glTF assets.
+ * @details The first time a glTF asset is loaded, it is parsed, its textures are transcoded for the physical device,
+ *          and the result is written to a versioned binary cache file. Subsequent loads memory-map the cache file and
+ *          reference vertex attributes and transcoded texture payloads in place which avoids JSON parsing, accessor
+ *          unpacking, and texture transcoding on warm starts. Cache files are rebuilt when the glTF file content, an
+ *          external buffer or image file, the cache format version, or the physical device transcode target changes.
+ *          The glTF file is only hashed when its size is unchanged but its modification time differs from the time
+ *          recorded in the cache file. Corrupt or truncated cache files are treated as a cache miss. Rebuilding a cache
+ *          file reuses transcoded textures from a @ref ktx::TranscodeCache whenever possible.
+ */
+export class [[nodiscard]] AssetCache {
+public:
+  /** @brief The parameters for creating an @ref AssetCache. */
+  struct [[nodiscard]] CreateInfo {
+    /** @brief The directory to write cache files to which is created if it does not exist. */
+    std::filesystem::path cache_directory;
+
+    /** @brief The physical device features for determining the best available texture transcode target. */
+    vk::PhysicalDeviceFeatures physical_device_features;
+
+    /** @brief The thread pool for decoding meshes and transcoding textures concurrently when writing cache files. */
+    ThreadPool& thread_pool;
+  };
+
+  /**
+   * @brief Creates an @ref AssetCache.
+   * @param create_info @copybrief AssetCache::CreateInfo
+   */
+  explicit AssetCache(const CreateInfo& create_info);
+
+  /**
+   * @brief Loads a glTF asset from the cache.
+   * @details If a valid cache file does not exist for @p gltf_filepath, the glTF asset is loaded from its source file
+   *          and written to the cache before being returned. Failing to write a cache file is not an error and only
+   *          results in the glTF asset being loaded from its source file again on the next load.
+   * @param gltf_filepath The filepath of the glTF asset to load.
+   * @param log The log for writing messages when loading a glTF asset.
+   * @return An in-memory representation of a glTF asset whose textures are transcoded to the best available image
+   *         format for the physical device.
+   * @throws std::runtime_error Thrown if the glTF asset at @p gltf_filepath is invalid or unsupported.
+   */
+  [[nodiscard]] gltf::Asset Load(const std::filesystem::path& gltf_filepath, Log& log);
+
+private:
+  std::filesystem::path cache_directory_;
+  vk::PhysicalDeviceFeatures physical_device_features_;
+  std::uint32_t transcode_target_id_ = 0;
+  ThreadPool& thread_pool_;
+  ktx::TranscodeCache transcode_cache_;
+};
+
+}  // namespace vktf
+
+module :private;
+
+namespace vktf {
+
+namespace {
+
+// =====================================================================================================================
+// Cache Format
+// =====================================================================================================================
+
+using Severity = Log::Severity;
+
+constexpr std::uint64_t kMagic = 0x5453534146544B56;  // "VKTFASST" in little-endian byte order
+constexpr std::uint32_t kVersion = 2;                 // increment when the cache file format changes
+constexpr std::uint32_t kNullIndex = std::numeric_limits<std::uint32_t>::max();
+constexpr std::size_t kArrayAlignment = 16;  // satisfies the alignment of aligned glm vector types
+
+// cached arrays are referenced in place which requires the layout of glm types to match the layout they were written in
+constexpr auto kLayoutId = static_cast<std::uint32_t>(sizeof(glm::vec2) | sizeof(glm::vec3) << 8u
+                                                      | sizeof(glm::vec4) << 16u | sizeof(glm::mat4) << 24u);
+
+static_assert(alignof(glm::vec2) <= kArrayAlignment && alignof(glm::vec3) <= kArrayAlignment
+              && alignof(glm::vec4) <= kArrayAlignment);
+
+enum class IndexType : std::uint8_t { kNone, kUint8, kUint16, kUint32 };
+
+constexpr std::size_t AlignUp(const std::size_t offset) noexcept {
+  return (offset + kArrayAlignment - 1) & ~(kArrayAlignment - 1);
+}
+
+struct CacheKey {
+  std::filesystem::path source_filepath;
+  std::uint32_t transcode_target_id = 0;
+};
+
+class Writer {
+public:
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void WriteValue(const T& value) {
+    WriteBytes(std::as_bytes(std::span{&value, 1}));
+  }
+
+  void WriteString(const std::string_view value) {
+    WriteValue(static_cast<std::uint64_t>(value.size()));
+    WriteBytes(std::as_bytes(std::span{value}));
+  }
+
+  void WriteOptionalString(const std::optional<std::string>& value) {
+    WriteValue(static_cast<std::uint8_t>(value.has_value()));
+    if (value.has_value()) WriteString(*value);
+  }
+
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void WriteArray(const std::span<const T> values) {
+    WriteValue(static_cast<std::uint64_t>(values.size()));
+    bytes_.resize(AlignUp(bytes_.size()));  // align arrays so they can be referenced in place when read
+    WriteBytes(std::as_bytes(values));
+  }
+
+  [[nodiscard]] std::vector<std::byte>& bytes() noexcept { return bytes_; }
+
+private:
+  void WriteBytes(const std::span<const std::byte> bytes) { bytes_.insert(bytes_.end(), bytes.begin(), bytes.end()); }
+
+  std::vector<std::byte> bytes_;
+};
+
+class Reader {
+public:
+  explicit Reader(const std::span<const std::byte> bytes) noexcept : bytes_{bytes} {}
+
+  template <typename T>
+    requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+  [[nodiscard]] T ReadValue() {
+    T value{};
+    std::memcpy(&value, ReadBytes(sizeof(T)).data(), sizeof(T));
+    return value;
+  }
+
+  // enumerations are range checked because casting an out-of-range value produces an unspecified enumerator
+  template <typename T>
+    requires std::is_enum_v<T>
+  [[nodiscard]] T ReadEnum(const T min_value, const T max_value) {
+    const auto value = ReadValue<std::underlying_type_t<T>>();
+    if (std::cmp_less(value, std::to_underlying(min_value)) || std::cmp_greater(value, std::to_underlying(max_value))) {
+      throw std::runtime_error{std::format("Invalid asset cache enumerator {}", static_cast<std::int64_t>(value))};
+    }
+    return static_cast<T>(value);
+  }
+
+  [[nodiscard]] std::string ReadString() {
+    const auto size = ReadValue<std::uint64_t>();
+    const auto bytes = ReadBytes(size);
+    return std::string{reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+  }
+
+  [[nodiscard]] std::optional<std::string> ReadOptionalString() {
+    if (ReadValue<std::uint8_t>() == 0) return std::nullopt;
+    return ReadString();
+  }
+
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  [[nodiscard]] std::span<const T> ReadArray() {
+    const auto count = ReadValue<std::uint64_t>();
+    offset_ = std::min(AlignUp(offset_), bytes_.size());
+    if (count > (bytes_.size() - offset_) / sizeof(T)) {
+      throw std::runtime_error{std::format("Invalid asset cache array with bad size {}", count)};
+    }
+    const auto bytes = ReadBytes(count * sizeof(T));
+    assert(count == 0 || reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(T) == 0);  // requires aligned data
+    return std::span{reinterpret_cast<const T*>(bytes.data()), count};
+  }
+
+private:
+  std::span<const std::byte> ReadBytes(const std::size_t size) {
+    if (size > bytes_.size() - offset_) throw std::runtime_error{"Unexpected end of asset cache data"};
+    const auto bytes = bytes_.subspan(offset_, size);
+    offset_ += size;
+    return bytes;
+  }
+
+  std::span<const std::byte> bytes_;
+  std::size_t offset_ = 0;
+};
+
+template <typename T>
+using IndexMap = std::unordered_map<const T*, std::uint32_t>;
+
+template <typename T>
+IndexMap<T> CreateIndexMap(const std::vector<std::unique_ptr<const T>>& values) {
+  return values  //
+         | std::views::enumerate
+         | std::views::transform([](const auto& indexed_value) {
+             const auto& [index, value] = indexed_value;
+             return std::pair{value.get(), static_cast<std::uint32_t>(index)};
+           })
+         | std::ranges::to<std::unordered_map>();
+}
+
+template <typename T>
+std::uint32_t GetIndex(const T* const value, const IndexMap<T>& index_map) {
+  if (value == nullptr) return kNullIndex;
+  const auto iterator = index_map.find(value);
+  assert(iterator != index_map.cend());  // index maps are constructed in advance with all known asset values
+  return iterator->second;
+}
+
+template <typename T>
+const T* GetValue(const std::uint32_t index, const std::vector<std::unique_ptr<T>>& values) {
+  if (index == kNullIndex) return nullptr;
+  if (index >= values.size()) throw std::runtime_error{std::format("Invalid asset cache index {}", index)};
+  return values[index].get();
+}
+
+template <typename T>
+void WriteOptionalArray(Writer& writer, const std::optional<gltf::AttributeData<T>>& attribute_data) {
+  writer.WriteValue(static_cast<std::uint8_t>(attribute_data.has_value()));
+  if (attribute_data.has_value()) writer.WriteArray(attribute_data->values());
+}
+
+template <typename T>
+std::optional<gltf::AttributeData<T>> ReadOptionalArray(Reader& reader) {
+  if (reader.ReadValue<std::uint8_t>() == 0) return std::nullopt;
+  return gltf::AttributeData<T>{reader.ReadArray<T>()};
+}
+
+template <typename T>
+std::vector<T> ReadIndices(Reader& reader) {
+  const auto indices = reader.ReadArray<T>();
+  return std::vector(indices.begin(), indices.end());
+}
+
+// =====================================================================================================================
+// Dependencies
+// =====================================================================================================================
+
+struct Dependency {
+  std::filesystem::path filepath;
+  std::uint64_t size_bytes = 0;
+  std::int64_t last_write_time = 0;
+};
+
+std::optional<Dependency> GetDependency(const std::filesystem::path& filepath) {
+  std::error_code error_code;
+  const auto size_bytes = std::filesystem::file_size(filepath, error_code);
+  if (error_code) return std::nullopt;
+
+  const auto last_write_time = std::filesystem::last_write_time(filepath, error_code);
+  if (error_code) return std::nullopt;
+
+  return Dependency{.filepath = filepath,
+                    .size_bytes = static_cast<std::uint64_t>(size_bytes),
+                    .last_write_time = static_cast<std::int64_t>(last_write_time.time_since_epoch().count())};
+}
+
+// external files are validated by size and modification time to avoid reading large buffers and images on warm starts
+void WriteDependencies(Writer& writer, const std::vector<std::filesystem::path>& dependency_filepaths) {
+  const auto dependencies = dependency_filepaths  //
+                            | std::views::transform(GetDependency)
+                            | std::views::filter([](const auto& dependency) { return dependency.has_value(); })
+                            | std::views::transform([](const auto& dependency) { return *dependency; })
+                            | std::ranges::to<std::vector>();
+
+  writer.WriteValue(static_cast<std::uint64_t>(dependencies.size()));
+  for (const auto& [filepath, size_bytes, last_write_time] : dependencies) {
+    writer.WriteString(filepath.generic_string());
+    writer.WriteValue(size_bytes);
+    writer.WriteValue(last_write_time);
+  }
+}
+
+bool ReadDependencies(Reader& reader) {
+  auto is_valid = true;
+  for (auto count = reader.ReadValue<std::uint64_t>(); count > 0; --count) {
+    const std::filesystem::path filepath = reader.ReadString();
+    const auto size_bytes = reader.ReadValue<std::uint64_t>();
+    const auto last_write_time = reader.ReadValue<std::int64_t>();
+
+    if (const auto dependency = GetDependency(filepath);
+        !dependency.has_value() || dependency->size_bytes != size_bytes
+        || dependency->last_write_time != last_write_time) {
+      is_valid = false;
+    }
+  }
+  return is_valid;
+}
+
+void WriteSource(Writer& writer, const std::filesystem::path& source_filepath) {
+  const auto source = GetDependency(source_filepath);
+  if (!source.has_value()) throw std::runtime_error{std::format("Failed to stat {}", source_filepath.string())};
+  writer.WriteValue(source->size_bytes);
+  writer.WriteValue(source->last_write_time);
+  writer.WriteValue(HashFile(source_filepath));
+}
+
+// the source file is only hashed when its size is unchanged but its modification time differs (e.g., after a checkout)
+bool ReadSource(Reader& reader, const std::filesystem::path& source_filepath) {
+  const auto size_bytes = reader.ReadValue<std::uint64_t>();
+  const auto last_write_time = reader.ReadValue<std::int64_t>();
+  const auto source_hash = reader.ReadValue<std::uint64_t>();
+
+  const auto source = GetDependency(source_filepath);
+  if (!source.has_value() || source->size_bytes != size_bytes) return false;
+  return source->last_write_time == last_write_time || HashFile(source_filepath) == source_hash;
+}
+
+// =====================================================================================================================
+// Textures
+// =====================================================================================================================
+
+using KtxPayload = std::optional<std::vector<std::byte>>;
+
+constexpr std::string_view kKtx2MimeType = "image/ktx2";
+
+KtxPayload CreateKtxPayload(const gltf::Texture& gltf_texture,
+                            const vk::PhysicalDeviceFeatures& physical_device_features,
+                            ktx::TranscodeCache& transcode_cache,
+                            Log& log) {
+  if (!gltf_texture.image_data.empty()) {
+    // unsupported images are cached as-is and reported when creating the model that references them
+    if (gltf_texture.mime_type != kKtx2MimeType) return std::nullopt;
+    const auto ktx_texture2 = transcode_cache.Load(gltf_texture.image_data, physical_device_features, log);
+    return ktx::WriteToMemory(*ktx_texture2);
+  }
+
+  if (static constexpr std::string_view kKtx2Extension = ".ktx2";
+      !gltf_texture.filepath.has_value() || gltf_texture.filepath->extension() != kKtx2Extension) {
+    return std::nullopt;
+  }
+  const auto ktx_texture2 = transcode_cache.Load(*gltf_texture.filepath, physical_device_features, log);
+  return ktx::WriteToMemory(*ktx_texture2);
+}
+
+std::vector<KtxPayload> CreateKtxPayloads(const std::vector<gltf::UniqueTexture>& gltf_textures,
+                                          const vk::PhysicalDeviceFeatures& physical_device_features,
+                                          ktx::TranscodeCache& transcode_cache,
+                                          ThreadPool& thread_pool,
+                                          Log& log) {
+  auto ktx_payload_futures =
+      gltf_textures  //
+      | std::views::transform(
+          [&physical_device_features, &transcode_cache, &thread_pool, &log](const auto& gltf_texture) {
+            assert(gltf_texture != nullptr);  // guaranteed by glTF asset construction
+            const auto* const gltf_texture_ptr = gltf_texture.get();
+            return thread_pool.Submit([gltf_texture_ptr, &physical_device_features, &transcode_cache, &log] {
+              return CreateKtxPayload(*gltf_texture_ptr, physical_device_features, transcode_cache, log);
+            });
+          })
+      | std::ranges::to<std::vector>();
+
+  return ktx_payload_futures  //
+         | std::views::transform([](auto& ktx_payload_future) { return ktx_payload_future.get(); })
+         | std::ranges::to<std::vector>();
+}
+
+// =====================================================================================================================
+// Asset Serialization
+// =====================================================================================================================
+
+// transcoded payloads are written in place of texture image data which is only read when a payload is unavailable
+std::vector<std::byte> WriteAsset(const gltf::Asset& gltf_asset,
+                                  const std::span<const KtxPayload> ktx_payloads,
+                                  const CacheKey& cache_key) {
+  assert(ktx_payloads.size() == gltf_asset.textures.size());
+
+  Writer writer;
+
+  writer.WriteValue(kMagic);
+  writer.WriteValue(kVersion);
+  writer.WriteValue(kLayoutId);
+  writer.WriteValue(cache_key.transcode_target_id);
+  WriteSource(writer, cache_key.source_filepath);
+  WriteDependencies(writer, gltf_asset.dependencies);
+  writer.WriteString(gltf_asset.name);
+
+  // textures without a sampler reference a default sampler which is not owned by the asset and must be cached with it
+  auto samplers = gltf_asset.samplers
+                  | std::views::transform([](const auto& sampler) -> const gltf::Sampler* { return sampler.get(); })
+                  | std::ranges::to<std::vector>();
+  auto sampler_indices = CreateIndexMap(gltf_asset.samplers);
+  for (const auto& gltf_texture : gltf_asset.textures) {
+    if (const auto* const sampler = gltf_texture->sampler; sampler != nullptr && !sampler_indices.contains(sampler)) {
+      sampler_indices.emplace(sampler, static_cast<std::uint32_t>(samplers.size()));
+      samplers.push_back(sampler);
+    }
+  }
+
+  writer.WriteValue(static_cast<std::uint64_t>(samplers.size()));
+  for (const auto* const sampler : samplers) {
+    writer.WriteOptionalString(sampler->name);
+    writer.WriteValue(sampler->mag_filter);
+    writer.WriteValue(sampler->min_filter);
+    writer.WriteValue(sampler->mipmap_mode);
+    writer.WriteValue(sampler->address_mode_u);
+    writer.WriteValue(sampler->address_mode_v);
+  }
+
+  writer.WriteValue(static_cast<std::uint64_t>(gltf_asset.textures.size()));
+  for (const auto& [gltf_texture, ktx_payload] : std::views::zip(gltf_asset.textures, ktx_payloads)) {
+    writer.WriteOptionalString(gltf_texture->name);
+    writer.WriteOptionalString(
+        gltf_texture->filepath.transform([](const auto& filepath) { return filepath.generic_string(); }));
+    if (ktx_payload.has_value()) {
+      writer.WriteOptionalString(std::string{kKtx2MimeType});
+      writer.WriteArray(std::span<const std::byte>{*ktx_payload});
+    } else {
+      writer.WriteOptionalString(gltf_texture->mime_type);
+      writer.WriteArray(gltf_texture->image_data);
+    }
+    writer.WriteValue(GetIndex(gltf_texture->sampler, sampler_indices));
+  }
+
+  const auto texture_indices = CreateIndexMap(gltf_asset.textures);
+  writer.WriteValue(static_cast<std::uint64_t>(gltf_asset.materials.size()));
+  for (const auto& gltf_material : gltf_asset.materials) {
+    writer.WriteOptionalString(gltf_material->name);
+    const auto& pbr_metallic_roughness = gltf_material->pbr_metallic_roughness;
+    writer.WriteValue(static_cast<std::uint8_t>(pbr_metallic_roughness.has_value()));
+    if (pbr_metallic_roughness.has_value()) {
+      writer.WriteValue(pbr_metallic_roughness->base_color_factor);
+      writer.WriteValue(GetIndex(pbr_metallic_roughness->base_color_texture, texture_indices));
+      writer.WriteValue(pbr_metallic_roughness->metallic_factor);
+      writer.WriteValue(pbr_metallic_roughness->roughness_factor);
+      writer.WriteValue(GetIndex(pbr_metallic_roughness->metallic_roughness_texture, texture_indices));
+    }
+    writer.WriteValue(gltf_material->normal_scale);
+    writer.WriteValue(GetIndex(gltf_material->normal_texture, texture_indices));
+  }
+
+  const auto material_indices = CreateIndexMap(gltf_asset.materials);
+  writer.WriteValue(static_cast<std::uint64_t>(gltf_asset.meshes.size()));
+  for (const auto& gltf_mesh : gltf_asset.meshes) {
+    writer.WriteOptionalString(gltf_mesh->name);
+    writer.WriteValue(static_cast<std::uint64_t>(gltf_mesh->primitives.size()));
+
+    for (const auto& [attributes, indices, material] : gltf_mesh->primitives) {
+      writer.WriteArray(attributes.position.data.values());
+      writer.WriteValue(attributes.position.bounding_box.min);
+      writer.WriteValue(attributes.position.bounding_box.max);
+      WriteOptionalArray(writer, attributes.normal.data);
+      WriteOptionalArray(writer, attributes.tangent.data);
+      WriteOptionalArray(writer, attributes.texcoord_0.data);
+
+      if (!indices.has_value()) {
+        writer.WriteValue(IndexType::kNone);
+      } else {
+        std::visit(
+            [&writer]<typename T>(const std::vector<T>& index_values) {
+              if constexpr (std::same_as<T, std::uint8_t>) writer.WriteValue(IndexType::kUint8);
+              if constexpr (std::same_as<T, std::uint16_t>) writer.WriteValue(IndexType::kUint16);
+              if constexpr (std::same_as<T, std::uint32_t>) writer.WriteValue(IndexType::kUint32);
+              writer.WriteArray(std::span<const T>{index_values});
+            },
+            *indices);
+      }
+
+      writer.WriteValue(GetIndex(material, material_indices));
+    }
+  }
+
+  writer.WriteValue(static_cast<std::uint64_t>(gltf_asset.lights.size()));
+  for (const auto& gltf_light : gltf_asset.lights) {
+    writer.WriteOptionalString(gltf_light->name);
+    writer.WriteValue(gltf_light->color);
+    writer.WriteValue(gltf_light->type);
+  }
+
+  const auto mesh_indices = CreateIndexMap(gltf_asset.meshes);
+  const auto light_indices = CreateIndexMap(gltf_asset.lights);
+  const auto node_indices = CreateIndexMap(gltf_asset.nodes);
+  writer.WriteValue(static_cast<std::uint64_t>(gltf_asset.nodes.size()));
+  for (const auto& gltf_node : gltf_asset.nodes) {
+    writer.WriteOptionalString(gltf_node->name);
+    writer.WriteValue(gltf_node->local_transform);
+    writer.WriteValue(GetIndex(gltf_node->mesh, mesh_indices));
+    writer.WriteValue(GetIndex(gltf_node->light, light_indices));
+    writer.WriteArray(std::span<const std::uint32_t>{
+        gltf_node->children
+        | std::views::transform([&node_indices](const auto* const child) { return GetIndex(child, node_indices); })
+        | std::ranges::to<std::vector>()});
+  }
+
+  writer.WriteValue(static_cast<std::uint64_t>(gltf_asset.scenes.size()));
+  for (const auto& gltf_scene : gltf_asset.scenes) {
+    writer.WriteOptionalString(gltf_scene->name);
+    writer.WriteArray(std::span<const std::uint32_t>{
+        gltf_scene->root_nodes
+        | std::views::transform(
+            [&node_indices](const auto* const root_node) { return GetIndex(root_node, node_indices); })
+        | std::ranges::to<std::vector>()});
+  }
+
+  const auto scene_indices = CreateIndexMap(gltf_asset.scenes);
+  writer.WriteValue(GetIndex(gltf_asset.default_scene, scene_indices));
+
+  return std::move(writer.bytes());
+}
+
+bool ReadHeader(Reader& reader, const CacheKey& cache_key) {
+  return reader.ReadValue<std::uint64_t>() == kMagic      //
+         && reader.ReadValue<std::uint32_t>() == kVersion  // the remaining format is unknown if versions mismatch
+         && reader.ReadValue<std::uint32_t>() == kLayoutId
+         && reader.ReadValue<std::uint32_t>() == cache_key.transcode_target_id
+         && ReadSource(reader, cache_key.source_filepath);
+}
+
+template <typename T>
+std::vector<std::unique_ptr<const T>> ReadValues(Reader& reader, const std::invocable<Reader&> auto& read_value) {
+  const auto count = reader.ReadValue<std::uint64_t>();
+  std::vector<std::unique_ptr<const T>> values;
+  for (auto index = 0uz; index < count; ++index) {
+    values.push_back(read_value(reader));
+  }
+  return values;
+}
+
+std::vector<const gltf::Node*> ReadNodes(Reader& reader, const std::vector<gltf::UniqueNode>& nodes) {
+  return reader.ReadArray<std::uint32_t>()
+         | std::views::transform([&nodes](const auto node_index) { return GetValue(node_index, nodes); })
+         | std::ranges::to<std::vector>();
+}
+
+// returns std::nullopt if the cache file is stale and throws std::runtime_error if the cache data is malformed
+std::optional<gltf::Asset> ReadAsset(const std::span<const std::byte> bytes, const CacheKey& cache_key) {
+  Reader reader{bytes};
+  if (!ReadHeader(reader, cache_key) || !ReadDependencies(reader)) return std::nullopt;
+
+  gltf::Asset gltf_asset{.name = reader.ReadString()};
+
+  gltf_asset.samplers = ReadValues<gltf::Sampler>(reader, [](Reader& sampler_reader) {
+    auto name = sampler_reader.ReadOptionalString();
+    using enum vk::SamplerAddressMode;
+    const auto mag_filter = sampler_reader.ReadEnum(vk::Filter::eNearest, vk::Filter::eLinear);
+    const auto min_filter = sampler_reader.ReadEnum(vk::Filter::eNearest, vk::Filter::eLinear);
+    const auto mipmap_mode = sampler_reader.ReadEnum(vk::SamplerMipmapMode::eNearest, vk::SamplerMipmapMode::eLinear);
+    const auto address_mode_u = sampler_reader.ReadEnum(eRepeat, eMirrorClampToEdge);
+    const auto address_mode_v = sampler_reader.ReadEnum(eRepeat, eMirrorClampToEdge);
+    return std::make_unique<const gltf::Sampler>(std::move(name),
+                                                 mag_filter,
+                                                 min_filter,
+                                                 mipmap_mode,
+                                                 address_mode_u,
+                                                 address_mode_v);
+  });
+
+  gltf_asset.textures = ReadValues<gltf::Texture>(reader, [&samplers = gltf_asset.samplers](Reader& texture_reader) {
+    auto name = texture_reader.ReadOptionalString();
+    auto filepath = texture_reader.ReadOptionalString();
+    auto mime_type = texture_reader.ReadOptionalString();
+    const auto image_data = texture_reader.ReadArray<std::byte>();
+    const auto* const sampler = GetValue(texture_reader.ReadValue<std::uint32_t>(), samplers);
+    return std::make_unique<const gltf::Texture>(std::move(name),
+                                                 std::move(filepath),
+                                                 image_data,
+                                                 std::move(mime_type),
+                                                 sampler);
+  });
+
+  gltf_asset.materials = ReadValues<gltf::Material>(reader, [&textures = gltf_asset.textures](Reader& material_reader) {
+    auto name = material_reader.ReadOptionalString();
+    std::optional<gltf::PbrMetallicRoughness> pbr_metallic_roughness;
+    if (material_reader.ReadValue<std::uint8_t>() != 0) {
+      auto& [base_color_factor, base_color_texture, metallic_factor, roughness_factor, metallic_roughness_texture] =
+          pbr_metallic_roughness.emplace();
+      base_color_factor = material_reader.ReadValue<glm::vec4>();
+      base_color_texture = GetValue(material_reader.ReadValue<std::uint32_t>(), textures);
+      metallic_factor = material_reader.ReadValue<float>();
+      roughness_factor = material_reader.ReadValue<float>();
+      metallic_roughness_texture = GetValue(material_reader.ReadValue<std::uint32_t>(), textures);
+    }
+    const auto normal_scale = material_reader.ReadValue<float>();
+    const auto* const normal_texture = GetValue(material_reader.ReadValue<std::uint32_t>(), textures);
+    return std::make_unique<const gltf::Material>(std::move(name),
+                                                  std::move(pbr_metallic_roughness),
+                                                  normal_scale,
+                                                  normal_texture);
+  });
+
+  gltf_asset.meshes = ReadValues<gltf::Mesh>(reader, [&materials = gltf_asset.materials](Reader& mesh_reader) {
+    auto name = mesh_reader.ReadOptionalString();
+    std::vector<gltf::Primitive> primitives;
+
+    for (auto count = mesh_reader.ReadValue<std::uint64_t>(); count > 0; --count) {
+      using Attributes = gltf::Attributes;
+      auto position_data = Attributes::Position::Data{mesh_reader.ReadArray<glm::vec3>()};
+      BoundingBox bounding_box{.min = mesh_reader.ReadValue<glm::vec3>(),
+                               .max = mesh_reader.ReadValue<glm::vec3>()};
+      auto normal_data = ReadOptionalArray<glm::vec3>(mesh_reader);
+      auto tangent_data = ReadOptionalArray<glm::vec4>(mesh_reader);
+      auto texcoord_0_data = ReadOptionalArray<glm::vec2>(mesh_reader);
+
+      std::optional<gltf::Primitive::Indices> indices;
+      switch (const auto index_type = mesh_reader.ReadValue<IndexType>()) {
+        case IndexType::kNone:
+          break;
+        case IndexType::kUint8:
+          indices = ReadIndices<std::uint8_t>(mesh_reader);
+          break;
+        case IndexType::kUint16:
+          indices = ReadIndices<std::uint16_t>(mesh_reader);
+          break;
+        case IndexType::kUint32:
+          indices = ReadIndices<std::uint32_t>(mesh_reader);
+          break;
+        default:
+          throw std::runtime_error{
+              std::format("Invalid asset cache index type {}", static_cast<std::uint32_t>(index_type))};
+      }
+
+      primitives.emplace_back(
+          Attributes{.position = Attributes::Position{.data = std::move(position_data), .bounding_box = bounding_box},
+                     .normal = Attributes::Normal{.data = std::move(normal_data)},
+                     .tangent = Attributes::Tangent{.data = std::move(tangent_data)},
+                     .texcoord_0 = Attributes::TexCoord0{.data = std::move(texcoord_0_data)}},
+          std::move(indices),
+          GetValue(mesh_reader.ReadValue<std::uint32_t>(), materials));
+    }
+
+    return std::make_unique<const gltf::Mesh>(std::move(name), std::move(primitives));
+  });
+
+  gltf_asset.lights = ReadValues<gltf::Light>(reader, [](Reader& light_reader) {
+    auto name = light_reader.ReadOptionalString();
+    const auto color = light_reader.ReadValue<glm::vec3>();
+    const auto type = light_reader.ReadEnum(gltf::Light::Type::kDirectional, gltf::Light::Type::kPoint);
+    return std::make_unique<const gltf::Light>(std::move(name), color, type);
+  });
+
+  // create nodes without establishing parent-child relationships in the node hierarchy
+  std::vector<std::unique_ptr<gltf::Node>> mutable_nodes;
+  std::vector<std::span<const std::uint32_t>> child_indices;
+  for (auto count = reader.ReadValue<std::uint64_t>(); count > 0; --count) {
+    auto name = reader.ReadOptionalString();
+    const auto local_transform = reader.ReadValue<glm::mat4>();
+    const auto* const mesh = GetValue(reader.ReadValue<std::uint32_t>(), gltf_asset.meshes);
+    const auto* const light = GetValue(reader.ReadValue<std::uint32_t>(), gltf_asset.lights);
+    mutable_nodes.push_back(std::make_unique<gltf::Node>(std::move(name), local_transform, mesh, light));
+    child_indices.push_back(reader.ReadArray<std::uint32_t>());
+  }
+
+  // assign child pointers after all nodes have been created
+  for (const auto& [mutable_node, node_child_indices] : std::views::zip(mutable_nodes, child_indices)) {
+    mutable_node->children =
+        node_child_indices
+        | std::views::transform([&mutable_nodes](const auto index) { return GetValue(index, mutable_nodes); })
+        | std::ranges::to<std::vector>();
+  }
+
+  // convert to const pointers after all nodes have been completely initialized
+  gltf_asset.nodes = mutable_nodes  //
+                     | std::views::as_rvalue
+                     | std::views::transform([](auto&& node) { return gltf::UniqueNode{std::move(node)}; })
+                     | std::ranges::to<std::vector>();
+
+  gltf_asset.scenes = ReadValues<gltf::Scene>(reader, [&nodes = gltf_asset.nodes](Reader& scene_reader) {
+    auto name = scene_reader.ReadOptionalString();
+    return std::make_unique<const gltf::Scene>(std::move(name), ReadNodes(scene_reader, nodes));
+  });
+
+  gltf_asset.default_scene = GetValue(reader.ReadValue<std::uint32_t>(), gltf_asset.scenes);
+  return gltf_asset;
+}
+
+// =====================================================================================================================
+// Cache Files
+// =====================================================================================================================
+
+std::filesystem::path GetCacheFilepath(const std::filesystem::path& cache_directory,
+                                       const std::filesystem::path& gltf_filepath,
+                                       const std::uint32_t transcode_target_id) {
+  // cache filenames include a hash of the absolute glTF filepath to distinguish assets that share the same filename
+  const auto gltf_filepath_string = std::filesystem::absolute(gltf_filepath).lexically_normal().generic_string();
+  const auto gltf_filepath_hash = Hash(std::as_bytes(std::span{gltf_filepath_string}));
+  return cache_directory / std::format("{}-{:016x}-{:x}.vktfasset",
+                                       gltf_filepath.stem().string(),
+                                       gltf_filepath_hash,
+                                       transcode_target_id);
+}
+
+void WriteCacheFile(const std::filesystem::path& cache_filepath, const std::span<const std::byte> bytes) {
+  std::filesystem::create_directories(cache_filepath.parent_path());
+
+  // write to a uniquely named temporary file first so that an interrupted write never leaves a partially written cache
+  // file and threads loading the same asset never write to the same file
+  auto temporary_filepath = cache_filepath;
+  temporary_filepath += std::format(".{:x}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+  std::error_code error_code;
+  {
+    std::ofstream ofstream{temporary_filepath, std::ios::binary | std::ios::trunc};
+    ofstream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!ofstream) {
+      ofstream.close();
+      std::filesystem::remove(temporary_filepath, error_code);
+      throw std::runtime_error{std::format("Failed to write {}", temporary_filepath.string())};
+    }
+  }
+
+  if (std::filesystem::rename(temporary_filepath, cache_filepath, error_code); error_code) {
+    const auto message = error_code.message();
+    std::filesystem::remove(temporary_filepath, error_code);
+    throw std::runtime_error{std::format("Failed to rename {} with error {}", temporary_filepath.string(), message)};
+  }
+}
+
+}  // namespace
+
+AssetCache::AssetCache(const CreateInfo& create_info)
+    : cache_directory_{create_info.cache_directory},
+      physical_device_features_{create_info.physical_device_features},
+      transcode_target_id_{ktx::GetTranscodeTargetId(physical_device_features_)},
+      thread_pool_{create_info.thread_pool},
+      transcode_cache_{cache_directory_ / "textures"} {}
+
+gltf::Asset AssetCache::Load(const std::filesystem::path& gltf_filepath, Log& log) {
+  const ProfileZone profile_zone{"AssetCache::Load"};
+  const auto cache_filepath = GetCacheFilepath(cache_directory_, gltf_filepath, transcode_target_id_);
+  const CacheKey cache_key{.source_filepath = gltf_filepath, .transcode_target_id = transcode_target_id_};
+
+  if (std::filesystem::exists(cache_filepath)) {
+    // corrupt or truncated cache files are treated as a cache miss and rebuilt from the source glTF asset
+    try {
+      auto mapped_file = std::make_shared<const MappedFile>(cache_filepath);
+      if (auto gltf_asset = ReadAsset(mapped_file->data(), cache_key); gltf_asset.has_value()) {
+        gltf_asset->buffer_data = std::move(mapped_file);  // cached arrays reference the mapped file directly
+        return std::move(*gltf_asset);
+      }
+#ifndef NDEBUG
+      log(Severity::kInfo).Print("Rebuilding stale asset cache file {}", cache_filepath.string());
+#endif
+    } catch (const std::exception& exception) {
+      log(Severity::kWarning).Print("Rebuilding invalid asset cache file {} with error {}",
+                                    cache_filepath.string(),
+                                    exception.what());
+    }
+  }
+
+  auto gltf_asset = gltf::Load(gltf_filepath, log, gltf::LoadOptions{.thread_pool = &thread_pool_});
+  const auto hit_count = transcode_cache_.hit_count();
+  const auto miss_count = transcode_cache_.miss_count();
+  const auto ktx_payloads =
+      CreateKtxPayloads(gltf_asset.textures, physical_device_features_, transcode_cache_, thread_pool_, log);
+  log(Severity::kInfo).Print("Loaded textures for {} with {} transcode cache hits and {} misses",
+                             gltf_asset.name,
+                             transcode_cache_.hit_count() - hit_count,
+                             transcode_cache_.miss_count() - miss_count);
+
+  // the loaded asset references source texture data which is transcoded again when creating models on a cache miss
+  // whereas cache files store transcoded payloads for subsequent loads
+  try {
+    WriteCacheFile(cache_filepath, WriteAsset(gltf_asset, ktx_payloads, cache_key));
+  } catch (const std::runtime_error& error) {
+    log(Severity::kWarning).Print("Failed to write asset cache file {} with error {}",
+                                  cache_filepath.string(),
+                                  error.what());
+  }
+
+  return gltf_asset;
+}
+
+}  // namespace vktf
@@ -1,8 +1,9 @@
 module;
 
-#include <algorithm>
-#include <array>
-#include <limits>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -24,10 +25,80 @@ export struct [[nodiscard]] BoundingBox {
   glm::vec3 max{0.0f};
 };
 
+/**
+ * @brief A collection of axis-aligned bounding boxes stored as a structure of arrays.
+ * @details Each bounding box component is stored in a separate contiguous array which allows batched intersection tests
+ *          to load the same component for consecutive bounding boxes with a single SIMD instruction.
+ */
+export class [[nodiscard]] BoundingBoxes {
+public:
+  /** @brief Gets the number of bounding boxes. */
+  [[nodiscard]] std::size_t size() const noexcept { return min_x_.size(); }
+
+  /** @brief Gets the x-components of the minimum point for each bounding box. */
+  [[nodiscard]] const std::vector<float>& min_x() const noexcept { return min_x_; }
+
+  /** @brief Gets the y-components of the minimum point for each bounding box. */
+  [[nodiscard]] const std::vector<float>& min_y() const noexcept { return min_y_; }
+
+  /** @brief Gets the z-components of the minimum point for each bounding box. */
+  [[nodiscard]] const std::vector<float>& min_z() const noexcept { return min_z_; }
+
+  /** @brief Gets the x-components of the maximum point for each bounding box. */
+  [[nodiscard]] const std::vector<float>& max_x() const noexcept { return max_x_; }
+
+  /** @brief Gets the y-components of the maximum point for each bounding box. */
+  [[nodiscard]] const std::vector<float>& max_y() const noexcept { return max_y_; }
+
+  /** @brief Gets the z-components of the maximum point for each bounding box. */
+  [[nodiscard]] const std::vector<float>& max_z() const noexcept { return max_z_; }
+
+  /**
+   * @brief Gets a bounding box in the collection.
+   * @param index The index of the bounding box to get.
+   * @return The bounding box at @p index.
+   * @warning The caller is responsible for ensuring @p index is less than @ref BoundingBoxes::size.
+   */
+  [[nodiscard]] BoundingBox operator[](const std::size_t index) const noexcept {
+    return BoundingBox{.min = glm::vec3{min_x_[index], min_y_[index], min_z_[index]},
+                       .max = glm::vec3{max_x_[index], max_y_[index], max_z_[index]}};
+  }
+
+  /**
+   * @brief Reserves storage for a number of bounding boxes.
+   * @param capacity The number of bounding boxes to reserve storage for.
+   */
+  void Reserve(std::size_t capacity);
+
+  /**
+   * @brief Adds a bounding box to the end of the collection.
+   * @param bounding_box The bounding box to add.
+   */
+  void Add(const BoundingBox& bounding_box);
+
+  /**
+   * @brief Replaces a bounding box in the collection.
+   * @param index The index of the bounding box to replace.
+   * @param bounding_box The new bounding box.
+   */
+  void Set(std::size_t index, const BoundingBox& bounding_box);
+
+  /** @brief Removes all bounding boxes while retaining allocated storage. */
+  void Clear() noexcept;
+
+private:
+  std::vector<float> min_x_;
+  std::vector<float> min_y_;
+  std::vector<float> min_z_;
+  std::vector<float> max_x_;
+  std::vector<float> max_y_;
+  std::vector<float> max_z_;
+};
+
 /**
  * @brief Transforms an axis-aligned bounding box to a new coordinate space.
  * @param bounding_box The bounding box to transform.
- * @param transform The transform matrix defining the basis vectors for the new coordinate space.
+ * @param transform The affine transform matrix defining the basis vectors for the new coordinate space.
  * @return A new axis-aligned bounding box representing @p bounding_box transformed by the matrix @p transform.
  */
 export [[nodiscard]] BoundingBox Transform(const BoundingBox& bounding_box, const glm::mat4& transform);
@@ -38,26 +109,54 @@ module :private;
 
 namespace vktf {
 
+void BoundingBoxes::Reserve(const std::size_t capacity) {
+  for (auto* const components : {&min_x_, &min_y_, &min_z_, &max_x_, &max_y_, &max_z_}) {
+    components->reserve(capacity);
+  }
+}
+
+void BoundingBoxes::Add(const BoundingBox& bounding_box) {
+  const auto& [min_vertex, max_vertex] = bounding_box;
+  min_x_.push_back(min_vertex.x);
+  min_y_.push_back(min_vertex.y);
+  min_z_.push_back(min_vertex.z);
+  max_x_.push_back(max_vertex.x);
+  max_y_.push_back(max_vertex.y);
+  max_z_.push_back(max_vertex.z);
+}
+
+void BoundingBoxes::Set(const std::size_t index, const BoundingBox& bounding_box) {
+  assert(index < size());
+  const auto& [min_vertex, max_vertex] = bounding_box;
+  min_x_[index] = min_vertex.x;
+  min_y_[index] = min_vertex.y;
+  min_z_[index] = min_vertex.z;
+  max_x_[index] = max_vertex.x;
+  max_y_[index] = max_vertex.y;
+  max_z_[index] = max_vertex.z;
+}
+
+void BoundingBoxes::Clear() noexcept {
+  for (auto* const components : {&min_x_, &min_y_, &min_z_, &max_x_, &max_y_, &max_z_}) {
+    components->clear();
+  }
+}
+
 BoundingBox Transform(const BoundingBox& bounding_box, const glm::mat4& transform) {
+  // transform the bounding box center and project its half-extents onto the absolute basis vectors of the transform
+  // which produces the same result as transforming all eight corners for affine transforms at a fraction of the cost
   const auto& [min_vertex, max_vertex] = bounding_box;
-  const std::array local_vertices{glm::vec4{min_vertex.x, min_vertex.y, min_vertex.z, 1.0f},
-                                  glm::vec4{max_vertex.x, min_vertex.y, min_vertex.z, 1.0f},
-                                  glm::vec4{min_vertex.x, max_vertex.y, min_vertex.z, 1.0f},
-                                  glm::vec4{max_vertex.x, max_vertex.y, min_vertex.z, 1.0f},
-                                  glm::vec4{min_vertex.x, min_vertex.y, max_vertex.z, 1.0f},
-                                  glm::vec4{max_vertex.x, min_vertex.y, max_vertex.z, 1.0f},
-                                  glm::vec4{min_vertex.x, max_vertex.y, max_vertex.z, 1.0f},
-                                  glm::vec4{max_vertex.x, max_vertex.y, max_vertex.z, 1.0f}};
-
-  return std::ranges::fold_left(local_vertices,
-                                BoundingBox{.min = glm::vec3{std::numeric_limits<float>::max()},
-                                            .max = glm::vec3{std::numeric_limits<float>::min()}},
-                                [&transform](const auto& transform_bounding_box, const auto& local_vertex) {
-                                  const auto& [transform_min_vertex, transform_max_vertex] = transform_bounding_box;
-                                  const glm::vec3 transform_vertex = transform * local_vertex;
-                                  return BoundingBox{.min = glm::min(transform_min_vertex, transform_vertex),
-                                                     .max = glm::max(transform_max_vertex, transform_vertex)};
-                                });
+  const auto center = 0.5f * (min_vertex + max_vertex);
+  const auto half_extents = 0.5f * (max_vertex - min_vertex);
+
+  const glm::vec3 transform_center = transform * glm::vec4{center, 1.0f};
+  const glm::mat3 absolute_basis{glm::abs(glm::vec3{transform[0]}),
+                                 glm::abs(glm::vec3{transform[1]}),
+                                 glm::abs(glm::vec3{transform[2]})};
+  const auto transform_half_extents = absolute_basis * half_extents;
+
+  return BoundingBox{.min = transform_center - transform_half_extents,
+                     .max = transform_center + transform_half_extents};
 }
 
 }  // namespace vktf
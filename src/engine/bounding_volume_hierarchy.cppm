@@ -0,0 +1,214 @@
+module;
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+export module bounding_volume_hierarchy;
+
+import bounding_box;
+import view_frustum;
+
+namespace vktf {
+
+/**
+ * @brief A bounding volume hierarchy for hierarchical view frustum culling.
+ * @details This class organizes a collection of world-space bounding boxes into a binary tree where each tree node
+ *          bounds all bounding boxes in its subtree. Culling traverses the tree from the root which rejects an entire
+ *          subtree outside the view frustum and accepts an entire subtree inside the view frustum with a single test
+ *          so only subtrees intersecting a view frustum plane are tested further. The tree topology is built once from
+ *          bounding box centroids and refit when bounding boxes move which avoids rebuilding the tree each frame at
+ *          the cost of looser bounds when bounding boxes move far from their original positions.
+ */
+export class [[nodiscard]] BoundingVolumeHierarchy {
+public:
+  /** @brief Creates an empty @ref BoundingVolumeHierarchy. */
+  BoundingVolumeHierarchy() noexcept = default;
+
+  /**
+   * @brief Creates a @ref BoundingVolumeHierarchy.
+   * @param bounding_boxes The world-space bounding boxes to build the hierarchy from.
+   */
+  explicit BoundingVolumeHierarchy(const BoundingBoxes& bounding_boxes);
+
+  /** @brief Gets the number of bounding boxes in the hierarchy. */
+  [[nodiscard]] std::size_t size() const noexcept { return indices_.size(); }
+
+  /**
+   * @brief Updates tree node bounds to enclose the current position of each bounding box.
+   * @param bounding_boxes The world-space bounding boxes ordered the same as when the hierarchy was built.
+   */
+  void Refit(const BoundingBoxes& bounding_boxes);
+
+  /**
+   * @brief Tests which bounding boxes in the hierarchy intersect with a view frustum.
+   * @details Bounding boxes are tested against the bounds they had when the hierarchy was last refit.
+   * @param view_frustum The view frustum to test for intersection.
+   * @param visibility_mask The bitmask to write intersection results to where bit <tt>i % 64</tt> of element
+   *                        <tt>i / 64</tt> is set if bounding box @c i intersects with the view frustum.
+   * @warning The caller is responsible for ensuring @p visibility_mask contains at least one element for every 64
+   *          bounding boxes.
+   */
+  void Cull(const ViewFrustum& view_frustum, std::span<std::uint64_t> visibility_mask) const;
+
+private:
+  struct Node {
+    BoundingBox bounding_box;
+    std::uint32_t first_index = 0;   // the first element in indices_ enclosed by this node
+    std::uint32_t index_count = 0;   // the number of elements in indices_ enclosed by this node
+    std::uint32_t second_child = 0;  // the first child immediately follows its parent, zero for leaf nodes
+  };
+
+  std::uint32_t Build(const BoundingBoxes& bounding_boxes, std::uint32_t first_index, std::uint32_t index_count);
+
+  void Cull(std::uint32_t node_index, const ViewFrustum& view_frustum, std::span<std::uint64_t> visibility_mask) const;
+
+  std::vector<Node> nodes_;  // stored in depth-first pre-order so children always follow their parent
+  std::vector<std::uint32_t> indices_;
+  BoundingBoxes leaf_bounding_boxes_;  // ordered by indices_ so each leaf is tested as a contiguous batch
+};
+
+}  // namespace vktf
+
+module :private;
+
+namespace vktf {
+
+namespace {
+
+constexpr std::uint32_t kMaxLeafSize = 16;  // fills an AVX-512 batch when testing leaf bounding boxes
+constexpr std::size_t kVisibilityMaskBits = 64;
+
+BoundingBox Union(const BoundingBox& lhs, const BoundingBox& rhs) {
+  return BoundingBox{.min = glm::min(lhs.min, rhs.min), .max = glm::max(lhs.max, rhs.max)};
+}
+
+glm::vec3 GetCentroid(const BoundingBoxes& bounding_boxes, const std::uint32_t index) {
+  const auto [min, max] = bounding_boxes[index];
+  return 0.5f * (min + max);
+}
+
+glm::length_t GetLongestAxis(const BoundingBox& bounding_box) {
+  const auto extent = bounding_box.max - bounding_box.min;
+  if (extent.x >= extent.y && extent.x >= extent.z) return 0;
+  return extent.y >= extent.z ? 1 : 2;
+}
+
+void SetVisible(const std::span<std::uint64_t> visibility_mask, const std::size_t index) {
+  visibility_mask[index / kVisibilityMaskBits] |= std::uint64_t{1} << index % kVisibilityMaskBits;
+}
+
+}  // namespace
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const BoundingBoxes& bounding_boxes)
+    : indices_(bounding_boxes.size()) {
+  if (indices_.empty()) return;
+
+  std::iota(indices_.begin(), indices_.end(), 0u);
+  Build(bounding_boxes, 0, static_cast<std::uint32_t>(indices_.size()));
+
+  leaf_bounding_boxes_.Reserve(indices_.size());
+  for (const auto index : indices_) {
+    leaf_bounding_boxes_.Add(bounding_boxes[index]);
+  }
+  Refit(bounding_boxes);
+}
+
+std::uint32_t BoundingVolumeHierarchy::Build(const BoundingBoxes& bounding_boxes,
+                                             const std::uint32_t first_index,
+                                             const std::uint32_t index_count) {
+  const auto node_index = static_cast<std::uint32_t>(nodes_.size());
+  nodes_.push_back(Node{.first_index = first_index, .index_count = index_count});
+  if (index_count <= kMaxLeafSize) return node_index;
+
+  const auto indices = std::span{indices_}.subspan(first_index, index_count);
+  const auto first_centroid = GetCentroid(bounding_boxes, indices.front());
+  BoundingBox centroid_bounds{.min = first_centroid, .max = first_centroid};
+  for (const auto index : indices.subspan(1)) {
+    const auto centroid = GetCentroid(bounding_boxes, index);
+    centroid_bounds = Union(centroid_bounds, BoundingBox{.min = centroid, .max = centroid});
+  }
+
+  // partition bounding boxes at the median centroid along the longest axis which guarantees a balanced tree
+  const auto axis = GetLongestAxis(centroid_bounds);
+  const auto left_count = index_count / 2;
+  std::ranges::nth_element(indices,
+                           indices.begin() + left_count,
+                           [&bounding_boxes, axis](const auto lhs_index, const auto rhs_index) {
+                             return GetCentroid(bounding_boxes, lhs_index)[axis]
+                                    < GetCentroid(bounding_boxes, rhs_index)[axis];
+                           });
+
+  Build(bounding_boxes, first_index, left_count);
+  const auto second_child = Build(bounding_boxes, first_index + left_count, index_count - left_count);
+  nodes_[node_index].second_child = second_child;  // nodes_ may be reallocated by recursive calls
+
+  return node_index;
+}
+
+void BoundingVolumeHierarchy::Refit(const BoundingBoxes& bounding_boxes) {
+  assert(bounding_boxes.size() == indices_.size());  // bounding boxes must not be added or removed after construction
+
+  for (const auto& [leaf_index, index] : std::views::enumerate(indices_)) {
+    leaf_bounding_boxes_.Set(static_cast<std::size_t>(leaf_index), bounding_boxes[index]);
+  }
+
+  // children are stored after their parent so iterating in reverse updates children before their parent
+  for (auto node_index = nodes_.size(); node_index-- > 0;) {
+    auto& [bounding_box, first_index, index_count, second_child] = nodes_[node_index];
+
+    if (second_child != 0) {
+      bounding_box = Union(nodes_[node_index + 1].bounding_box, nodes_[second_child].bounding_box);
+      continue;
+    }
+
+    bounding_box = leaf_bounding_boxes_[first_index];
+    for (auto leaf_index = first_index + 1; leaf_index < first_index + index_count; ++leaf_index) {
+      bounding_box = Union(bounding_box, leaf_bounding_boxes_[leaf_index]);
+    }
+  }
+}
+
+void BoundingVolumeHierarchy::Cull(const ViewFrustum& view_frustum,
+                                   const std::span<std::uint64_t> visibility_mask) const {
+  assert(visibility_mask.size() * kVisibilityMaskBits >= indices_.size());
+  std::ranges::fill(visibility_mask, 0);
+  if (!nodes_.empty()) Cull(0, view_frustum, visibility_mask);
+}
+
+void BoundingVolumeHierarchy::Cull(const std::uint32_t node_index,
+                                   const ViewFrustum& view_frustum,
+                                   const std::span<std::uint64_t> visibility_mask) const {
+  const auto& [bounding_box, first_index, index_count, second_child] = nodes_[node_index];
+  if (!view_frustum.Intersects(bounding_box)) return;  // reject the entire subtree
+
+  const auto indices = std::span{indices_}.subspan(first_index, index_count);
+  if (view_frustum.Contains(bounding_box)) {
+    for (const auto index : indices) SetVisible(visibility_mask, index);  // accept the entire subtree
+    return;
+  }
+
+  if (second_child != 0) {
+    Cull(node_index + 1, view_frustum, visibility_mask);
+    Cull(second_child, view_frustum, visibility_mask);
+    return;
+  }
+
+  // leaf bounding boxes are contiguous which allows testing an entire leaf with batched instructions
+  static_assert(kMaxLeafSize <= kVisibilityMaskBits);
+  const auto leaf_mask = view_frustum.Intersects(leaf_bounding_boxes_, first_index, index_count);
+  for (const auto& [leaf_offset, index] : std::views::enumerate(indices)) {
+    if ((leaf_mask >> leaf_offset & 1u) != 0) {
+      SetVisible(visibility_mask, index);
+    }
+  }
+}
+
+}  // namespace vktf
@@ -1,7 +1,10 @@
 module;
 
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <span>
 #include <utility>
 
 #include <vk_mem_alloc.h>
@@ -30,6 +33,12 @@ public:
 
     /** @brief The parameters for allocating buffer memory. */
     const VmaAllocationCreateInfo& allocation_create_info;
+
+    /**
+     * @brief The unique queue families that access the buffer concurrently.
+     * @note When fewer than two queue families are specified, the buffer is exclusively owned by one queue family.
+     */
+    std::span<const std::uint32_t> queue_family_indices;
   };
 
   /**
@@ -126,17 +135,39 @@ public:
    *          types (e.g., world-space lights).
    * @tparam T The type of each element in @p data_view.
    * @param data_view A view of the data to copy.
+   * @param offset_bytes The offset in bytes from the start of this buffer to copy data to.
    * @warning @ref HostVisibleBuffer::MapMemory must be called before invoking this function.
    */
   template <typename T>
-  void Copy(const DataView<T> data_view) {
+  void Copy(const DataView<T> data_view, const vk::DeviceSize offset_bytes = 0) {
     assert(mapped_memory_ != nullptr);
-    assert(data_view.size_bytes() <= size_bytes_);
-    memcpy(mapped_memory_, data_view.data(), data_view.size_bytes());
-    const auto result = vmaFlushAllocation(allocator_, allocation_, 0, vk::WholeSize);
+    assert(offset_bytes + data_view.size_bytes() <= size_bytes_);
+    memcpy(static_cast<std::byte*>(mapped_memory_) + offset_bytes, data_view.data(), data_view.size_bytes());
+    const auto result = vmaFlushAllocation(allocator_, allocation_, offset_bytes, data_view.size_bytes());
     vk::detail::resultCheck(static_cast<vk::Result>(result), "Flush allocation failed");
   }
 
+  /**
+   * @brief Gets a view of the mapped memory for writing data directly to this buffer.
+   * @details Writing directly to mapped memory avoids copying data from an intermediate host allocation when data must
+   *          be transformed before it's uploaded such as interleaving vertex attributes.
+   * @tparam T The type of each element in this buffer.
+   * @return A view of the elements in this buffer.
+   * @warning @ref HostVisibleBuffer::MapMemory must be called before invoking this function and the caller is
+   *          responsible for invoking @ref HostVisibleBuffer::Flush after writing to the returned view.
+   */
+  template <typename T>
+  [[nodiscard]] std::span<T> GetMappedData() const noexcept {
+    assert(mapped_memory_ != nullptr);
+    return std::span{static_cast<T*>(mapped_memory_), static_cast<std::size_t>(size_bytes_ / sizeof(T))};
+  }
+
+  /**
+   * @brief Flushes host writes to the mapped memory for this buffer to make them visible to the device.
+   * @warning @ref HostVisibleBuffer::MapMemory must be called before invoking this function.
+   */
+  void Flush() const;
+
 private:
   void* mapped_memory_ = nullptr;
 };
@@ -169,6 +200,7 @@ export template <typename T>
  * @param command_buffer The command buffer for recording copy commands to transfer data to the device-local buffer.
  * @param host_visible_buffer The host-visible buffer to copy data from.
  * @param usage_flags The bitwise flags indicating how the buffer will be used.
+ * @param queue_family_indices @copybrief Buffer::CreateInfo::queue_family_indices
  * @return A buffer in device-local memory that will contain the data in @p host_visible_buffer when @p command_buffer
  *         completes queue submission.
  * @warning The caller is responsible for submitting @p command_buffer to a Vulkan queue to begin execution.
@@ -176,11 +208,13 @@ export template <typename T>
 export [[nodiscard]] Buffer CreateDeviceLocalBuffer(const vma::Allocator& allocator,
                                                     const vk::CommandBuffer command_buffer,
                                                     const HostVisibleBuffer& host_visible_buffer,
-                                                    const vk::BufferUsageFlags usage_flags) {
+                                                    const vk::BufferUsageFlags usage_flags,
+                                                    const std::span<const std::uint32_t> queue_family_indices = {}) {
   Buffer device_local_buffer{allocator,
                              Buffer::CreateInfo{.size_bytes = host_visible_buffer.size_bytes(),
                                                 .usage_flags = usage_flags | vk::BufferUsageFlagBits::eTransferDst,
-                                                .allocation_create_info = vma::kDeviceLocalAllocationCreateInfo}};
+                                                .allocation_create_info = vma::kDeviceLocalAllocationCreateInfo,
+                                                .queue_family_indices = queue_family_indices}};
   device_local_buffer.Copy(host_visible_buffer, command_buffer);
   return device_local_buffer;
 }
@@ -194,10 +228,15 @@ namespace vktf {
 namespace {
 
 std::pair<VmaAllocation, vk::Buffer> CreateBuffer(const VmaAllocator allocator, const Buffer::CreateInfo& create_info) {
-  const auto& [size_bytes, usage_flags, allocation_create_info] = create_info;
-  const VkBufferCreateInfo buffer_create_info{.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-                                              .size = size_bytes,
-                                              .usage = static_cast<VkBufferUsageFlags>(usage_flags)};
+  const auto& [size_bytes, usage_flags, allocation_create_info, queue_family_indices] = create_info;
+  const auto is_concurrent = queue_family_indices.size() > 1;
+  const VkBufferCreateInfo buffer_create_info{
+      .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+      .size = size_bytes,
+      .usage = static_cast<VkBufferUsageFlags>(usage_flags),
+      .sharingMode = is_concurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+      .queueFamilyIndexCount = is_concurrent ? static_cast<std::uint32_t>(queue_family_indices.size()) : 0,
+      .pQueueFamilyIndices = is_concurrent ? queue_family_indices.data() : nullptr};
 
   VkBuffer buffer = nullptr;
   VmaAllocation allocation = nullptr;
@@ -265,6 +304,12 @@ void HostVisibleBuffer::MapMemory() {
   }
 }
 
+void HostVisibleBuffer::Flush() const {
+  assert(mapped_memory_ != nullptr);
+  const auto result = vmaFlushAllocation(allocator_, allocation_, 0, vk::WholeSize);
+  vk::detail::resultCheck(static_cast<vk::Result>(result), "Flush allocation failed");
+}
+
 void HostVisibleBuffer::UnmapMemory() noexcept {
   if (mapped_memory_ != nullptr) {
     vmaUnmapMemory(allocator_, allocation_);
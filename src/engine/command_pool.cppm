@@ -26,6 +26,9 @@ public:
 
     /** @brief The number of command buffers to allocate for the command pool. */
     std::uint32_t command_buffer_count = 0;
+
+    /** @brief The level of command buffers to allocate for the command pool. */
+    vk::CommandBufferLevel command_buffer_level = vk::CommandBufferLevel::ePrimary;
   };
 
   /**
@@ -55,23 +58,23 @@ namespace vktf {
 namespace {
 
 vk::UniqueCommandPool CreateCommandPool(const vk::Device device, const CommandPool::CreateInfo& create_info) {
-  const auto& [command_pool_create_flags, queue_family_index, _] = create_info;
-  return device.createCommandPoolUnique(
-      vk::CommandPoolCreateInfo{.flags = command_pool_create_flags, .queueFamilyIndex = queue_family_index});
+  return device.createCommandPoolUnique(vk::CommandPoolCreateInfo{.flags = create_info.command_pool_create_flags,
+                                                                  .queueFamilyIndex = create_info.queue_family_index});
 }
 
 std::vector<vk::CommandBuffer> AllocateCommandBuffers(const vk::Device device,
                                                       const vk::CommandPool command_pool,
-                                                      const std::uint32_t command_buffer_count) {
-  return device.allocateCommandBuffers(vk::CommandBufferAllocateInfo{.commandPool = command_pool,
-                                                                     .level = vk::CommandBufferLevel::ePrimary,
-                                                                     .commandBufferCount = command_buffer_count});
+                                                      const CommandPool::CreateInfo& create_info) {
+  return device.allocateCommandBuffers(
+      vk::CommandBufferAllocateInfo{.commandPool = command_pool,
+                                    .level = create_info.command_buffer_level,
+                                    .commandBufferCount = create_info.command_buffer_count});
 }
 
 }  // namespace
 
 CommandPool::CommandPool(const vk::Device device, const CreateInfo& create_info)
     : command_pool_{CreateCommandPool(device, create_info)},
-      command_buffers_{AllocateCommandBuffers(device, *command_pool_, create_info.command_buffer_count)} {}
+      command_buffers_{AllocateCommandBuffers(device, *command_pool_, create_info)} {}
 
 }  // namespace vktf
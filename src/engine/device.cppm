@@ -66,9 +66,9 @@ namespace vktf {
 namespace {
 
 std::vector<vk::DeviceQueueCreateInfo> GetDeviceQueueCreateInfos(const QueueFamilies& queue_families) {
-  const auto& [graphics_queue_family, present_queue_family] = queue_families;
+  const auto& [graphics_queue_family, present_queue_family, transfer_queue_family] = queue_families;
 
-  return std::unordered_set{graphics_queue_family.index, present_queue_family.index}
+  return std::unordered_set{graphics_queue_family.index, present_queue_family.index, transfer_queue_family.index}
          | std::views::transform([](const auto queue_family_index) {
              static constexpr auto kDefaultQueuePriority = 0.5f;
              return vk::DeviceQueueCreateInfo{
@@ -84,8 +84,12 @@ vk::UniqueDevice CreateDevice(const vk::PhysicalDevice& physical_device, const D
   const auto& [queue_families, enabled_extensions, enabled_features] = create_info;
   const auto device_queue_create_infos = GetDeviceQueueCreateInfos(queue_families);
 
+  // timeline semaphores are required to track asynchronous uploads and are always supported in Vulkan 1.2 or later
+  static constexpr vk::PhysicalDeviceVulkan12Features kVulkan12Features{.timelineSemaphore = vk::True};
+
   auto device = physical_device.createDeviceUnique(
-      vk::DeviceCreateInfo{.queueCreateInfoCount = static_cast<std::uint32_t>(device_queue_create_infos.size()),
+      vk::DeviceCreateInfo{.pNext = &kVulkan12Features,
+                           .queueCreateInfoCount = static_cast<std::uint32_t>(device_queue_create_infos.size()),
                            .pQueueCreateInfos = device_queue_create_infos.data(),
                            .enabledExtensionCount = static_cast<std::uint32_t>(enabled_extensions.size()),
                            .ppEnabledExtensionNames = enabled_extensions.data(),
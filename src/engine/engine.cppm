@@ -2,36 +2,46 @@ module;
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
 #include <concepts>
 #include <cstdint>
 #include <filesystem>
+#include <format>
 #include <initializer_list>
 #include <limits>
 #include <optional>
 #include <ranges>
+#include <thread>
 #include <vector>
 
+#include <glm/glm.hpp>
 #include <vk_mem_alloc.h>
 #include <vulkan/vulkan.hpp>
 
 export module engine;
 
+import asset_cache;
 import buffer;
 import camera;
 import command_pool;
 import delta_time;
 import descriptor_pool;
 import device;
+import glslang_compiler;
 import gltf_asset;
+import gpu_profiler;
 import image;
 import instance;
 import log;
 import model;
 import physical_device;
+import pipeline_cache;
+import profiler;
 import queue;
 import scene;
 import swapchain;
+import thread_pool;
 import vma_allocator;
 import window;
 
@@ -39,6 +49,9 @@ namespace vktf {
 
 constexpr std::size_t kMaxRenderFrames = 2;
 
+// the lights uniform buffer must not exceed the minimum maxUniformBufferRange of 16384 bytes guaranteed by Vulkan
+constexpr std::uint32_t kMaxLightCount = 256;
+
 /**
  * @brief The core graphics engine that orchestrates Vulkan initialization and rendering.
  * @details This class handles Vulkan initialization and defines the primary APIs for loading and rendering glTF scenes.
@@ -62,6 +75,12 @@ public:
    */
   explicit Engine(const Window& window);
 
+  /**
+   * @brief Gets the GPU profiler which times the render pass and the draw commands for each model in every frame.
+   * @details Zone timings are averaged over recent frames and retrieved with @ref GpuProfiler::GetAverageTimings.
+   */
+  [[nodiscard]] const GpuProfiler& gpu_profiler() const noexcept { return gpu_profiler_; }
+
   /**
    * @brief Begins the main application loop.
    * @details This function enters a blocking loop that continues until the window closes. At each iteration, it updates
@@ -76,6 +95,7 @@ public:
   template <std::invocable<DeltaTime> Fn>
   void Run(const Window& window, Fn&& main_loop) const {
     for (DeltaTime delta_time; !window.IsClosed();) {
+      const ProfileZone profile_zone{"Frame"};
       delta_time.Update();
       window.Update();
       std::forward<Fn>(main_loop)(delta_time);
@@ -88,18 +108,35 @@ public:
    * @details This function executes the entire asset loading pipeline including reading glTF files from disk, copying
    *          meshes, materials, and textures to device-local memory, initializing frame-dependent uniform buffers for
    *          global resources, and constructing a combined scene graph for all supported models in the scene.
-   * @param gltf_filepaths The glTF asset filepaths to load.
+   * @param gltf_filepaths The glTF (.gltf) or binary glTF (.glb) asset filepaths to load.
    * @param log The log for writing messages when creating a scene.
    * @return A scene containing all supported glTF assets or @c std::nullopt if none could be loaded.
    */
   [[nodiscard]] std::optional<Scene> Load(const std::span<const std::filesystem::path> gltf_filepaths,
                                           Log& log = Log::Default());
 
+  /**
+   * @brief Loads a glTF asset into an existing scene in the background.
+   * @details This function returns immediately and executes the asset loading pipeline for a single glTF asset on a
+   *          background thread. The resulting model is uploaded on the transfer queue and added to the scene once its
+   *          upload completes without stalling frames rendered in the meantime.
+   * @param scene The scene to add the model to.
+   * @param gltf_filepath The glTF (.gltf) or binary glTF (.glb) asset filepath to load.
+   * @param log The log for writing messages when loading the asset.
+   * @return The ID for removing the model with @ref Scene::Remove or @c std::nullopt if the asset is not a glTF file.
+   * @warning The caller is responsible for ensuring the engine and @p log outlive @p scene.
+   */
+  std::optional<Scene::ModelId> LoadAsync(Scene& scene,
+                                          const std::filesystem::path& gltf_filepath,
+                                          Log& log = Log::Default());
+
   /**
    * @brief Renders a scene for the current frame.
    * @details This function executes the entire graphics rendering pipeline for the current frame including recording
    *          draw commands for each visible mesh in the scene, synchronizing command buffer submission to the graphics
-   *          queue, and presenting the results to the next available swapchain image.
+   *          queue, and presenting the results to the next available swapchain image. When the engine thread pool has
+   *          multiple worker threads, draw commands are recorded concurrently into secondary command buffers that are
+   *          executed by the primary command buffer for the current frame.
    * @param scene The scene to render for the current frame.
    */
   void Render(Scene& scene);
@@ -109,7 +146,12 @@ private:
   Instance instance_;
   vk::UniqueSurfaceKHR surface_;
   PhysicalDevice physical_device_;
+  ThreadPool thread_pool_;
+  ThreadPool streaming_thread_pool_;  // must be declared before the asset cache which submits tasks to it
+  AssetCache asset_cache_;
   Device device_;
+  PipelineCache pipeline_cache_;
+  glslang::SpirvCache spirv_cache_;
   vma::Allocator allocator_;
   Swapchain swapchain_;
   vk::SampleCountFlagBits msaa_sample_count_ = vk::SampleCountFlagBits::e1;
@@ -119,14 +161,21 @@ private:
   std::vector<vk::UniqueFramebuffer> framebuffers_;
   Queue graphics_queue_;
   Queue present_queue_;
+  Queue transfer_queue_;
+  std::vector<std::uint32_t> resource_queue_family_indices_;  // queue families that access scene resources
   CommandPool render_command_pool_;
+  std::array<std::vector<CommandPool>, kMaxRenderFrames> secondary_command_pools_;  // one per worker thread per frame
+  std::array<std::vector<vk::CommandBuffer>, kMaxRenderFrames> secondary_command_buffers_;
   std::array<vk::UniqueFence, kMaxRenderFrames> render_fences_;
   std::array<vk::UniqueSemaphore, kMaxRenderFrames> acquire_next_image_semaphores_;
   std::array<vk::UniqueSemaphore, kMaxRenderFrames> present_image_semaphores_;
+  GpuProfiler gpu_profiler_;
   vk::UniqueDescriptorSetLayout global_descriptor_set_layout_;
   DescriptorPool global_descriptor_pool_;  // per-frame descriptor set bindings
   std::vector<HostVisibleBuffer> camera_uniform_buffers_;
   std::vector<HostVisibleBuffer> lights_uniform_buffers_;
+  std::vector<HostVisibleBuffer> instance_transforms_buffers_;
+  std::vector<HostVisibleBuffer> draw_commands_buffers_;
 };
 
 }  // namespace vktf
@@ -148,12 +197,20 @@ constexpr std::initializer_list<const char*> kRequiredInstanceLayers{
 constexpr std::initializer_list kRequiredDeviceExtension{VK_KHR_SWAPCHAIN_EXTENSION_NAME};
 
 vk::PhysicalDeviceFeatures GetEnabledFeatures(const vk::PhysicalDeviceFeatures& physical_device_features) {
-  return vk::PhysicalDeviceFeatures{.samplerAnisotropy = physical_device_features.samplerAnisotropy,
+  return vk::PhysicalDeviceFeatures{.multiDrawIndirect = physical_device_features.multiDrawIndirect,
+                                    .drawIndirectFirstInstance = physical_device_features.drawIndirectFirstInstance,
+                                    .samplerAnisotropy = physical_device_features.samplerAnisotropy,
                                     .textureCompressionETC2 = physical_device_features.textureCompressionETC2,
                                     .textureCompressionASTC_LDR = physical_device_features.textureCompressionASTC_LDR,
                                     .textureCompressionBC = physical_device_features.textureCompressionBC};
 }
 
+bool IsMultiDrawIndirectSupported(const vk::PhysicalDeviceFeatures& physical_device_features) {
+  // non-zero first instance values are required to index instance transforms from indirect draw commands
+  return physical_device_features.multiDrawIndirect == vk::True
+         && physical_device_features.drawIndirectFirstInstance == vk::True;
+}
+
 vk::SampleCountFlagBits GetMsaaSampleCount(const vk::PhysicalDeviceLimits& physical_device_limits) {
   const auto color_sample_count_flags = physical_device_limits.framebufferColorSampleCounts;
   const auto depth_sample_count_flags = physical_device_limits.framebufferDepthSampleCounts;
@@ -289,6 +346,51 @@ std::vector<vk::UniqueFramebuffer> CreateFramebuffers(const vk::Device device,
          | std::ranges::to<std::vector>();
 }
 
+std::vector<std::uint32_t> GetResourceQueueFamilyIndices(const QueueFamilies& queue_families) {
+  // device-local resources are shared concurrently by the graphics and transfer queue families when they differ which
+  // avoids transferring queue family ownership after uploads complete on a dedicated transfer queue
+  const auto& [graphics_queue_family, _, transfer_queue_family] = queue_families;
+  if (graphics_queue_family.index == transfer_queue_family.index) return {graphics_queue_family.index};
+  return {graphics_queue_family.index, transfer_queue_family.index};
+}
+
+using SecondaryCommandPools = std::array<std::vector<CommandPool>, kMaxRenderFrames>;
+
+SecondaryCommandPools CreateSecondaryCommandPools(const vk::Device device,
+                                                  const std::uint32_t queue_family_index,
+                                                  const ThreadPool& thread_pool) {
+  // draw commands are only recorded concurrently when there are multiple worker threads to record them
+  const auto command_pool_count = thread_pool.thread_count() > 1 ? thread_pool.thread_count() : 0;
+  SecondaryCommandPools secondary_command_pools;
+
+  // command pools are externally synchronized so each command buffer recorded concurrently requires its own pool
+  std::ranges::generate(secondary_command_pools, [device, queue_family_index, command_pool_count] {
+    return std::views::iota(0uz, command_pool_count)
+           | std::views::transform([device, queue_family_index]([[maybe_unused]] const auto /*index*/) {
+               return CommandPool{
+                   device,
+                   CommandPool::CreateInfo{.command_pool_create_flags = vk::CommandPoolCreateFlagBits::eTransient,
+                                           .queue_family_index = queue_family_index,
+                                           .command_buffer_count = 1,
+                                           .command_buffer_level = vk::CommandBufferLevel::eSecondary}};
+             })
+           | std::ranges::to<std::vector>();
+  });
+
+  return secondary_command_pools;
+}
+
+std::array<std::vector<vk::CommandBuffer>, kMaxRenderFrames> GetSecondaryCommandBuffers(
+    const SecondaryCommandPools& secondary_command_pools) {
+  std::array<std::vector<vk::CommandBuffer>, kMaxRenderFrames> secondary_command_buffers;
+  std::ranges::transform(secondary_command_pools, secondary_command_buffers.begin(), [](const auto& command_pools) {
+    return command_pools  //
+           | std::views::transform([](const auto& command_pool) { return command_pool.command_buffers().front(); })
+           | std::ranges::to<std::vector>();
+  });
+  return secondary_command_buffers;
+}
+
 std::array<vk::UniqueFence, kMaxRenderFrames> CreateFences(const vk::Device device) {
   std::array<vk::UniqueFence, kMaxRenderFrames> fences;
   std::ranges::generate(fences, [device] {
@@ -304,16 +406,22 @@ std::array<vk::UniqueSemaphore, kMaxRenderFrames> CreateSemaphores(const vk::Dev
   return semaphores;
 }
 
-std::vector<HostVisibleBuffer> CreateUniformBuffers(const vma::Allocator& allocator,
-                                                    const std::size_t buffer_size_bytes) {
+HostVisibleBuffer CreateHostVisibleBuffer(const vma::Allocator& allocator,
+                                          const vk::DeviceSize buffer_size_bytes,
+                                          const vk::BufferUsageFlags usage_flags) {
+  HostVisibleBuffer host_visible_buffer{
+      allocator,
+      HostVisibleBuffer::CreateInfo{.size_bytes = buffer_size_bytes, .usage_flags = usage_flags}};
+  host_visible_buffer.MapMemory();  // enable persistent mapping
+  return host_visible_buffer;
+}
+
+std::vector<HostVisibleBuffer> CreateHostVisibleBuffers(const vma::Allocator& allocator,
+                                                        const vk::DeviceSize buffer_size_bytes,
+                                                        const vk::BufferUsageFlags usage_flags) {
   return std::views::iota(0uz, kMaxRenderFrames)
-         | std::views::transform([&allocator, buffer_size_bytes]([[maybe_unused]] const auto /*index*/) {
-             HostVisibleBuffer uniform_buffer{
-                 allocator,
-                 HostVisibleBuffer::CreateInfo{.size_bytes = buffer_size_bytes,
-                                               .usage_flags = vk::BufferUsageFlagBits::eUniformBuffer}};
-             uniform_buffer.MapMemory();  // enable persistent mapping
-             return uniform_buffer;
+         | std::views::transform([&allocator, buffer_size_bytes, usage_flags]([[maybe_unused]] const auto /*index*/) {
+             return CreateHostVisibleBuffer(allocator, buffer_size_bytes, usage_flags);
            })
          | std::ranges::to<std::vector>();
 }
@@ -329,7 +437,11 @@ vk::UniqueDescriptorSetLayout CreateGlobalDescriptorSetLayout(const vk::Device d
       vk::DescriptorSetLayoutBinding{.binding = 1,  // lights uniform buffer
                                      .descriptorType = vk::DescriptorType::eUniformBuffer,
                                      .descriptorCount = 1,
-                                     .stageFlags = eFragment}};
+                                     .stageFlags = eFragment},
+      vk::DescriptorSetLayoutBinding{.binding = 2,  // instance transforms storage buffer
+                                     .descriptorType = vk::DescriptorType::eStorageBuffer,
+                                     .descriptorCount = 1,
+                                     .stageFlags = eVertex}};
 
   return device.createDescriptorSetLayoutUnique(
       vk::DescriptorSetLayoutCreateInfo{.bindingCount = static_cast<std::uint32_t>(kDescriptorSetLayoutBindings.size()),
@@ -339,10 +451,13 @@ vk::UniqueDescriptorSetLayout CreateGlobalDescriptorSetLayout(const vk::Device d
 DescriptorPool CreateGlobalDescriptorPool(const vk::Device device,
                                           const vk::DescriptorSetLayout global_descriptor_set_layout) {
   static constexpr std::uint32_t kUniformBuffersPerRenderFrame = 2;  // camera transforms, world-space lights
+  static constexpr std::uint32_t kStorageBuffersPerRenderFrame = 1;  // instance transforms
 
   static const std::vector descriptor_pool_sizes{
       vk::DescriptorPoolSize{.type = vk::DescriptorType::eUniformBuffer,
-                             .descriptorCount = kUniformBuffersPerRenderFrame * kMaxRenderFrames}};
+                             .descriptorCount = kUniformBuffersPerRenderFrame * kMaxRenderFrames},
+      vk::DescriptorPoolSize{.type = vk::DescriptorType::eStorageBuffer,
+                             .descriptorCount = kStorageBuffersPerRenderFrame * kMaxRenderFrames}};
 
   return DescriptorPool{device,
                         DescriptorPool::CreateInfo{.descriptor_pool_sizes = descriptor_pool_sizes,
@@ -350,42 +465,50 @@ DescriptorPool CreateGlobalDescriptorPool(const vk::Device device,
                                                    .descriptor_set_count = kMaxRenderFrames}};
 }
 
-void UpdateGlobalDescriptorSets(const vk::Device device,
-                                const std::vector<vk::DescriptorSet>& global_descriptor_sets,
-                                const std::vector<HostVisibleBuffer>& camera_uniform_buffers,
-                                const std::vector<HostVisibleBuffer>& lights_uniform_buffers) {
-  assert(global_descriptor_sets.size() == camera_uniform_buffers.size());
-  assert(global_descriptor_sets.size() == lights_uniform_buffers.size());
-
-  std::vector<vk::DescriptorBufferInfo> descriptor_buffer_infos;
-  const auto uniform_buffer_count = camera_uniform_buffers.size() + lights_uniform_buffers.size();
-  descriptor_buffer_infos.reserve(uniform_buffer_count);
-
-  std::vector<vk::WriteDescriptorSet> descriptor_set_writes;
-  descriptor_set_writes.reserve(uniform_buffer_count);
-
-  for (const auto& [descriptor_set, camera_uniform_buffer, lights_uniform_buffer] :
-       std::views::zip(global_descriptor_sets, camera_uniform_buffers, lights_uniform_buffers)) {
-    const auto& camera_uniform_buffer_info = descriptor_buffer_infos.emplace_back(
-        vk::DescriptorBufferInfo{.buffer = *camera_uniform_buffer, .range = vk::WholeSize});
-
-    descriptor_set_writes.push_back(vk::WriteDescriptorSet{.dstSet = descriptor_set,
-                                                           .dstBinding = 0,
-                                                           .dstArrayElement = 0,
-                                                           .descriptorCount = 1,
-                                                           .descriptorType = vk::DescriptorType::eUniformBuffer,
-                                                           .pBufferInfo = &camera_uniform_buffer_info});
-
-    const auto& lights_uniform_buffer_info = descriptor_buffer_infos.emplace_back(
-        vk::DescriptorBufferInfo{.buffer = *lights_uniform_buffer, .range = vk::WholeSize});
-
-    descriptor_set_writes.push_back(vk::WriteDescriptorSet{.dstSet = descriptor_set,
-                                                           .dstBinding = 1,
-                                                           .dstArrayElement = 0,
-                                                           .descriptorCount = 1,
-                                                           .descriptorType = vk::DescriptorType::eUniformBuffer,
-                                                           .pBufferInfo = &lights_uniform_buffer_info});
+bool IsGltfFile(const std::filesystem::path& asset_filepath, Log& log) {
+  if (const auto extension = asset_filepath.extension(); extension != ".gltf" && extension != ".glb") {
+    log(Log::Severity::kError).Print("Failed to load asset {} with unsupported file extension",
+                                     asset_filepath.string());
+    return false;
   }
+  return true;
+}
+
+vk::DeviceSize GetBufferCapacity(const vk::DeviceSize size_bytes, const vk::DeviceSize element_size) {
+  // buffers grow geometrically to amortize reallocation when streamed models are added to a scene and are sized for at
+  // least one element because Vulkan does not permit zero-sized buffers
+  return std::bit_ceil(std::max(size_bytes, element_size));
+}
+
+void UpdateGlobalDescriptorSet(const vk::Device device,
+                               const vk::DescriptorSet global_descriptor_set,
+                               const HostVisibleBuffer& camera_uniform_buffer,
+                               const HostVisibleBuffer& lights_uniform_buffer,
+                               const HostVisibleBuffer& instance_transforms_buffer) {
+  const std::array descriptor_buffer_infos{
+      vk::DescriptorBufferInfo{.buffer = *camera_uniform_buffer, .range = vk::WholeSize},
+      vk::DescriptorBufferInfo{.buffer = *lights_uniform_buffer, .range = vk::WholeSize},
+      vk::DescriptorBufferInfo{.buffer = *instance_transforms_buffer, .range = vk::WholeSize}};
+
+  const std::array descriptor_set_writes{
+      vk::WriteDescriptorSet{.dstSet = global_descriptor_set,
+                             .dstBinding = 0,
+                             .dstArrayElement = 0,
+                             .descriptorCount = 1,
+                             .descriptorType = vk::DescriptorType::eUniformBuffer,
+                             .pBufferInfo = &descriptor_buffer_infos[0]},
+      vk::WriteDescriptorSet{.dstSet = global_descriptor_set,
+                             .dstBinding = 1,
+                             .dstArrayElement = 0,
+                             .descriptorCount = 1,
+                             .descriptorType = vk::DescriptorType::eUniformBuffer,
+                             .pBufferInfo = &descriptor_buffer_infos[1]},
+      vk::WriteDescriptorSet{.dstSet = global_descriptor_set,
+                             .dstBinding = 2,
+                             .dstArrayElement = 0,
+                             .descriptorCount = 1,
+                             .descriptorType = vk::DescriptorType::eStorageBuffer,
+                             .pBufferInfo = &descriptor_buffer_infos[2]}};
 
   device.updateDescriptorSets(descriptor_set_writes, nullptr);
 }
@@ -400,10 +523,21 @@ Engine::Engine(const Window& window)
       physical_device_{
           *instance_,
           PhysicalDevice::CreateInfo{.surface = *surface_, .required_extensions = kRequiredDeviceExtension}},
+      // streaming uses a separate low-priority pool so background asset loading never queues ahead of per-frame tasks
+      streaming_thread_pool_{std::max(std::thread::hardware_concurrency() / 2, 1u), ThreadPool::Priority::kLow},
+      asset_cache_{AssetCache::CreateInfo{.cache_directory = std::filesystem::temp_directory_path() / "vktf" / "assets",
+                                          .physical_device_features = physical_device_.features(),
+                                          .thread_pool = streaming_thread_pool_}},
       device_{*physical_device_,
               Device::CreateInfo{.queue_families = physical_device_.queue_families(),
                                  .enabled_extensions = kRequiredDeviceExtension,
                                  .enabled_features = GetEnabledFeatures(physical_device_.features())}},
+      pipeline_cache_{*device_,
+                      PipelineCache::CreateInfo{
+                          .physical_device = *physical_device_,
+                          .cache_filepath = std::filesystem::temp_directory_path() / "vktf" / "pipeline_cache.bin",
+                          .log = Log::Default()}},
+      spirv_cache_{std::filesystem::temp_directory_path() / "vktf" / "shaders"},
       allocator_{*device_,
                  vma::Allocator::CreateInfo{.instance = *instance_,
                                             .physical_device = *physical_device_,
@@ -445,14 +579,25 @@ Engine::Engine(const Window& window)
       present_queue_{
           *device_,
           Queue::CreateInfo{.queue_family = physical_device_.queue_families().present_family, .queue_index = 0}},
+      transfer_queue_{
+          *device_,
+          Queue::CreateInfo{.queue_family = physical_device_.queue_families().transfer_family, .queue_index = 0}},
+      resource_queue_family_indices_{GetResourceQueueFamilyIndices(physical_device_.queue_families())},
       render_command_pool_{
           *device_,
           CommandPool::CreateInfo{.command_pool_create_flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
                                   .queue_family_index = graphics_queue_.queue_family_index(),
                                   .command_buffer_count = static_cast<std::uint32_t>(kMaxRenderFrames)}},
+      secondary_command_pools_{
+          CreateSecondaryCommandPools(*device_, graphics_queue_.queue_family_index(), thread_pool_)},
+      secondary_command_buffers_{GetSecondaryCommandBuffers(secondary_command_pools_)},
       render_fences_{CreateFences(*device_)},
       acquire_next_image_semaphores_{CreateSemaphores(*device_)},
       present_image_semaphores_{CreateSemaphores(*device_)},
+      gpu_profiler_{*device_,
+                    GpuProfiler::CreateInfo{.physical_device = *physical_device_,
+                                            .queue_family_index = graphics_queue_.queue_family_index(),
+                                            .max_render_frames = static_cast<std::uint32_t>(kMaxRenderFrames)}},
       global_descriptor_set_layout_{CreateGlobalDescriptorSetLayout(*device_)},
       global_descriptor_pool_{CreateGlobalDescriptorPool(*device_, *global_descriptor_set_layout_)} {}
 
@@ -461,15 +606,8 @@ std::optional<Scene> Engine::Load(const std::span<const std::filesystem::path> g
 
   const auto gltf_assets =
       gltf_filepaths  //
-      | std::views::filter([&log](const auto& asset_filepath) {
-          if (const auto extension = asset_filepath.extension(); extension != ".gltf") {
-            log(Severity::kError) << std::format("Failed to load asset {} with unsupported file extension",
-                                                 asset_filepath.string());
-            return false;  // TODO: add support for loading glTF binary files
-          }
-          return true;
-        })
-      | std::views::transform([&log](const auto& gltf_filepath) { return gltf::Load(gltf_filepath, log); })
+      | std::views::filter([&log](const auto& asset_filepath) { return IsGltfFile(asset_filepath, log); })
+      | std::views::transform([this, &log](const auto& gltf_filepath) { return asset_cache_.Load(gltf_filepath, log); })
       | std::ranges::to<std::vector>();
 
   if (gltf_assets.empty()) {
@@ -480,25 +618,63 @@ std::optional<Scene> Engine::Load(const std::span<const std::filesystem::path> g
   Scene scene{allocator_,
               Scene::CreateInfo{
                   .gltf_assets = gltf_assets,
-                  // TODO: use a dedicated transfer queue to copy data to device-local memory
-                  .transfer_queue = graphics_queue_,
+                  .transfer_queue = transfer_queue_,
+                  .queue_family_indices = resource_queue_family_indices_,
                   .physical_device_features = physical_device_.features(),
+                  .thread_pool = thread_pool_,
+                  .streaming_thread_pool = streaming_thread_pool_,
                   .sampler_anisotropy = GetMaxSamplerAnisotropy(physical_device_.features(), physical_device_.limits()),
+                  .multi_draw_indirect = IsMultiDrawIndirectSupported(physical_device_.features()),
+                  .parallel_update = thread_pool_.thread_count() > 1,
+                  .max_light_count = kMaxLightCount,
+                  .max_render_frames = static_cast<std::uint32_t>(kMaxRenderFrames),
                   .viewport_extent = swapchain_.image_extent(),
                   .msaa_sample_count = msaa_sample_count_,
                   .render_pass = *render_pass_,
                   .global_descriptor_set_layout = *global_descriptor_set_layout_,
+                  .pipeline_cache = pipeline_cache_,
+                  .spirv_cache = spirv_cache_,
                   .log = log}};
 
-  camera_uniform_buffers_ = CreateUniformBuffers(allocator_, sizeof(Scene::CameraProperties));
-  lights_uniform_buffers_ = CreateUniformBuffers(allocator_, sizeof(Scene::WorldLight) * scene.light_count());
-  const auto& global_descriptor_sets = global_descriptor_pool_.descriptor_sets();
-  UpdateGlobalDescriptorSets(*device_, global_descriptor_sets, camera_uniform_buffers_, lights_uniform_buffers_);
+  // instance and draw command buffers are sized for models that are already rendered and grow as uploads complete
+  using enum vk::BufferUsageFlagBits;
+  camera_uniform_buffers_ = CreateHostVisibleBuffers(allocator_, sizeof(Scene::CameraProperties), eUniformBuffer);
+  lights_uniform_buffers_ = CreateHostVisibleBuffers(
+      allocator_,
+      sizeof(Scene::WorldLightsHeader) + sizeof(Scene::WorldLight) * scene.max_light_count(),
+      eUniformBuffer);
+  instance_transforms_buffers_ = CreateHostVisibleBuffers(
+      allocator_,
+      GetBufferCapacity(sizeof(glm::mat4) * scene.max_instance_count(), sizeof(glm::mat4)),
+      eStorageBuffer);
+  draw_commands_buffers_ = CreateHostVisibleBuffers(
+      allocator_,
+      GetBufferCapacity(sizeof(vk::DrawIndexedIndirectCommand) * scene.max_draw_count(),
+                        sizeof(vk::DrawIndexedIndirectCommand)),
+      eIndirectBuffer);
+
+  for (const auto& [global_descriptor_set, camera_uniform_buffer, lights_uniform_buffer, instance_transforms_buffer] :
+       std::views::zip(global_descriptor_pool_.descriptor_sets(),
+                       camera_uniform_buffers_,
+                       lights_uniform_buffers_,
+                       instance_transforms_buffers_)) {
+    UpdateGlobalDescriptorSet(*device_,
+                              global_descriptor_set,
+                              camera_uniform_buffer,
+                              lights_uniform_buffer,
+                              instance_transforms_buffer);
+  }
 
   return scene;
 }
 
+std::optional<Scene::ModelId> Engine::LoadAsync(Scene& scene, const std::filesystem::path& gltf_filepath, Log& log) {
+  if (!IsGltfFile(gltf_filepath, log)) return std::nullopt;
+  return scene.AddAsync([this, gltf_filepath, &log] { return asset_cache_.Load(gltf_filepath, log); }, log);
+}
+
 void Engine::Render(Scene& scene) {
+  const ProfileZone profile_zone{"Engine::Render"};
   assert(current_frame_index_ < kMaxRenderFrames);
   if (++current_frame_index_ == kMaxRenderFrames) current_frame_index_ = 0;
 
@@ -513,40 +689,111 @@ void Engine::Render(Scene& scene) {
   std::tie(result, image_index) = device_->acquireNextImageKHR(*swapchain_, kMaxTimeout, acquire_next_image_semaphore);
   vk::detail::resultCheck(result, "Acquire next swapchain image failed");
 
+  // models are inserted and retired once the render fence guarantees the oldest frame in flight has completed
+  scene.UpdateResidentModels();
+
+  auto& camera_uniform_buffer = camera_uniform_buffers_[current_frame_index_];
+  auto& lights_uniform_buffer = lights_uniform_buffers_[current_frame_index_];
+  auto& instance_transforms_buffer = instance_transforms_buffers_[current_frame_index_];
+  auto& draw_commands_buffer = draw_commands_buffers_[current_frame_index_];
+  const auto global_descriptor_set = global_descriptor_pool_.descriptor_sets()[current_frame_index_];
+
+  // frame-dependent buffers are no longer in use after waiting on the render fence and can be safely replaced when
+  // inserted models no longer fit
+  using enum vk::BufferUsageFlagBits;
+  if (const auto size_bytes = sizeof(glm::mat4) * scene.max_instance_count();
+      instance_transforms_buffer.size_bytes() < size_bytes) {
+    instance_transforms_buffer =
+        CreateHostVisibleBuffer(allocator_, GetBufferCapacity(size_bytes, sizeof(glm::mat4)), eStorageBuffer);
+    UpdateGlobalDescriptorSet(*device_,
+                              global_descriptor_set,
+                              camera_uniform_buffer,
+                              lights_uniform_buffer,
+                              instance_transforms_buffer);
+  }
+  if (const auto size_bytes = sizeof(vk::DrawIndexedIndirectCommand) * scene.max_draw_count();
+      draw_commands_buffer.size_bytes() < size_bytes) {
+    draw_commands_buffer = CreateHostVisibleBuffer(
+        allocator_,
+        GetBufferCapacity(size_bytes, sizeof(vk::DrawIndexedIndirectCommand)),
+        eIndirectBuffer);
+  }
+
+  // secondary command buffers are reset together by resetting their command pools once the frame fence is signaled
+  for (const auto& secondary_command_pool : secondary_command_pools_[current_frame_index_]) {
+    device_->resetCommandPool(*secondary_command_pool);
+  }
+
   const auto& command_buffers = render_command_pool_.command_buffers();
   const auto command_buffer = command_buffers[current_frame_index_];
   command_buffer.begin(vk::CommandBufferBeginInfo{.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
 
+  // timestamps recorded the last time this frame was rendered are available after waiting on the render fence
+  gpu_profiler_.BeginFrame(command_buffer, static_cast<std::uint32_t>(current_frame_index_));
+
   static constexpr std::array kClearColor{0.0f, 0.0f, 0.0f, 0.0f};
   static constexpr std::array kClearValues{
       vk::ClearValue{.color = vk::ClearColorValue{kClearColor}},
       vk::ClearValue{.color = vk::ClearColorValue{kClearColor}},
       vk::ClearValue{.depthStencil = vk::ClearDepthStencilValue{.depth = 1.0f, .stencil = 0}}};
 
+  // a subpass cannot mix inline draw commands with secondary command buffers so the contents are chosen up front
+  const auto& secondary_command_buffers = secondary_command_buffers_[current_frame_index_];
+  const auto subpass_contents = secondary_command_buffers.empty() ? vk::SubpassContents::eInline
+                                                                  : vk::SubpassContents::eSecondaryCommandBuffers;
+  const auto framebuffer = *framebuffers_[image_index];
+
+  const auto render_pass_gpu_zone_index = gpu_profiler_.BeginZone(command_buffer, "RenderPass");
   command_buffer.beginRenderPass(
       vk::RenderPassBeginInfo{
           .renderPass = *render_pass_,
-          .framebuffer = *framebuffers_[image_index],
+          .framebuffer = framebuffer,
           .renderArea = vk::Rect2D{.offset = vk::Offset2D{0, 0}, .extent = swapchain_.image_extent()},
           .clearValueCount = static_cast<std::uint32_t>(kClearValues.size()),
           .pClearValues = kClearValues.data()},
-      vk::SubpassContents::eInline);
-
-  auto& camera_uniform_buffer = camera_uniform_buffers_[current_frame_index_];
-  auto& lights_uniform_buffer = lights_uniform_buffers_[current_frame_index_];
-  scene.Update(camera_uniform_buffer, lights_uniform_buffer);
-
-  const auto& global_descriptor_sets = global_descriptor_pool_.descriptor_sets();
-  scene.Render(command_buffer, global_descriptor_sets[current_frame_index_]);
+      subpass_contents);
+
+  scene.Update(camera_uniform_buffer, lights_uniform_buffer, instance_transforms_buffer, draw_commands_buffer);
+
+  if (secondary_command_buffers.empty()) {
+    scene.Render(command_buffer, global_descriptor_set, *draw_commands_buffer, &gpu_profiler_);
+  } else {
+    const vk::CommandBufferInheritanceInfo inheritance_info{.renderPass = *render_pass_,
+                                                            .subpass = 0,
+                                                            .framebuffer = framebuffer};
+    const auto recorded_command_buffers = scene.Render(secondary_command_buffers,
+                                                       inheritance_info,
+                                                       global_descriptor_set,
+                                                       *draw_commands_buffer,
+                                                       thread_pool_,
+                                                       &gpu_profiler_);
+    if (!recorded_command_buffers.empty()) {
+      command_buffer.executeCommands(recorded_command_buffers);
+    }
+  }
 
   command_buffer.endRenderPass();
+  if (render_pass_gpu_zone_index.has_value()) {
+    gpu_profiler_.EndZone(command_buffer, *render_pass_gpu_zone_index);
+  }
   command_buffer.end();
 
-  static constexpr vk::PipelineStageFlags kPipelineWaitStage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+  // waiting on the scene upload semaphore makes uploaded resources visible to rendering without stalling the queue
+  // because the wait value is only advanced after the host observes it has been signaled
+  using enum vk::PipelineStageFlagBits;
+  static constexpr std::array<vk::PipelineStageFlags, 2> kPipelineWaitStages{eColorAttachmentOutput,
+                                                                            eVertexInput | eFragmentShader};
+  const std::array wait_semaphores{acquire_next_image_semaphore, scene.upload_semaphore()};
+  const std::array<std::uint64_t, 2> wait_semaphore_values{0, scene.upload_semaphore_value()};  // binary values ignored
+  const vk::TimelineSemaphoreSubmitInfo timeline_semaphore_submit_info{
+      .waitSemaphoreValueCount = static_cast<std::uint32_t>(wait_semaphore_values.size()),
+      .pWaitSemaphoreValues = wait_semaphore_values.data()};
+
   const auto present_image_semaphore = *present_image_semaphores_[current_frame_index_];
-  graphics_queue_->submit(vk::SubmitInfo{.waitSemaphoreCount = 1,
-                                         .pWaitSemaphores = &acquire_next_image_semaphore,
-                                         .pWaitDstStageMask = &kPipelineWaitStage,
+  graphics_queue_->submit(vk::SubmitInfo{.pNext = &timeline_semaphore_submit_info,
+                                         .waitSemaphoreCount = static_cast<std::uint32_t>(wait_semaphores.size()),
+                                         .pWaitSemaphores = wait_semaphores.data(),
+                                         .pWaitDstStageMask = kPipelineWaitStages.data(),
                                          .commandBufferCount = 1,
                                          .pCommandBuffers = &command_buffer,
                                          .signalSemaphoreCount = 1,
@@ -1,22 +1,37 @@
 module;
 
+#include <atomic>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <exception>
+#include <filesystem>
 #include <format>
+#include <functional>
+#include <fstream>
+#include <future>
+#include <ios>
 #include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include <glslang/Include/glslang_c_interface.h>
+#include <glslang/build_info.h>
 #include <glslang/Public/resource_limits_c.h>
 
 export module glslang_compiler;
 
+import hash;
 import log;
+import thread_pool;
 
 namespace vktf {
 
@@ -25,17 +40,105 @@ export using SpirvWord = std::uint32_t;
 
 namespace glslang {
 
+/**
+ * @brief A persistent cache of SPIR-V binaries compiled from GLSL shaders.
+ * @details Cached SPIR-V binaries are addressed by a hash of the preprocessed GLSL source code, shader stage, target
+ *          environment, glslang version, and compiler options. Only preprocessing is repeated for shaders that have not
+ *          changed which avoids parsing, linking, and SPIR-V generation while still detecting changes to macros and
+ *          included files.
+ * @note This class is thread-safe and may be used to compile multiple shaders concurrently.
+ */
+export class [[nodiscard]] SpirvCache {
+public:
+  /**
+   * @brief Creates a @ref SpirvCache.
+   * @param cache_directory The directory to write SPIR-V binaries to which is created if it does not exist.
+   */
+  explicit SpirvCache(std::filesystem::path cache_directory) noexcept : cache_directory_{std::move(cache_directory)} {}
+
+  /**
+   * @brief Loads a cached SPIR-V binary.
+   * @param preprocessed_glsl_shader The preprocessed GLSL shader source code.
+   * @param glslang_stage The GLSL shader stage (e.g., vertex, fragment).
+   * @return The cached SPIR-V binary or @c std::nullopt if the shader has not been cached.
+   */
+  [[nodiscard]] std::optional<std::vector<SpirvWord>> Load(std::string_view preprocessed_glsl_shader,
+                                                           glslang_stage_t glslang_stage);
+
+  /**
+   * @brief Writes a SPIR-V binary to the cache.
+   * @details Failing to write a cached SPIR-V binary is not an error and only results in the shader being compiled
+   *          again the next time it is loaded.
+   * @param preprocessed_glsl_shader The preprocessed GLSL shader source code.
+   * @param glslang_stage The GLSL shader stage (e.g., vertex, fragment).
+   * @param spirv_binary The SPIR-V binary compiled from @p preprocessed_glsl_shader.
+   * @param log The log for writing messages when the SPIR-V binary could not be cached.
+   */
+  void Store(std::string_view preprocessed_glsl_shader,
+             glslang_stage_t glslang_stage,
+             std::span<const SpirvWord> spirv_binary,
+             Log& log) const;
+
+  /** @brief Gets the number of SPIR-V binaries loaded from the cache. */
+  [[nodiscard]] std::uint32_t hit_count() const noexcept { return hit_count_.load(std::memory_order_relaxed); }
+
+  /** @brief Gets the number of shaders that were compiled because they were not found in the cache. */
+  [[nodiscard]] std::uint32_t miss_count() const noexcept { return miss_count_.load(std::memory_order_relaxed); }
+
+private:
+  std::filesystem::path cache_directory_;
+  std::atomic<std::uint32_t> hit_count_ = 0;
+  std::atomic<std::uint32_t> miss_count_ = 0;
+};
+
+/** @brief The parameters for compiling a GLSL shader. */
+export struct [[nodiscard]] CompileInfo {
+  /** @brief The GLSL shader source code. */
+  const std::string& glsl_shader;
+
+  /** @brief The GLSL shader stage (e.g., vertex, fragment). */
+  glslang_stage_t glslang_stage{};
+
+  /**
+   * @brief The preprocessor macros to define for this shader permutation.
+   * @details Each macro is specified in the form @c NAME or @c NAME=VALUE and is defined after the @c #version
+   *          directive as if it were declared at the beginning of @ref CompileInfo::glsl_shader.
+   */
+  std::span<const std::string> defines;
+
+  /**
+   * @brief The SPIR-V cache for avoiding recompilation of unchanged shaders.
+   * @note A value of @c nullptr indicates the shader should always be compiled.
+   */
+  SpirvCache* spirv_cache = nullptr;
+
+  /** @brief The log for writing shader compilation messages. */
+  Log& log;
+};
+
 /**
  * @brief Compiles a GLSL shader to a SPIR-V binary.
- * @param glsl_shader The GLSL shader source code.
- * @param glslang_stage The GLSL shader stage (e.g., vertex, fragment).
- * @param log The log for writing shader compilation messages.
+ * @details If @ref CompileInfo::spirv_cache contains a SPIR-V binary for the preprocessed GLSL shader, it is returned
+ *          without parsing, linking, or generating SPIR-V. Otherwise the result is written to the cache.
+ * @param compile_info @copybrief CompileInfo
  * @return A vector of four-byte words representing the SPIR-V binary.
  * @throws std::runtime_error Thrown if shader compilation fails.
  */
-export [[nodiscard]] std::vector<SpirvWord> Compile(const std::string& glsl_shader,
-                                                    glslang_stage_t glslang_stage,
-                                                    Log& log);
+export [[nodiscard]] std::vector<SpirvWord> Compile(const CompileInfo& compile_info);
+
+/**
+ * @brief Compiles multiple GLSL shaders or shader permutations to SPIR-V binaries concurrently.
+ * @details Each shader is compiled in a separate thread pool task with its own glslang shader and program objects while
+ *          sharing process-wide glslang state. Shaders are compiled with the same operations as a single invocation of
+ *          @ref Compile which makes the results identical to compiling each shader serially.
+ * @param compile_infos The shaders to compile.
+ * @param thread_pool The thread pool for compiling shaders concurrently.
+ * @return The SPIR-V binary for each element in @p compile_infos in the same order.
+ * @throws std::runtime_error Thrown if compilation fails for any shader after all compilation tasks have completed.
+ * @warning This function waits on thread pool tasks and must not be called from a worker thread in @p thread_pool.
+ */
+export [[nodiscard]] std::vector<std::vector<SpirvWord>> Compile(std::span<const CompileInfo> compile_infos,
+                                                                 ThreadPool& thread_pool);
 
 }  // namespace glslang
 }  // namespace vktf
@@ -114,6 +217,9 @@ constexpr auto kGlslangMessages =
 #endif
     GLSLANG_MSG_SPV_RULES_BIT | GLSLANG_MSG_VULKAN_RULES_BIT;
 
+constexpr auto kGlslangClientVersion = GLSLANG_TARGET_VULKAN_1_4;
+constexpr auto kGlslangTargetLanguageVersion = GLSLANG_TARGET_SPV_1_6;
+
 template <typename Fn, typename T>
   requires std::same_as<std::invoke_result_t<Fn, T* const>, const char*>
 void Print(Log& log, const Severity severity, Fn glslang_get_message, T* const glslang_element) {
@@ -124,29 +230,47 @@ void Print(Log& log, const Severity severity, Fn glslang_get_message, T* const g
   }
 }
 
-UniqueGlslangShader CreateGlslangShader(const std::string& glsl_shader,
-                                        const glslang_stage_t glslang_stage,
-                                        [[maybe_unused]] Log& log) {
-  const glslang_input_t glslang_input{.language = GLSLANG_SOURCE_GLSL,
-                                      .stage = glslang_stage,
-                                      .client = GLSLANG_CLIENT_VULKAN,
-                                      .client_version = GLSLANG_TARGET_VULKAN_1_4,
-                                      .target_language = GLSLANG_TARGET_SPV,
-                                      .target_language_version = GLSLANG_TARGET_SPV_1_6,
-                                      .code = glsl_shader.c_str(),
-                                      .default_version = 460,
-                                      .default_profile = GLSLANG_NO_PROFILE,
-                                      .force_default_version_and_profile = 0,
-                                      .forward_compatible = 0,
-                                      .messages = static_cast<glslang_messages_t>(kGlslangMessages),
-                                      .resource = glslang_default_resource()};
+glslang_input_t CreateGlslangInput(const std::string& glsl_shader, const glslang_stage_t glslang_stage) {
+  return glslang_input_t{.language = GLSLANG_SOURCE_GLSL,
+                         .stage = glslang_stage,
+                         .client = GLSLANG_CLIENT_VULKAN,
+                         .client_version = kGlslangClientVersion,
+                         .target_language = GLSLANG_TARGET_SPV,
+                         .target_language_version = kGlslangTargetLanguageVersion,
+                         .code = glsl_shader.c_str(),
+                         .default_version = 460,
+                         .default_profile = GLSLANG_NO_PROFILE,
+                         .force_default_version_and_profile = 0,
+                         .forward_compatible = 0,
+                         .messages = static_cast<glslang_messages_t>(kGlslangMessages),
+                         .resource = glslang_default_resource()};
+}
+
+std::string CreatePreamble(const std::span<const std::string> defines) {
+  std::string preamble;
+  for (const std::string_view define : defines) {
+    const auto separator_index = define.find('=');
+    preamble += std::format("#define {} {}\n",
+                            define.substr(0, separator_index),
+                            separator_index == std::string_view::npos ? "" : define.substr(separator_index + 1));
+  }
+  return preamble;
+}
+
+UniqueGlslangShader PreprocessGlslangShader(const glslang_input_t& glslang_input,
+                                            const std::string& preamble,
+                                            [[maybe_unused]] Log& log) {
+  const auto glslang_stage = glslang_input.stage;
 
   auto glslang_shader = UniqueGlslangShader{glslang_shader_create(&glslang_input), glslang_shader_delete};
   if (glslang_shader == nullptr) {
     throw std::runtime_error{
-        std::format("Shader creation failed at {} with GLSL source:\n{}", glslang_stage, glsl_shader)};
+        std::format("Shader creation failed at {} with GLSL source:\n{}", glslang_stage, glslang_input.code)};
   }
 
+  // the preamble is referenced by the shader and must remain valid until the shader is parsed
+  if (!preamble.empty()) glslang_shader_set_preamble(glslang_shader.get(), preamble.c_str());
+
   const auto glslang_shader_preprocess_result = glslang_shader_preprocess(glslang_shader.get(), &glslang_input);
 #ifndef NDEBUG
   Print(log, Severity::kInfo, glslang_shader_get_info_log, glslang_shader.get());
@@ -155,22 +279,26 @@ UniqueGlslangShader CreateGlslangShader(const std::string& glsl_shader,
 
   if (glslang_shader_preprocess_result == 0) {
     throw std::runtime_error{
-        std::format("Shader preprocessing failed at {} with GLSL source:\n{}", glslang_stage, glsl_shader)};
+        std::format("Shader preprocessing failed at {} with GLSL source:\n{}", glslang_stage, glslang_input.code)};
   }
 
-  const auto glslang_shader_parse_result = glslang_shader_parse(glslang_shader.get(), &glslang_input);
+  return glslang_shader;
+}
+
+void ParseGlslangShader(glslang_shader_t& glslang_shader,
+                        const glslang_input_t& glslang_input,
+                        [[maybe_unused]] Log& log) {
+  const auto glslang_shader_parse_result = glslang_shader_parse(&glslang_shader, &glslang_input);
 #ifndef NDEBUG
-  Print(log, Severity::kInfo, glslang_shader_get_info_log, glslang_shader.get());
-  Print(log, Severity::kInfo, glslang_shader_get_info_debug_log, glslang_shader.get());
+  Print(log, Severity::kInfo, glslang_shader_get_info_log, &glslang_shader);
+  Print(log, Severity::kInfo, glslang_shader_get_info_debug_log, &glslang_shader);
 #endif
 
   if (glslang_shader_parse_result == 0) {
     throw std::runtime_error{std::format("Shader parsing failed at {} with GLSL source:\n{}",
-                                         glslang_stage,
-                                         glslang_shader_get_preprocessed_code(glslang_shader.get()))};
+                                         glslang_input.stage,
+                                         glslang_shader_get_preprocessed_code(&glslang_shader))};
   }
-
-  return glslang_shader;
 }
 
 UniqueGlslangProgram CreateGlslangProgram(glslang_shader_t& glslang_shader,
@@ -222,13 +350,143 @@ std::vector<SpirvWord> GenerateSpirvBinary(glslang_program_t& glslang_program,
   return spirv_binary;
 }
 
+// =====================================================================================================================
+// SPIR-V Cache
+// =====================================================================================================================
+
+constexpr std::uint32_t kSpirvCacheVersion = 1;  // increment when compiler options change in a way not captured below
+constexpr SpirvWord kSpirvMagicNumber = 0x07230203;
+constexpr std::size_t kSpirvHeaderWordCount = 5;
+
+struct SpirvCacheKey {
+  std::uint32_t version = kSpirvCacheVersion;
+  std::uint32_t glslang_stage = 0;
+  // code generation may change between glslang releases even when compiler options are identical
+  std::uint32_t glslang_version_major = GLSLANG_VERSION_MAJOR;
+  std::uint32_t glslang_version_minor = GLSLANG_VERSION_MINOR;
+  std::uint32_t glslang_version_patch = GLSLANG_VERSION_PATCH;
+  std::uint32_t glslang_client_version = kGlslangClientVersion;
+  std::uint32_t glslang_target_language_version = kGlslangTargetLanguageVersion;
+  std::uint32_t glslang_messages = kGlslangMessages;
+#ifndef NDEBUG
+  std::uint32_t debug = 1;  // debug builds generate unoptimized SPIR-V binaries with debug info
+#else
+  std::uint32_t debug = 0;
+#endif
+};
+
+std::filesystem::path GetCacheFilepath(const std::filesystem::path& cache_directory,
+                                       const std::string_view preprocessed_glsl_shader,
+                                       const glslang_stage_t glslang_stage) {
+  const SpirvCacheKey spirv_cache_key{.glslang_stage = static_cast<std::uint32_t>(glslang_stage)};
+  const auto spirv_cache_key_hash = Hash(std::as_bytes(std::span{&spirv_cache_key, 1}));
+  const auto glsl_shader_hash = Hash(std::as_bytes(std::span{preprocessed_glsl_shader}), spirv_cache_key_hash);
+  return cache_directory / std::format("{:016x}.spv", glsl_shader_hash);
+}
+
+std::optional<std::vector<SpirvWord>> ReadCachedSpirvBinary(const std::filesystem::path& cache_filepath) {
+  std::ifstream ifstream{cache_filepath, std::ios::ate | std::ios::binary};
+  if (!ifstream) return std::nullopt;
+
+  const auto size_bytes = static_cast<std::size_t>(ifstream.tellg());
+  if (size_bytes < kSpirvHeaderWordCount * sizeof(SpirvWord) || size_bytes % sizeof(SpirvWord) != 0) {
+    return std::nullopt;
+  }
+
+  std::vector<SpirvWord> spirv_binary(size_bytes / sizeof(SpirvWord));
+  ifstream.seekg(0, std::ios::beg);
+  ifstream.read(reinterpret_cast<char*>(spirv_binary.data()), static_cast<std::streamsize>(size_bytes));
+  if (!ifstream || spirv_binary.front() != kSpirvMagicNumber) return std::nullopt;
+  return spirv_binary;
+}
+
+void WriteCachedSpirvBinary(const std::filesystem::path& cache_filepath,
+                            const std::span<const SpirvWord> spirv_binary) {
+  std::filesystem::create_directories(cache_filepath.parent_path());
+
+  // write to a uniquely named temporary file first so that an interrupted write never leaves a partially written cache
+  // file and threads compiling the same shader never write to the same file
+  auto temporary_filepath = cache_filepath;
+  temporary_filepath += std::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+  {
+    std::ofstream ofstream{temporary_filepath, std::ios::binary | std::ios::trunc};
+    const auto spirv_bytes = std::as_bytes(spirv_binary);
+    ofstream.write(reinterpret_cast<const char*>(spirv_bytes.data()), static_cast<std::streamsize>(spirv_bytes.size()));
+    if (!ofstream) throw std::runtime_error{std::format("Failed to write {}", temporary_filepath.string())};
+  }
+  std::filesystem::rename(temporary_filepath, cache_filepath);
+}
+
 }  // namespace
 
-std::vector<SpirvWord> Compile(const std::string& glsl_shader, const glslang_stage_t glslang_stage, Log& log) {
+std::optional<std::vector<SpirvWord>> SpirvCache::Load(const std::string_view preprocessed_glsl_shader,
+                                                       const glslang_stage_t glslang_stage) {
+  auto spirv_binary =
+      ReadCachedSpirvBinary(GetCacheFilepath(cache_directory_, preprocessed_glsl_shader, glslang_stage));
+  (spirv_binary.has_value() ? hit_count_ : miss_count_).fetch_add(1, std::memory_order_relaxed);
+  return spirv_binary;
+}
+
+void SpirvCache::Store(const std::string_view preprocessed_glsl_shader,
+                       const glslang_stage_t glslang_stage,
+                       const std::span<const SpirvWord> spirv_binary,
+                       Log& log) const {
+  const auto cache_filepath = GetCacheFilepath(cache_directory_, preprocessed_glsl_shader, glslang_stage);
+  try {
+    WriteCachedSpirvBinary(cache_filepath, spirv_binary);
+  } catch (const std::exception& exception) {
+    log(Severity::kWarning).Print("Failed to write SPIR-V cache file {} with error {}",
+                                  cache_filepath.string(),
+                                  exception.what());
+  }
+}
+
+std::vector<SpirvWord> Compile(const CompileInfo& compile_info) {
+  const auto& [glsl_shader, glslang_stage, defines, spirv_cache, log] = compile_info;
   [[maybe_unused]] const auto& glslang_process = GlslangProcess::Instance();
-  const auto glslang_shader = CreateGlslangShader(glsl_shader, glslang_stage, log);
+
+  const auto glslang_input = CreateGlslangInput(glsl_shader, glslang_stage);
+  const auto preamble = CreatePreamble(defines);
+  const auto glslang_shader = PreprocessGlslangShader(glslang_input, preamble, log);
+
+  // preprocessed source code includes the preamble and expanded macros which distinguishes shader permutations
+  const std::string_view preprocessed_glsl_shader =
+      spirv_cache == nullptr ? std::string_view{} : glslang_shader_get_preprocessed_code(glslang_shader.get());
+  if (spirv_cache != nullptr) {
+    if (auto spirv_binary = spirv_cache->Load(preprocessed_glsl_shader, glslang_stage); spirv_binary.has_value()) {
+      return std::move(*spirv_binary);
+    }
+  }
+
+  ParseGlslangShader(*glslang_shader, glslang_input, log);
   const auto glslang_program = CreateGlslangProgram(*glslang_shader, glslang_stage, log);
-  return GenerateSpirvBinary(*glslang_program, glslang_stage, log);
+  auto spirv_binary = GenerateSpirvBinary(*glslang_program, glslang_stage, log);
+
+  if (spirv_cache != nullptr) spirv_cache->Store(preprocessed_glsl_shader, glslang_stage, spirv_binary, log);
+  return spirv_binary;
+}
+
+std::vector<std::vector<SpirvWord>> Compile(const std::span<const CompileInfo> compile_infos,
+                                            ThreadPool& thread_pool) {
+  // the glslang process is initialized before submitting tasks to avoid contending on its initialization
+  [[maybe_unused]] const auto& glslang_process = GlslangProcess::Instance();
+  if (compile_infos.size() == 1) return {Compile(compile_infos.front())};
+
+  auto compile_futures =
+      compile_infos
+      | std::views::transform([&thread_pool](const auto& compile_info) {
+          return thread_pool.Submit([&compile_info] { return Compile(compile_info); });
+        })
+      | std::ranges::to<std::vector>();
+
+  // all tasks must complete before an exception is propagated because tasks reference compile infos owned by the caller
+  for (const auto& compile_future : compile_futures) {
+    compile_future.wait();
+  }
+
+  return compile_futures  //
+         | std::views::transform([](auto& compile_future) { return compile_future.get(); })
+         | std::ranges::to<std::vector>();
 }
 
 }  // namespace vktf::glslang
@@ -1,10 +1,16 @@
 module;
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <format>
+#include <future>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <ranges>
@@ -27,6 +33,9 @@ export module gltf_asset;
 
 import bounding_box;
 import log;
+import mapped_file;
+import profiler;
+import thread_pool;
 
 namespace vktf::gltf {
 
@@ -62,6 +71,15 @@ export struct [[nodiscard]] Texture {
   /** @brief The filepath to the texture image data. */
   std::optional<std::filesystem::path> filepath;
 
+  /**
+   * @brief The texture image data when the image is embedded in a glTF buffer (e.g., the binary glTF BIN chunk).
+   * @details This data references glTF buffer data whose lifetime is managed by @ref Asset::buffer_data.
+   */
+  std::span<const std::byte> image_data;
+
+  /** @brief The media type of @ref image_data (e.g., "image/ktx2"). */
+  std::optional<std::string> mime_type;
+
   /** @brief A non-owning pointer to the texture sampler. */
   const Sampler* sampler = nullptr;
 };
@@ -117,6 +135,59 @@ export struct [[nodiscard]] Material {
 /** @brief A type alias for a @c unique_ptr that manages the lifetime of a @ref Material. */
 export using UniqueMaterial = std::unique_ptr<const Material>;
 
+/**
+ * @brief A contiguous sequence of glTF attribute values.
+ * @details Attribute values are either owned by this object or reference memory-mapped glTF buffer data whose lifetime
+ *          is managed by the @ref Asset containing the attribute.
+ * @tparam T The attribute value type.
+ */
+export template <typename T>
+class [[nodiscard]] AttributeData {
+public:
+  /** @brief Creates an empty @ref AttributeData. */
+  AttributeData() noexcept = default;
+
+  /**
+   * @brief Creates an @ref AttributeData that owns its attribute values.
+   * @param values The attribute values.
+   */
+  explicit AttributeData(std::vector<T> values) noexcept : owned_values_{std::move(values)}, values_{owned_values_} {}
+
+  /**
+   * @brief Creates an @ref AttributeData that references externally owned attribute values.
+   * @param values A view of the attribute values.
+   * @warning The caller is responsible for ensuring @p values outlives this object.
+   */
+  explicit AttributeData(const std::span<const T> values) noexcept : values_{values} {}
+
+  AttributeData(const AttributeData&) = delete;
+  AttributeData(AttributeData&&) noexcept = default;  // moving a vector preserves the address of its elements
+
+  AttributeData& operator=(const AttributeData&) = delete;
+  AttributeData& operator=(AttributeData&&) noexcept = default;
+
+  ~AttributeData() noexcept = default;
+
+  /** @brief Gets a view of the attribute values. */
+  [[nodiscard]] std::span<const T> values() const noexcept { return values_; }
+
+  /** @brief Gets a pointer to the first attribute value. */
+  [[nodiscard]] const T* data() const noexcept { return values_.data(); }
+
+  /** @brief Gets the number of attribute values. */
+  [[nodiscard]] std::size_t size() const noexcept { return values_.size(); }
+
+  /** @brief Gets an iterator to the first attribute value. */
+  [[nodiscard]] auto begin() const noexcept { return values_.begin(); }
+
+  /** @brief Gets an iterator past the last attribute value. */
+  [[nodiscard]] auto end() const noexcept { return values_.end(); }
+
+private:
+  std::vector<T> owned_values_;
+  std::span<const T> values_;
+};
+
 /** @brief A structure representing glTF attributes for a mesh primitive. */
 export struct [[nodiscard]] Attributes {
   /** @brief A structure representing the position glTF attribute. */
@@ -124,8 +195,8 @@ export struct [[nodiscard]] Attributes {
     /** @brief The name for the position glTF attribute. */
     static constexpr std::string_view kName = "POSITION";
 
-    /** @brief A type alias for a vector of 3D positions. */
-    using Data = std::vector<glm::vec3>;
+    /** @brief A type alias for a sequence of 3D positions. */
+    using Data = AttributeData<glm::vec3>;
 
     /** @brief The position attribute data. */
     Data data;
@@ -139,8 +210,8 @@ export struct [[nodiscard]] Attributes {
     /** @brief The name for the normal glTF attribute. */
     static constexpr std::string_view kName = "NORMAL";
 
-    /** @brief A type alias for a vector of 3D normals. */
-    using Data = std::vector<glm::vec3>;
+    /** @brief A type alias for a sequence of 3D normals. */
+    using Data = AttributeData<glm::vec3>;
 
     /** @brief The normal attribute data. */
     std::optional<Data> data;
@@ -152,10 +223,10 @@ export struct [[nodiscard]] Attributes {
     static constexpr std::string_view kName = "TANGENT";
 
     /**
-     * @brief A type alias for a vector of 4D tangents.
+     * @brief A type alias for a sequence of 4D tangents.
      * @details The w-component indicates the signed handedness of the tangent basis vector.
      */
-    using Data = std::vector<glm::vec4>;
+    using Data = AttributeData<glm::vec4>;
 
     /** @brief The tangent attribute data. */
     std::optional<Data> data;
@@ -166,8 +237,8 @@ export struct [[nodiscard]] Attributes {
     /** @brief The name for the first texture coordinates set glTF attribute. */
     static constexpr std::string_view kName = "TEXCOORD_0";
 
-    /** @brief A type alias for a vector of 2D texture coordinates. */
-    using Data = std::vector<glm::vec2>;
+    /** @brief A type alias for a sequence of 2D texture coordinates. */
+    using Data = AttributeData<glm::vec2>;
 
     /** @brief The first texture coordinates set attribute data. */
     std::optional<Data> data;
@@ -300,18 +371,52 @@ export struct [[nodiscard]] Asset {
 
   /** @brief A non-owning pointer to the default glTF scene. */
   const Scene* default_scene = nullptr;
+
+  /** @brief The filepaths of external buffer and image files referenced by the glTF asset. */
+  std::vector<std::filesystem::path> dependencies;
+
+  /**
+   * @brief The glTF buffer data referenced by mesh primitive attributes and embedded texture images.
+   * @details This is only assigned when glTF buffers are memory-mapped or textures embed image data and must outlive
+   *          all attribute data in @ref meshes and image data in @ref textures which is guaranteed by the lifetime of
+   *          this asset.
+   */
+  std::shared_ptr<const void> buffer_data;
+};
+
+/** @brief The options for loading a glTF asset. */
+export struct [[nodiscard]] LoadOptions {
+  /**
+   * @brief Indicates if glTF buffers should be memory-mapped instead of being read into heap allocations.
+   * @details When enabled, tightly packed floating-point attribute accessors reference the memory-mapped buffer data
+   *          directly which avoids intermediate copies and reduces peak memory usage when loading large assets.
+   */
+  bool map_buffers = true;
+
+  /**
+   * @brief The thread pool for decoding glTF meshes concurrently.
+   * @details The calling thread decodes meshes alongside thread pool workers. A value of @c nullptr decodes meshes
+   *          serially on the calling thread. The loaded asset is identical with or without a thread pool.
+   * @warning @ref Load waits on thread pool tasks and must not be called from a worker thread in this thread pool.
+   */
+  ThreadPool* thread_pool = nullptr;
 };
 
 /**
  * @brief Loads a glTF file.
- * @details This function parses a glTF 2.0 file to create an in-memory representation of a glTF asset.
+ * @details This function parses a glTF 2.0 file to create an in-memory representation of a glTF asset. Both JSON
+ *          (.gltf) and binary (.glb) glTF files are supported. Binary glTF files are read with a single file access
+ *          and their BIN chunk is used directly as the glTF buffer without opening additional buffer files.
  * @param gltf_filepath The filepath of the glTF asset to load.
  * @param log The log for writing messages when loading a glTF file.
+ * @param load_options @copybrief LoadOptions
  * @return An in-memory representation of a glTF asset loaded from @ref gltf_filepath.
  * @throws std::runtime_error Thrown if the glTF asset at @ref gltf_filepath is invalid or unsupported.
  * @see https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html glTF 2.0 Specification
  */
-export [[nodiscard]] Asset Load(const std::filesystem::path& gltf_filepath, Log& log);
+export [[nodiscard]] Asset Load(const std::filesystem::path& gltf_filepath,
+                                Log& log,
+                                const LoadOptions& load_options = {});
 
 }  // namespace vktf::gltf
 
@@ -437,6 +542,61 @@ std::vector<std::unique_ptr<Value>> GetValues(CgltfResourceMap<Key, Value>&& cgl
   return values;
 }
 
+template <typename Fn>
+  requires std::invocable<Fn&, std::size_t>
+void ParallelFor(const std::size_t count, ThreadPool* const thread_pool, Fn&& fn) {
+  // the calling thread participates as a worker so at most one task is submitted for each thread pool worker
+  const auto worker_count = thread_pool == nullptr ? 1uz : std::min(count, thread_pool->thread_count() + 1);
+
+  if (worker_count <= 1) {
+    for (auto index = 0uz; index < count; ++index) {
+      fn(index);
+    }
+    return;
+  }
+
+  struct WorkerError {
+    std::size_t index = std::numeric_limits<std::size_t>::max();
+    std::exception_ptr exception;
+  };
+
+  std::atomic next_index{0uz};
+  std::vector<WorkerError> worker_errors(worker_count);
+
+  const auto work = [&fn, &next_index, count](WorkerError& worker_error) {
+    for (auto index = next_index.fetch_add(1, std::memory_order_relaxed); index < count;
+         index = next_index.fetch_add(1, std::memory_order_relaxed)) {
+      try {
+        fn(index);
+      } catch (...) {
+        worker_error = WorkerError{.index = index, .exception = std::current_exception()};
+        next_index.store(count, std::memory_order_relaxed);  // stop claiming new work after the first failure
+        return;
+      }
+    }
+  };
+
+  const auto work_futures =
+      worker_errors  //
+      | std::views::drop(1)
+      | std::views::transform([thread_pool, &work](auto& worker_error) {
+          return thread_pool->Submit([&work, &worker_error] { work(worker_error); });
+        })
+      | std::ranges::to<std::vector>();
+
+  work(worker_errors.front());  // the calling thread participates as the first worker
+
+  // tasks reference worker errors owned by this function and must complete before it returns
+  for (const auto& work_future : work_futures) {
+    work_future.wait();
+  }
+
+  // indices are claimed in increasing order so the lowest failed index matches the error reported by a serial loop
+  if (const auto& worker_error = std::ranges::min(worker_errors, {}, &WorkerError::index); worker_error.exception) {
+    std::rethrow_exception(worker_error.exception);
+  }
+}
+
 template <typename T>
   requires std::convertible_to<decltype(T::name), const char*>
 std::optional<std::string> GetName(const T& cgltf_element) {
@@ -454,12 +614,61 @@ std::string GetNameOrDefault(const T& cgltf_element) {
 // =====================================================================================================================
 
 using UniqueCgltfData = std::unique_ptr<cgltf_data, decltype(&cgltf_free)>;
+using MappedFiles = std::unordered_map<const void*, MappedFile>;
 
-UniqueCgltfData LoadGltfFile(const std::string& gltf_filepath) {
-  static constexpr cgltf_options kDefaultOptions{};
+struct GltfData {
+  MappedFiles mapped_files;  // must be declared first to outlive cgltf data which releases files on destruction
   UniqueCgltfData cgltf_data{nullptr, cgltf_free};
+};
+
+cgltf_result ReadMappedFile(const cgltf_memory_options* /*memory_options*/,
+                            const cgltf_file_options* const file_options,
+                            const char* const path,
+                            cgltf_size* const size,
+                            void** const data) {
+  assert(file_options != nullptr && file_options->user_data != nullptr);
+  auto& mapped_files = *static_cast<MappedFiles*>(file_options->user_data);
+
+  try {
+    MappedFile mapped_file{path};
+    const auto mapped_data = mapped_file.data();
+    if (mapped_data.empty()) return cgltf_result_data_too_short;
+
+    *size = mapped_data.size();
+    *data = const_cast<std::byte*>(mapped_data.data());  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    mapped_files.emplace(mapped_data.data(), std::move(mapped_file));
+    return cgltf_result_success;
+
+  } catch (const std::runtime_error&) {
+    return cgltf_result_file_not_found;
+  }
+}
+
+// newer cgltf versions pass the size of released data as an additional argument which is unused when unmapping files
+constexpr auto kReleaseMappedFile = [](const cgltf_memory_options* /*memory_options*/,
+                                       const cgltf_file_options* const file_options,
+                                       void* const data,
+                                       const auto... /*size*/) noexcept {
+  assert(file_options != nullptr && file_options->user_data != nullptr);
+  static_cast<MappedFiles*>(file_options->user_data)->erase(data);
+};
+
+cgltf_options CreateCgltfOptions(GltfData& gltf_data, const LoadOptions& load_options) {
+  cgltf_options cgltf_options{};
+  if (load_options.map_buffers) {
+    cgltf_options.file.read = ReadMappedFile;
+    cgltf_options.file.release = kReleaseMappedFile;
+    cgltf_options.file.user_data = &gltf_data.mapped_files;
+  }
+  return cgltf_options;
+}
+
+std::shared_ptr<const GltfData> LoadGltfFile(const std::string& gltf_filepath, const LoadOptions& load_options) {
+  auto gltf_data = std::make_shared<GltfData>();
+  auto& cgltf_data = gltf_data->cgltf_data;
+  const auto cgltf_options = CreateCgltfOptions(*gltf_data, load_options);
 
-  if (const auto cgltf_result = cgltf_parse_file(&kDefaultOptions, gltf_filepath.c_str(), std::out_ptr(cgltf_data));
+  if (const auto cgltf_result = cgltf_parse_file(&cgltf_options, gltf_filepath.c_str(), std::out_ptr(cgltf_data));
       cgltf_result != cgltf_result_success) {
     throw std::runtime_error{std::format("Failed to parse {} with error {}", gltf_filepath, cgltf_result)};
   }
@@ -468,12 +677,12 @@ UniqueCgltfData LoadGltfFile(const std::string& gltf_filepath) {
     throw std::runtime_error{std::format("Failed to validate {} with error {}", gltf_filepath, cgltf_result)};
   }
 #endif
-  if (const auto cgltf_result = cgltf_load_buffers(&kDefaultOptions, cgltf_data.get(), gltf_filepath.c_str());
+  if (const auto cgltf_result = cgltf_load_buffers(&cgltf_options, cgltf_data.get(), gltf_filepath.c_str());
       cgltf_result != cgltf_result_success) {
     throw std::runtime_error{std::format("Failed to load buffers for {} with error {}", gltf_filepath, cgltf_result)};
   }
 
-  return cgltf_data;
+  return gltf_data;
 }
 
 // =====================================================================================================================
@@ -577,9 +786,12 @@ CgltfResourceMap<cgltf_sampler, const Sampler> CreateSamplers(const std::span<co
 // Textures
 // =====================================================================================================================
 
-std::optional<std::filesystem::path> GetImageUri(const cgltf_texture& cgltf_texture,
+const cgltf_image* GetImage(const cgltf_texture& cgltf_texture) {
+  return cgltf_texture.has_basisu == 0 ? cgltf_texture.image : cgltf_texture.basisu_image;
+}
+
+std::optional<std::filesystem::path> GetImageUri(const cgltf_image* const cgltf_image,
                                                  const std::filesystem::path& gltf_directory) {
-  const auto* const cgltf_image = cgltf_texture.has_basisu == 0 ? cgltf_texture.image : cgltf_texture.basisu_image;
   if (cgltf_image == nullptr) return std::nullopt;
 
   const std::filesystem::path cgltf_image_uri = cgltf_image->uri == nullptr ? "" : cgltf_image->uri;
@@ -588,6 +800,21 @@ std::optional<std::filesystem::path> GetImageUri(const cgltf_texture& cgltf_text
   return gltf_directory / cgltf_image_uri;
 }
 
+std::span<const std::byte> GetImageData(const cgltf_image* const cgltf_image) {
+  if (cgltf_image == nullptr || cgltf_image->buffer_view == nullptr) return {};
+
+  // binary glTF files typically embed images in the BIN chunk which is accessed directly without an additional copy
+  const auto* const image_data = cgltf_buffer_view_data(cgltf_image->buffer_view);
+  if (image_data == nullptr) return {};
+
+  return std::as_bytes(std::span{image_data, cgltf_image->buffer_view->size});
+}
+
+std::optional<std::string> GetMimeType(const cgltf_image* const cgltf_image) {
+  if (cgltf_image == nullptr || cgltf_image->mime_type == nullptr) return std::nullopt;
+  return cgltf_image->mime_type;
+}
+
 UniqueTexture CreateTexture(const cgltf_texture& cgltf_texture,
                             const std::filesystem::path& gltf_directory,
                             const CgltfResourceMap<cgltf_sampler, const Sampler>& samplers) {
@@ -597,7 +824,13 @@ UniqueTexture CreateTexture(const cgltf_texture& cgltf_texture,
     sampler = &kDefaultSampler;
   }
 
-  return std::make_unique<const Texture>(GetName(cgltf_texture), GetImageUri(cgltf_texture, gltf_directory), sampler);
+  const auto* const cgltf_image = GetImage(cgltf_texture);
+
+  return std::make_unique<const Texture>(GetName(cgltf_texture),
+                                         GetImageUri(cgltf_image, gltf_directory),
+                                         GetImageData(cgltf_image),
+                                         GetMimeType(cgltf_image),
+                                         sampler);
 }
 
 CgltfResourceMap<cgltf_texture, const Texture> CreateTextures(
@@ -657,29 +890,51 @@ CgltfResourceMap<cgltf_material, const Material> CreateMaterials(
 // Meshes
 // =====================================================================================================================
 
-template <typename T, glm::length_t N>
-  requires std::constructible_from<glm::vec<N, T>>
-using AttributeData = std::vector<glm::vec<N, T>>;
+template <typename T>
+std::optional<std::span<const T>> GetPackedFloats(const cgltf_accessor& cgltf_accessor) {
+  if constexpr (sizeof(T) != T::length() * sizeof(float)) {
+    return std::nullopt;  // aligned vector types cannot alias tightly packed buffer data
+  } else {
+    if (cgltf_accessor.component_type != cgltf_component_type_r_32f || cgltf_accessor.normalized != 0
+        || cgltf_accessor.is_sparse != 0 || cgltf_accessor.stride != sizeof(T)
+        || cgltf_accessor.buffer_view == nullptr) {
+      return std::nullopt;  // accessor data must be converted to unpack floats
+    }
+    const auto* const buffer_view_data = cgltf_buffer_view_data(cgltf_accessor.buffer_view);
+    if (buffer_view_data == nullptr) return std::nullopt;
+
+    const auto* const accessor_data = buffer_view_data + cgltf_accessor.offset;
+    if (reinterpret_cast<std::uintptr_t>(accessor_data) % alignof(T) != 0) return std::nullopt;
+
+    return std::span{reinterpret_cast<const T*>(accessor_data), cgltf_accessor.count};
+  }
+}
 
-template <glm::length_t N>
-AttributeData<float, N> UnpackFloats(const cgltf_accessor& cgltf_accessor) {
-  if (const auto component_count = cgltf_num_components(cgltf_accessor.type); component_count != N) {
+template <typename T>
+AttributeData<T> UnpackFloats(const cgltf_accessor& cgltf_accessor, const LoadOptions& load_options) {
+  if (const auto component_count = cgltf_num_components(cgltf_accessor.type); component_count != T::length()) {
     throw std::runtime_error{std::format("Invalid glTF primitive attribute {} with bad component count {}",
                                          GetNameOrDefault(cgltf_accessor),
                                          component_count)};
   }
-  AttributeData<float, N> attribute_data(cgltf_accessor.count);
-  if (const auto float_count = N * cgltf_accessor.count;
-      cgltf_accessor_unpack_floats(&cgltf_accessor, glm::value_ptr(attribute_data.front()), float_count) == 0) {
+  if (load_options.map_buffers) {
+    if (const auto packed_floats = GetPackedFloats<T>(cgltf_accessor); packed_floats.has_value()) {
+      return AttributeData<T>{*packed_floats};  // reference memory-mapped buffer data to avoid an intermediate copy
+    }
+  }
+  std::vector<T> attribute_values(cgltf_accessor.count);
+  if (const auto float_count = T::length() * cgltf_accessor.count;
+      cgltf_accessor_unpack_floats(&cgltf_accessor, glm::value_ptr(attribute_values.front()), float_count) == 0) {
     throw std::runtime_error{std::format("Failed to unpack floats for accessor {}", GetNameOrDefault(cgltf_accessor))};
   }
-  return attribute_data;
+  return AttributeData<T>{std::move(attribute_values)};
 }
 
-template <glm::length_t N>
+template <typename T>
 bool TryUnpackFloats(const cgltf_attribute& cgltf_attribute,
                      const std::string_view attribute_name,
-                     std::optional<AttributeData<float, N>>& attribute_data) {
+                     const LoadOptions& load_options,
+                     std::optional<AttributeData<T>>& attribute_data) {
   if (const auto cgltf_attribute_name = GetName(cgltf_attribute);
       !cgltf_attribute_name.has_value() || attribute_name != *cgltf_attribute_name) {
     // attribute sets share the same attribute type so their name must be checked to ensure data is unpacked correctly
@@ -690,12 +945,13 @@ bool TryUnpackFloats(const cgltf_attribute& cgltf_attribute,
     throw std::runtime_error{std::format("Duplicate glTF primitive attribute {}", attribute_name)};
   }
   assert(cgltf_attribute.data != nullptr);  // assume valid cgltf accessor pointer
-  attribute_data = UnpackFloats<N>(*cgltf_attribute.data);
+  attribute_data = UnpackFloats<T>(*cgltf_attribute.data, load_options);
   return true;
 }
 
-template <typename AttributeData>
-void ValidateOptionalAttribute(const std::size_t position_count, const std::optional<AttributeData>& attribute_data) {
+template <typename T>
+void ValidateOptionalAttribute(const std::size_t position_count,
+                               const std::optional<AttributeData<T>>& attribute_data) {
   if (attribute_data.has_value() && position_count != attribute_data->size()) {
     // the glTF specification requires all primitive attributes to have the same accessor count
     throw std::runtime_error{
@@ -703,13 +959,15 @@ void ValidateOptionalAttribute(const std::size_t position_count, const std::opti
   }
 }
 
-template <typename... AttributeData>
+template <typename... T>
 void ValidateOptionalAttributes(const std::size_t position_count,
-                                const std::optional<AttributeData>&... attribute_data) {
+                                const std::optional<AttributeData<T>>&... attribute_data) {
   (ValidateOptionalAttribute(position_count, attribute_data), ...);
 }
 
-std::optional<Attributes> CreateAttributes(const std::span<const cgltf_attribute> cgltf_attributes, Log& log) {
+std::optional<Attributes> CreateAttributes(const std::span<const cgltf_attribute> cgltf_attributes,
+                                           const LoadOptions& load_options,
+                                           Log& log) {
   using Position = Attributes::Position;
   std::optional<Position::Data> position_data;
   BoundingBox bounding_box;
@@ -726,7 +984,7 @@ std::optional<Attributes> CreateAttributes(const std::span<const cgltf_attribute
   for (const auto& cgltf_attribute : cgltf_attributes) {
     switch (cgltf_attribute.type) {
       case cgltf_attribute_type_position:
-        if (TryUnpackFloats(cgltf_attribute, Position::kName, position_data)) {
+        if (TryUnpackFloats(cgltf_attribute, Position::kName, load_options, position_data)) {
           // the glTF specification requires the min/max properties to be defined for the position attribute accessor
           const auto& position_accessor = *cgltf_attribute.data;
           bounding_box.min = glm::make_vec3(position_accessor.min);
@@ -735,17 +993,17 @@ std::optional<Attributes> CreateAttributes(const std::span<const cgltf_attribute
         }
         break;
       case cgltf_attribute_type_normal:
-        if (TryUnpackFloats(cgltf_attribute, Normal::kName, normal_data)) {
+        if (TryUnpackFloats(cgltf_attribute, Normal::kName, load_options, normal_data)) {
           continue;
         }
         break;
       case cgltf_attribute_type_tangent:
-        if (TryUnpackFloats(cgltf_attribute, Tangent::kName, tangent_data)) {
+        if (TryUnpackFloats(cgltf_attribute, Tangent::kName, load_options, tangent_data)) {
           continue;
         }
         break;
       case cgltf_attribute_type_texcoord:
-        if (TryUnpackFloats(cgltf_attribute, TexCoord0::kName, texcoord_0_data)) {
+        if (TryUnpackFloats(cgltf_attribute, TexCoord0::kName, load_options, texcoord_0_data)) {
           continue;
         }
         break;
@@ -753,7 +1011,7 @@ std::optional<Attributes> CreateAttributes(const std::span<const cgltf_attribute
         break;
     }
     // TODO: add support for at least two texture coordinate sets, one vertex color, and one joints/weights set
-    log(Severity::kError) << std::format("Unsupported primitive attribute {}", GetNameOrDefault(cgltf_attribute));
+    log(Severity::kError).Print("Unsupported primitive attribute {}", GetNameOrDefault(cgltf_attribute));
   }
 
   return position_data.transform(
@@ -798,6 +1056,7 @@ std::optional<Primitive::Indices> CreateIndices(const cgltf_accessor* const cglt
 
 UniqueMesh CreateMesh(const cgltf_mesh& cgltf_mesh,
                       const CgltfResourceMap<cgltf_material, const Material>& materials,
+                      const LoadOptions& load_options,
                       Log& log) {
   std::vector<Primitive> primitives;
   primitives.reserve(cgltf_mesh.primitives_count);
@@ -805,18 +1064,19 @@ UniqueMesh CreateMesh(const cgltf_mesh& cgltf_mesh,
   for (const auto& [index, cgltf_primitive] :
        std::span{cgltf_mesh.primitives, cgltf_mesh.primitives_count} | std::views::enumerate) {
     if (cgltf_primitive.type != cgltf_primitive_type_triangles) {
-      log(Severity::kError) << std::format("Failed to create mesh primitive {}[{}] with unsupported type {}",
-                                           GetNameOrDefault(cgltf_mesh),
-                                           index,
-                                           cgltf_primitive.type);
+      log(Severity::kError).Print("Failed to create mesh primitive {}[{}] with unsupported type {}",
+                                  GetNameOrDefault(cgltf_mesh),
+                                  index,
+                                  cgltf_primitive.type);
       continue;  // TODO: add support for other primitive types
     }
 
-    auto attributes = CreateAttributes(std::span{cgltf_primitive.attributes, cgltf_primitive.attributes_count}, log);
+    const std::span cgltf_attributes{cgltf_primitive.attributes, cgltf_primitive.attributes_count};
+    auto attributes = CreateAttributes(cgltf_attributes, load_options, log);
     if (!attributes.has_value()) {
-      log(Severity::kError) << std::format("Failed to create mesh primitive {}[{}] with missing position attribute",
-                                           GetNameOrDefault(cgltf_mesh),
-                                           index);
+      log(Severity::kError).Print("Failed to create mesh primitive {}[{}] with missing position attribute",
+                                  GetNameOrDefault(cgltf_mesh),
+                                  index);
       continue;  // skip mesh primitive with missing position attribute
     }
 
@@ -831,10 +1091,20 @@ UniqueMesh CreateMesh(const cgltf_mesh& cgltf_mesh,
 
 CgltfResourceMap<cgltf_mesh, const Mesh> CreateMeshes(const std::span<const cgltf_mesh>& cgltf_meshes,
                                                       const CgltfResourceMap<cgltf_material, const Material>& materials,
+                                                      const LoadOptions& load_options,
                                                       Log& log) {
-  return cgltf_meshes  //
-         | std::views::transform([&materials, &log](const auto& cgltf_mesh) {
-             return std::pair{&cgltf_mesh, CreateMesh(cgltf_mesh, materials, log)};
+  // meshes are independent of one another which allows them to be decoded concurrently
+  std::vector<UniqueMesh> meshes(cgltf_meshes.size());
+  ParallelFor(cgltf_meshes.size(),
+              load_options.thread_pool,
+              [&meshes, &cgltf_meshes, &materials, &load_options, &log](const auto index) {
+                meshes[index] = CreateMesh(cgltf_meshes[index], materials, load_options, log);
+              });
+
+  return std::views::zip(cgltf_meshes, meshes)  //
+         | std::views::transform([](auto&& zipped_values) {
+             auto& [cgltf_mesh, mesh] = zipped_values;
+             return std::pair{&cgltf_mesh, std::move(mesh)};
            })
          | std::ranges::to<std::unordered_map>();
 }
@@ -850,9 +1120,9 @@ std::optional<Light::Type> GetLightType(const cgltf_light& cgltf_light, Log& log
     case cgltf_light_type_point:
       return Light::Type::kPoint;
     default:
-      log(Severity::kError) << std::format("Failed to create light {} with unsupported type {}",
-                                           GetNameOrDefault(cgltf_light),
-                                           cgltf_light.type);
+      log(Severity::kError).Print("Failed to create light {} with unsupported type {}",
+                                  GetNameOrDefault(cgltf_light),
+                                  cgltf_light.type);
       return std::nullopt;  // TODO: add support for other light types
   }
 }
@@ -942,10 +1212,39 @@ CgltfResourceMap<cgltf_scene, const Scene> CreateScenes(const std::span<const cg
          | std::ranges::to<std::unordered_map>();
 }
 
+// =====================================================================================================================
+// Dependencies
+// =====================================================================================================================
+
+bool IsExternalUri(const char* const cgltf_uri) {
+  static constexpr std::string_view kDataUriPrefix = "data:";
+  return cgltf_uri != nullptr && !std::string_view{cgltf_uri}.starts_with(kDataUriPrefix);
+}
+
+std::vector<std::filesystem::path> GetDependencies(const cgltf_data& cgltf_data,
+                                                   const std::filesystem::path& gltf_directory) {
+  std::vector<std::filesystem::path> dependencies;
+
+  for (const auto& cgltf_buffer : std::span{cgltf_data.buffers, cgltf_data.buffers_count}) {
+    if (IsExternalUri(cgltf_buffer.uri)) {
+      dependencies.push_back(gltf_directory / cgltf_buffer.uri);
+    }
+  }
+  for (const auto& cgltf_image : std::span{cgltf_data.images, cgltf_data.images_count}) {
+    if (IsExternalUri(cgltf_image.uri)) {
+      dependencies.push_back(gltf_directory / cgltf_image.uri);
+    }
+  }
+
+  return dependencies;
+}
+
 }  // namespace
 
-Asset Load(const std::filesystem::path& gltf_filepath, Log& log) {
-  const auto cgltf_data = LoadGltfFile(gltf_filepath.string());
+Asset Load(const std::filesystem::path& gltf_filepath, Log& log, const LoadOptions& load_options) {
+  const ProfileZone profile_zone{"gltf::Load"};
+  auto gltf_data = LoadGltfFile(gltf_filepath.string(), load_options);
+  const auto& cgltf_data = gltf_data->cgltf_data;
 
   const std::span cgltf_samplers{cgltf_data->samplers, cgltf_data->samplers_count};
   auto samplers = CreateSamplers(cgltf_samplers);
@@ -957,7 +1256,7 @@ Asset Load(const std::filesystem::path& gltf_filepath, Log& log) {
   auto materials = CreateMaterials(cgltf_materials, textures);
 
   const std::span cgltf_meshes{cgltf_data->meshes, cgltf_data->meshes_count};
-  auto meshes = CreateMeshes(cgltf_meshes, materials, log);
+  auto meshes = CreateMeshes(cgltf_meshes, materials, load_options, log);
 
   const std::span cgltf_lights{cgltf_data->lights, cgltf_data->lights_count};
   auto lights = CreateLights(cgltf_lights, log);
@@ -969,6 +1268,8 @@ Asset Load(const std::filesystem::path& gltf_filepath, Log& log) {
   auto scenes = CreateScenes(cgltf_scenes, nodes);
 
   const auto* const default_scene = Get(cgltf_data->scene, scenes);
+  const auto has_image_data = std::ranges::any_of(textures | std::views::values,
+                                                  [](const auto& texture) { return !texture->image_data.empty(); });
 
   return Asset{.name = gltf_filepath.filename().string(),
                .samplers = GetValues(std::move(samplers)),
@@ -978,7 +1279,10 @@ Asset Load(const std::filesystem::path& gltf_filepath, Log& log) {
                .lights = GetValues(std::move(lights)),
                .nodes = GetValues(std::move(nodes)),
                .scenes = GetValues(std::move(scenes)),
-               .default_scene = default_scene};
+               .default_scene = default_scene,
+               .dependencies = GetDependencies(*cgltf_data, gltf_filepath.parent_path()),
+               // glTF buffers only need to be retained when they are referenced by attribute or image data
+               .buffer_data = load_options.map_buffers || has_image_data ? std::move(gltf_data) : nullptr};
 }
 
 }  // namespace vktf::gltf
@@ -0,0 +1,349 @@
+module;
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+export module gpu_profiler;
+
+namespace vktf {
+
+/**
+ * @brief A GPU profiler that measures the execution time of command buffer regions with timestamp queries.
+ * @details Each frame in flight owns a timestamp query pool which is reset when the frame begins recording and read
+ *          back the next time the same frame begins after its render fence is signaled. This avoids stalling the CPU
+ *          while the GPU executes the frame. Zones with the same name and ID recorded in a frame are summed and
+ *          averaged over a rolling window of recent frames. When the queue family does not support timestamps,
+ *          recording zones has no effect.
+ * @code
+ * gpu_profiler.BeginFrame(command_buffer, frame_index);  // after waiting on the frame fence
+ * {
+ *   const GpuProfileZone gpu_profile_zone{&gpu_profiler, command_buffer, "Work"};
+ *   // ...
+ * }
+ * for (const auto& [name, id, average_milliseconds, frame_count] : gpu_profiler.GetAverageTimings()) {
+ *   // ...
+ * }
+ * @endcode
+ * @see https://registry.khronos.org/vulkan/specs/latest/man/html/vkCmdWriteTimestamp.html vkCmdWriteTimestamp
+ */
+export class [[nodiscard]] GpuProfiler {
+public:
+  /** @brief The parameters for creating a @ref GpuProfiler. */
+  struct [[nodiscard]] CreateInfo {
+    /** @brief The physical device for querying timestamp support and resolution. */
+    vk::PhysicalDevice physical_device;
+
+    /** @brief The index of the queue family that command buffers containing zones are submitted to. */
+    std::uint32_t queue_family_index = 0;
+
+    /** @brief The maximum number of frames in flight which determines the number of query pools to rotate between. */
+    std::uint32_t max_render_frames = 0;
+
+    /** @brief The maximum number of zones recorded in each frame. Additional zones in the same frame are ignored. */
+    std::uint32_t max_frame_zone_count = 256;
+
+    /** @brief The number of most recent frames containing a zone used to compute its average timing. */
+    std::uint32_t average_frame_count = 64;
+  };
+
+  /** @brief A structure representing the average GPU execution time of a zone. */
+  struct [[nodiscard]] ZoneTiming {
+    /** @brief The zone name. */
+    std::string_view name;
+
+    /** @brief The zone ID which distinguishes zones with the same name (e.g., a model ID). */
+    std::uint64_t id = 0;
+
+    /** @brief The average time in milliseconds the zone took to execute per frame. */
+    double average_milliseconds = 0.0;
+
+    /** @brief The number of frames the average is computed over. */
+    std::uint32_t frame_count = 0;
+  };
+
+  /**
+   * @brief Creates a @ref GpuProfiler.
+   * @param device The device for creating timestamp query pools.
+   * @param create_info @copybrief GpuProfiler::CreateInfo
+   */
+  GpuProfiler(vk::Device device, const CreateInfo& create_info);
+
+  /** @brief Determines if the queue family supports timestamps required to record zones. */
+  [[nodiscard]] bool is_supported() const noexcept { return !frames_.empty(); }
+
+  /**
+   * @brief Begins recording zones for a frame.
+   * @details This function reads back zones recorded the last time @p frame_index was used and resets its query pool.
+   * @param command_buffer The primary command buffer for the frame which must be outside a render pass instance.
+   * @param frame_index The index of the frame in flight.
+   * @warning The caller is responsible for ensuring command buffers previously submitted for @p frame_index have
+   *          completed execution (e.g., by waiting on its render fence).
+   */
+  void BeginFrame(vk::CommandBuffer command_buffer, std::uint32_t frame_index);
+
+  /**
+   * @brief Writes a timestamp at the beginning of a zone.
+   * @details This function may be called concurrently while recording different command buffers for the current frame.
+   * @param command_buffer The command buffer to write the timestamp to.
+   * @param name The zone name which must remain valid for the lifetime of this profiler (e.g., a string literal).
+   * @param id The zone ID which distinguishes zones with the same name.
+   * @return The zone index to end the zone with or @c std::nullopt if timestamps are not supported or the current frame
+   *         reached its maximum zone count.
+   */
+  [[nodiscard]] std::optional<std::uint32_t> BeginZone(vk::CommandBuffer command_buffer,
+                                                       std::string_view name,
+                                                       std::uint64_t id = 0) noexcept;
+
+  /**
+   * @brief Writes a timestamp at the end of a zone.
+   * @param command_buffer The command buffer to write the timestamp to which must be submitted after the command buffer
+   *                       that began the zone or be the same command buffer.
+   * @param zone_index The zone index returned by @ref GpuProfiler::BeginZone for the current frame.
+   */
+  void EndZone(vk::CommandBuffer command_buffer, std::uint32_t zone_index) noexcept;
+
+  /**
+   * @brief Gets the average GPU execution time of each zone read back by @ref GpuProfiler::BeginFrame.
+   * @return The zone timings sorted by name and ID.
+   */
+  [[nodiscard]] std::vector<ZoneTiming> GetAverageTimings() const;
+
+private:
+  struct Zone {
+    std::string_view name;
+    std::uint64_t id = 0;
+  };
+
+  struct Frame {
+    vk::UniqueQueryPool query_pool;
+    std::vector<Zone> zones;  // indexed by zone index where each zone owns two consecutive timestamp queries
+    std::atomic<std::uint32_t> zone_count = 0;
+    std::uint64_t frame_number = 0;
+  };
+
+  // zone durations are stored in a ring buffer containing the most recent frames the zone was recorded in
+  struct ZoneStatistics {
+    void Add(double milliseconds, std::uint64_t sample_frame_number, std::uint32_t max_sample_count);
+
+    std::vector<double> samples;
+    std::size_t next_sample_index = 0;
+    double sample_sum = 0.0;
+    std::uint64_t frame_number = 0;  // the most recent frame a sample was added for
+  };
+
+  void ReadZones(const Frame& frame);
+
+  vk::Device device_;
+  double timestamp_period_ = 0.0;  // nanoseconds per timestamp increment
+  std::uint64_t timestamp_mask_ = 0;
+  std::uint32_t max_frame_zone_count_;
+  std::uint32_t average_frame_count_;
+  std::uint64_t frame_number_ = 0;
+  std::vector<std::unique_ptr<Frame>> frames_;  // heap-allocated to keep atomic zone counts stable
+  Frame* current_frame_ = nullptr;
+  std::vector<std::uint64_t> timestamps_;
+  std::map<std::pair<std::string_view, std::uint64_t>, ZoneStatistics> zone_statistics_;
+};
+
+/**
+ * @brief A scoped GPU profile zone that writes timestamps when it's constructed and destroyed.
+ * @details Timestamps are written at the top of the pipeline when the zone begins and at the bottom of the pipeline
+ *          when it ends which measures the time taken by commands recorded in between, including any overlap with
+ *          surrounding commands that the GPU executes concurrently.
+ */
+export class [[nodiscard]] GpuProfileZone {
+public:
+  /**
+   * @brief Begins a GPU profile zone.
+   * @param gpu_profiler The GPU profiler to record the zone to or @c nullptr to disable profiling.
+   * @param command_buffer The command buffer to write timestamps to.
+   * @param name The zone name which must remain valid for the lifetime of @p gpu_profiler (e.g., a string literal).
+   * @param id The zone ID which distinguishes zones with the same name.
+   */
+  GpuProfileZone(GpuProfiler* const gpu_profiler,
+                 const vk::CommandBuffer command_buffer,
+                 const std::string_view name,
+                 const std::uint64_t id = 0) noexcept
+      : gpu_profiler_{gpu_profiler},
+        command_buffer_{command_buffer},
+        zone_index_{gpu_profiler == nullptr ? std::nullopt : gpu_profiler->BeginZone(command_buffer, name, id)} {}
+
+  GpuProfileZone(const GpuProfileZone&) = delete;
+  GpuProfileZone(GpuProfileZone&&) noexcept = delete;
+
+  GpuProfileZone& operator=(const GpuProfileZone&) = delete;
+  GpuProfileZone& operator=(GpuProfileZone&&) noexcept = delete;
+
+  /** @brief Ends the GPU profile zone. */
+  ~GpuProfileZone() noexcept {
+    if (zone_index_.has_value()) {
+      gpu_profiler_->EndZone(command_buffer_, *zone_index_);
+    }
+  }
+
+private:
+  GpuProfiler* gpu_profiler_;
+  vk::CommandBuffer command_buffer_;
+  std::optional<std::uint32_t> zone_index_;
+};
+
+}  // namespace vktf
+
+module :private;
+
+namespace vktf {
+
+namespace {
+
+std::uint32_t GetTimestampValidBits(const vk::PhysicalDevice physical_device, const std::uint32_t queue_family_index) {
+  const auto queue_family_properties = physical_device.getQueueFamilyProperties();
+  assert(queue_family_index < queue_family_properties.size());
+  return queue_family_properties[queue_family_index].timestampValidBits;
+}
+
+std::uint64_t GetTimestampMask(const std::uint32_t timestamp_valid_bits) {
+  static constexpr std::uint32_t kMaxTimestampValidBits = 64;
+  return timestamp_valid_bits >= kMaxTimestampValidBits ? ~std::uint64_t{0}
+                                                        : (std::uint64_t{1} << timestamp_valid_bits) - 1;
+}
+
+}  // namespace
+
+GpuProfiler::GpuProfiler(const vk::Device device, const CreateInfo& create_info)
+    : device_{device},
+      max_frame_zone_count_{create_info.max_frame_zone_count},
+      average_frame_count_{std::max(create_info.average_frame_count, 1u)} {
+  const auto& [physical_device, queue_family_index, max_render_frames, max_frame_zone_count, _] = create_info;
+
+  // queue families report zero valid bits when they do not support timestamps in which case no query pools are created
+  const auto timestamp_valid_bits = GetTimestampValidBits(physical_device, queue_family_index);
+  if (timestamp_valid_bits == 0 || max_frame_zone_count == 0) return;
+
+  timestamp_period_ = static_cast<double>(physical_device.getProperties().limits.timestampPeriod);
+  timestamp_mask_ = GetTimestampMask(timestamp_valid_bits);
+  timestamps_.resize(2uz * max_frame_zone_count);
+
+  frames_.reserve(max_render_frames);
+  for (std::uint32_t frame_index = 0; frame_index < max_render_frames; ++frame_index) {
+    auto& frame = *frames_.emplace_back(std::make_unique<Frame>());
+    frame.query_pool = device.createQueryPoolUnique(
+        vk::QueryPoolCreateInfo{.queryType = vk::QueryType::eTimestamp, .queryCount = 2 * max_frame_zone_count});
+    frame.zones.resize(max_frame_zone_count);
+  }
+}
+
+void GpuProfiler::BeginFrame(const vk::CommandBuffer command_buffer, const std::uint32_t frame_index) {
+  if (!is_supported()) return;
+  assert(frame_index < frames_.size());
+
+  // results are available without waiting because the caller guarantees the frame has completed execution
+  auto& frame = *frames_[frame_index];
+  ReadZones(frame);
+
+  command_buffer.resetQueryPool(*frame.query_pool, 0, 2 * max_frame_zone_count_);
+  frame.zone_count.store(0, std::memory_order_relaxed);
+  frame.frame_number = ++frame_number_;
+  current_frame_ = &frame;
+}
+
+std::optional<std::uint32_t> GpuProfiler::BeginZone(const vk::CommandBuffer command_buffer,
+                                                    const std::string_view name,
+                                                    const std::uint64_t id) noexcept {
+  if (current_frame_ == nullptr) return std::nullopt;
+
+  // zone indices are reserved atomically which allows command buffers to be recorded concurrently
+  auto& frame = *current_frame_;
+  const auto zone_index = frame.zone_count.fetch_add(1, std::memory_order_relaxed);
+  if (zone_index >= max_frame_zone_count_) return std::nullopt;
+
+  frame.zones[zone_index] = Zone{.name = name, .id = id};
+  command_buffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, *frame.query_pool, 2 * zone_index);
+  return zone_index;
+}
+
+void GpuProfiler::EndZone(const vk::CommandBuffer command_buffer, const std::uint32_t zone_index) noexcept {
+  assert(current_frame_ != nullptr);
+  assert(zone_index < max_frame_zone_count_);
+  const auto query_pool = *current_frame_->query_pool;
+  command_buffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, query_pool, 2 * zone_index + 1);
+}
+
+void GpuProfiler::ReadZones(const Frame& frame) {
+  const auto zone_count = std::min(frame.zone_count.load(std::memory_order_relaxed), max_frame_zone_count_);
+  if (zone_count == 0) return;
+
+  const auto query_count = 2 * zone_count;
+  const auto result = device_.getQueryPoolResults(*frame.query_pool,
+                                                  0,
+                                                  query_count,
+                                                  query_count * sizeof(std::uint64_t),
+                                                  timestamps_.data(),
+                                                  sizeof(std::uint64_t),
+                                                  vk::QueryResultFlagBits::e64);
+
+  // results are not ready when a frame was recorded but never submitted (e.g., if an exception was thrown)
+  if (result != vk::Result::eSuccess) return;
+
+  static constexpr auto kNanosecondsPerMillisecond = 1'000'000.0;
+  for (std::uint32_t zone_index = 0; zone_index < zone_count; ++zone_index) {
+    const auto begin_timestamp = timestamps_[2uz * zone_index];
+    const auto end_timestamp = timestamps_[2uz * zone_index + 1];
+    const auto timestamp_delta = (end_timestamp - begin_timestamp) & timestamp_mask_;  // handles timestamp overflow
+    const auto milliseconds = static_cast<double>(timestamp_delta) * timestamp_period_ / kNanosecondsPerMillisecond;
+
+    const auto& [name, id] = frame.zones[zone_index];
+    zone_statistics_[std::pair{name, id}].Add(milliseconds, frame.frame_number, average_frame_count_);
+  }
+}
+
+void GpuProfiler::ZoneStatistics::Add(const double milliseconds,
+                                      const std::uint64_t sample_frame_number,
+                                      const std::uint32_t max_sample_count) {
+  // zones recorded more than once in the same frame (e.g., in multiple command buffers) accumulate into one sample
+  if (!samples.empty() && frame_number == sample_frame_number) {
+    const auto last_sample_index = (next_sample_index + samples.size() - 1) % samples.size();
+    samples[last_sample_index] += milliseconds;
+    sample_sum += milliseconds;
+    return;
+  }
+
+  if (samples.size() < max_sample_count) {
+    samples.push_back(milliseconds);
+  } else {
+    sample_sum -= samples[next_sample_index];
+    samples[next_sample_index] = milliseconds;
+  }
+  next_sample_index = (next_sample_index + 1) % max_sample_count;
+  sample_sum += milliseconds;
+  frame_number = sample_frame_number;
+}
+
+std::vector<GpuProfiler::ZoneTiming> GpuProfiler::GetAverageTimings() const {
+  std::vector<ZoneTiming> zone_timings;
+  zone_timings.reserve(zone_statistics_.size());
+
+  for (const auto& [zone_key, zone_statistics] : zone_statistics_) {
+    const auto& [name, id] = zone_key;
+    const auto sample_count = zone_statistics.samples.size();
+    const auto average_milliseconds = zone_statistics.sample_sum / static_cast<double>(sample_count);
+    zone_timings.push_back(ZoneTiming{.name = name,
+                                      .id = id,
+                                      .average_milliseconds = average_milliseconds,
+                                      .frame_count = static_cast<std::uint32_t>(sample_count)});
+  }
+
+  return zone_timings;
+}
+
+}  // namespace vktf
@@ -4,16 +4,19 @@ module;
 #include <array>
 #include <concepts>
 #include <cstdint>
-#include <utility>
+#include <filesystem>
 
 #include <glm/glm.hpp>
 #include <vulkan/vulkan.hpp>
 
 export module graphics_pipeline;
 
+import glslang_compiler;
 import log;
 import mesh;
+import pipeline_cache;
 import shader_module;
+import thread_pool;
 
 namespace vktf {
 
@@ -26,15 +29,12 @@ namespace vktf {
  */
 export class [[nodiscard]] GraphicsPipeline {
 public:
-  /** @brief A structure representing shader push constants. */
-  struct [[nodiscard]] PushConstants {
-    /** @brief The model transform that converts a local-space vertex position into world-space coordinates. */
-    glm::mat4 model_transform{0.0f};
-  };
-
   /** @brief The parameters for creating a @ref GraphicsPipeline. */
   struct [[nodiscard]] CreateInfo {
-    /** @brief The descriptor set layout for top-level descriptor sets bound once per frame (e.g., camera, lights). */
+    /**
+     * @brief The descriptor set layout for top-level descriptor sets bound once per frame (e.g., camera, lights).
+     * @note Model transforms are read from a storage buffer in this descriptor set using the draw instance index.
+     */
     vk::DescriptorSetLayout global_descriptor_set_layout;
 
     /** @brief The descriptor set layout for PBR metallic-roughness materials. */
@@ -49,8 +49,21 @@ public:
     /** @brief The render pass for the graphics pipeline. */
     vk::RenderPass render_pass;
 
-    /** @brief The number of lights to use as specialization constant in the fragment shader. */
-    std::uint32_t light_count = 0;
+    /**
+     * @brief The maximum number of lights to use as specialization constant in the fragment shader.
+     * @note The number of active lights is read from the lights uniform buffer which allows lights to be added and
+     *       removed without recreating the graphics pipeline.
+     */
+    std::uint32_t max_light_count = 0;
+
+    /** @brief The pipeline cache for avoiding driver compilation of pipelines created in previous runs. */
+    PipelineCache& pipeline_cache;
+
+    /** @brief The SPIR-V cache for avoiding recompilation of unchanged GLSL shaders compiled at runtime. */
+    glslang::SpirvCache& spirv_cache;
+
+    /** @brief The thread pool for compiling GLSL shaders concurrently. */
+    ThreadPool& thread_pool;
 
     /** @brief The log for writing messages when creating a graphics pipeline. */
     Log& log;
@@ -108,20 +121,11 @@ consteval vk::Format GetVertexAttributeFormat() {
 vk::UniquePipelineLayout CreateGraphicsPipelineLayout(const vk::Device device,
                                                       const vk::DescriptorSetLayout global_descriptor_set_layout,
                                                       const vk::DescriptorSetLayout material_descriptor_set_layout) {
-  using PushConstants = GraphicsPipeline::PushConstants;
-
-  static constexpr std::array kPushConstantRanges{
-      vk::PushConstantRange{.stageFlags = vk::ShaderStageFlagBits::eVertex,
-                            .offset = offsetof(PushConstants, model_transform),
-                            .size = sizeof(PushConstants::model_transform)}};
-
   const std::array descriptor_set_layouts{global_descriptor_set_layout, material_descriptor_set_layout};
 
   return device.createPipelineLayoutUnique(
       vk::PipelineLayoutCreateInfo{.setLayoutCount = static_cast<std::uint32_t>(descriptor_set_layouts.size()),
-                                   .pSetLayouts = descriptor_set_layouts.data(),
-                                   .pushConstantRangeCount = static_cast<std::uint32_t>(kPushConstantRanges.size()),
-                                   .pPushConstantRanges = kPushConstantRanges.data()});
+                                   .pSetLayouts = descriptor_set_layouts.data()});
 }
 
 vk::UniquePipeline CreateGraphicsPipeline(const vk::Device device,
@@ -132,27 +136,37 @@ vk::UniquePipeline CreateGraphicsPipeline(const vk::Device device,
                viewport_extent,
                msaa_sample_count,
                render_pass,
-               light_count,
+               max_light_count,
+               pipeline_cache,
+               spirv_cache,
+               thread_pool,
                log] = create_info;
 
-  const ShaderModule vertex_shader_module{device,
-                                          ShaderModule::CreateInfo{.shader_filepath = "shaders/vertex.glsl.spv",
-                                                                   .shader_stage = vk::ShaderStageFlagBits::eVertex,
-                                                                   .log = log}};
-
-  const ShaderModule fragment_shader_module{device,
-                                            ShaderModule::CreateInfo{.shader_filepath = "shaders/fragment.glsl.spv",
-                                                                     .shader_stage = vk::ShaderStageFlagBits::eFragment,
-                                                                     .log = log}};
-
-  static constexpr auto kLightCountSize = sizeof(light_count);
+  // shader modules are created together which allows GLSL shaders compiled at runtime to be compiled concurrently
+  const std::filesystem::path vertex_shader_filepath{"shaders/vertex.glsl.spv"};
+  const std::filesystem::path fragment_shader_filepath{"shaders/fragment.glsl.spv"};
+  const auto shader_modules = CreateShaderModules(
+      device,
+      std::array{ShaderModule::CreateInfo{.shader_filepath = vertex_shader_filepath,
+                                          .shader_stage = vk::ShaderStageFlagBits::eVertex,
+                                          .spirv_cache = &spirv_cache,
+                                          .log = log},
+                 ShaderModule::CreateInfo{.shader_filepath = fragment_shader_filepath,
+                                          .shader_stage = vk::ShaderStageFlagBits::eFragment,
+                                          .spirv_cache = &spirv_cache,
+                                          .log = log}},
+      thread_pool);
+  const auto& vertex_shader_module = shader_modules[0];
+  const auto& fragment_shader_module = shader_modules[1];
+
+  static constexpr auto kMaxLightCountSize = sizeof(max_light_count);
   static constexpr vk::SpecializationMapEntry kSpecializationMapEntry{.constantID = 0,
                                                                       .offset = 0,
-                                                                      .size = kLightCountSize};
+                                                                      .size = kMaxLightCountSize};
   const vk::SpecializationInfo specialization_info{.mapEntryCount = 1,
                                                    .pMapEntries = &kSpecializationMapEntry,
-                                                   .dataSize = kLightCountSize,
-                                                   .pData = &light_count};
+                                                   .dataSize = kMaxLightCountSize,
+                                                   .pData = &max_light_count};
 
   static constexpr auto* kShaderEntryPointName = "main";
   const std::array shader_stage_create_info{
@@ -238,8 +252,7 @@ vk::UniquePipeline CreateGraphicsPipeline(const vk::Device device,
       .pAttachments = &kColorBlendAttachmentState,
       .blendConstants = std::array{0.0f, 0.0f, 0.0f, 0.0f}};
 
-  auto [result, graphics_pipeline] = device.createGraphicsPipelineUnique(
-      nullptr,
+  return pipeline_cache.CreateGraphicsPipeline(
       vk::GraphicsPipelineCreateInfo{.stageCount = static_cast<std::uint32_t>(shader_stage_create_info.size()),
                                      .pStages = shader_stage_create_info.data(),
                                      .pVertexInputState = &kVertexInputStateCreateInfo,
@@ -252,9 +265,6 @@ vk::UniquePipeline CreateGraphicsPipeline(const vk::Device device,
                                      .layout = graphics_pipeline_layout,
                                      .renderPass = render_pass,
                                      .subpass = 0});
-  vk::detail::resultCheck(result, "Graphics pipeline creation failed");
-
-  return std::move(graphics_pipeline);  // return value optimization not available here
 }
 
 }  // namespace
@@ -0,0 +1,57 @@
+module;
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+export module hash;
+
+import mapped_file;
+
+namespace vktf {
+
+/** @brief The initial value for computing a 64-bit FNV-1a hash. */
+export constexpr std::uint64_t kFnv1aOffsetBasis = 0xcbf29ce484222325;
+
+/**
+ * @brief Computes a 64-bit FNV-1a hash.
+ * @details FNV-1a is a fast non-cryptographic hash suitable for content-addressed caching. Hashes can be computed
+ *          incrementally by passing the result of a previous invocation as the @p seed for the next sequence of bytes.
+ * @param bytes The bytes to hash.
+ * @param seed The initial hash value.
+ * @return The 64-bit FNV-1a hash of @p bytes.
+ * @see http://www.isthe.com/chongo/tech/comp/fnv/index.html FNV Hash
+ */
+export [[nodiscard]] constexpr std::uint64_t Hash(const std::span<const std::byte> bytes,
+                                                  const std::uint64_t seed = kFnv1aOffsetBasis) noexcept {
+  static constexpr std::uint64_t kFnv1aPrime = 0x100000001b3;
+  auto hash = seed;
+  for (const auto byte : bytes) {
+    hash ^= static_cast<std::uint64_t>(byte);
+    hash *= kFnv1aPrime;
+  }
+  return hash;
+}
+
+/**
+ * @brief Computes a 64-bit FNV-1a hash of the contents of a file.
+ * @details The file is memory-mapped rather than read into a heap allocation which avoids copying large files.
+ * @param filepath The filepath of the file to hash.
+ * @return The 64-bit FNV-1a hash of the file contents.
+ * @throws std::runtime_error Thrown if the file at @p filepath cannot be memory-mapped.
+ */
+export [[nodiscard]] std::uint64_t HashFile(const std::filesystem::path& filepath);
+
+}  // namespace vktf
+
+module :private;
+
+namespace vktf {
+
+std::uint64_t HashFile(const std::filesystem::path& filepath) {
+  const MappedFile mapped_file{filepath};
+  return Hash(mapped_file.data());
+}
+
+}  // namespace vktf
@@ -1,6 +1,7 @@
 module;
 
 #include <cstdint>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -42,6 +43,12 @@ public:
 
     /** @brief The parameters for allocating image memory. */
     const VmaAllocationCreateInfo& allocation_create_info;
+
+    /**
+     * @brief The unique queue families that access the image concurrently.
+     * @note When fewer than two queue families are specified, the image is exclusively owned by one queue family.
+     */
+    std::span<const std::uint32_t> queue_family_indices;
   };
 
   /**
@@ -71,7 +78,8 @@ public:
    * @param src_buffer The source buffer to copy data from.
    * @param buffer_image_copies The subregions to copy corresponding to each mipmap in @p src_buffer.
    * @param command_buffer The command buffer for recording copy commands.
-   * @warning The caller is responsible for submitting @p command_buffer to a Vulkan queue to begin execution.
+   * @warning The caller is responsible for submitting @p command_buffer to a Vulkan queue to begin execution and for
+   *          synchronizing subsequent shader reads with a semaphore signaled when @p command_buffer completes.
    */
   void Copy(vk::Buffer src_buffer,
             const std::vector<vk::BufferImageCopy>& buffer_image_copies,
@@ -96,9 +104,16 @@ namespace vktf {
 namespace {
 
 std::pair<VmaAllocation, vk::Image> CreateImage(const vma::Allocator& allocator, const Image::CreateInfo& create_info) {
-  const auto& [format, extent, mip_levels, sample_count, usage_flags, aspect_mask, allocation_create_info] =
-      create_info;
-
+  const auto& [format,
+               extent,
+               mip_levels,
+               sample_count,
+               usage_flags,
+               aspect_mask,
+               allocation_create_info,
+               queue_family_indices] = create_info;
+
+  const auto is_concurrent = queue_family_indices.size() > 1;
   const VkImageCreateInfo image_create_info{
       .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
       .imageType = VK_IMAGE_TYPE_2D,
@@ -107,7 +122,10 @@ std::pair<VmaAllocation, vk::Image> CreateImage(const vma::Allocator& allocator,
       .mipLevels = mip_levels,
       .arrayLayers = 1,
       .samples = static_cast<VkSampleCountFlagBits>(sample_count),
-      .usage = static_cast<VkImageUsageFlags>(usage_flags)};
+      .usage = static_cast<VkImageUsageFlags>(usage_flags),
+      .sharingMode = is_concurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+      .queueFamilyIndexCount = is_concurrent ? static_cast<std::uint32_t>(queue_family_indices.size()) : 0,
+      .pQueueFamilyIndices = is_concurrent ? queue_family_indices.data() : nullptr};
 
   VkImage image = nullptr;
   VmaAllocation allocation = nullptr;
@@ -203,10 +221,11 @@ void Image::Copy(const vk::Buffer src_buffer,
 
   command_buffer.copyBufferToImage(src_buffer, image_, vk::ImageLayout::eTransferDstOptimal, buffer_image_copies);
 
+  // shader stages are unsupported by transfer-only queues so shader reads are synchronized by a semaphore instead
   TransitionImageLayout(image_,
                         image_subresource_range,
-                        std::pair{vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader},
-                        std::pair{vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eShaderRead},
+                        std::pair{vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe},
+                        std::pair{vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eNone},
                         std::pair{vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal},
                         command_buffer);
 }
@@ -1,10 +1,19 @@
 module;
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <filesystem>
 #include <format>
+#include <functional>
 #include <memory>
 #include <ranges>
+#include <span>
 #include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -13,7 +22,9 @@ module;
 
 export module ktx_texture;
 
+import hash;
 import log;
+import profiler;
 
 namespace vktf::ktx {
 
@@ -35,6 +46,98 @@ export [[nodiscard]] UniqueKtxTexture2 Load(const std::filesystem::path& ktx_fil
                                             const vk::PhysicalDeviceFeatures& physical_device_features,
                                             Log& log);
 
+/**
+ * @brief Loads a Khronos Texture (KTX) 2.0 texture from memory.
+ * @details This function behaves the same as loading a KTX texture from a file but reads the encoded texture from
+ *          memory which is useful for textures embedded in binary glTF files.
+ * @param ktx_data The encoded KTX texture data.
+ * @param physical_device_features The physical device features for determining the best available transcode target.
+ * @param log The log for writing messages when loading a KTX texture.
+ * @return The loaded KTX texture transcoded to the best available image format if necessary.
+ * @throws std::runtime_error Thrown if the KTX texture in @p ktx_data fails to load or is unsupported.
+ * @warning The caller is responsible for ensuring @p ktx_data outlives the returned texture.
+ */
+export [[nodiscard]] UniqueKtxTexture2 Load(std::span<const std::byte> ktx_data,
+                                            const vk::PhysicalDeviceFeatures& physical_device_features,
+                                            Log& log);
+
+/**
+ * @brief A persistent cache of transcoded Khronos Texture (KTX) 2.0 textures.
+ * @details Transcoding Basis Universal textures (e.g., UASTC to BC7) is CPU intensive. This class writes transcoded
+ *          textures to a cache directory keyed by a hash of the source texture content and the selected transcode
+ *          format which allows subsequent loads to read pre-transcoded image data directly. Textures that do not
+ *          require transcoding bypass the cache. This class is safe to use concurrently from multiple threads.
+ */
+export class [[nodiscard]] TranscodeCache {
+public:
+  /**
+   * @brief Creates a @ref TranscodeCache.
+   * @param cache_directory The directory to write transcoded textures to which is created if it does not exist.
+   */
+  explicit TranscodeCache(std::filesystem::path cache_directory) noexcept
+      : cache_directory_{std::move(cache_directory)} {}
+
+  /**
+   * @brief Loads a KTX texture using the transcode cache.
+   * @param ktx_filepath The filepath of the KTX texture to load.
+   * @param physical_device_features The physical device features for determining the best available transcode target.
+   * @param log The log for writing messages when loading a KTX texture.
+   * @return The loaded KTX texture transcoded to the best available image format if necessary.
+   * @throws std::runtime_error Thrown if the KTX texture at @p ktx_filepath fails to load or is unsupported.
+   */
+  [[nodiscard]] UniqueKtxTexture2 Load(const std::filesystem::path& ktx_filepath,
+                                       const vk::PhysicalDeviceFeatures& physical_device_features,
+                                       Log& log);
+
+  /**
+   * @brief Loads a KTX texture from memory using the transcode cache.
+   * @param ktx_data The encoded KTX texture data.
+   * @param physical_device_features The physical device features for determining the best available transcode target.
+   * @param log The log for writing messages when loading a KTX texture.
+   * @return The loaded KTX texture transcoded to the best available image format if necessary.
+   * @throws std::runtime_error Thrown if the KTX texture in @p ktx_data fails to load or is unsupported.
+   * @warning The caller is responsible for ensuring @p ktx_data outlives the returned texture.
+   */
+  [[nodiscard]] UniqueKtxTexture2 Load(std::span<const std::byte> ktx_data,
+                                       const vk::PhysicalDeviceFeatures& physical_device_features,
+                                       Log& log);
+
+  /** @brief Gets the number of transcoded textures loaded from the cache. */
+  [[nodiscard]] std::uint32_t hit_count() const noexcept { return hit_count_.load(std::memory_order_relaxed); }
+
+  /** @brief Gets the number of textures that were transcoded because they were not found in the cache. */
+  [[nodiscard]] std::uint32_t miss_count() const noexcept { return miss_count_.load(std::memory_order_relaxed); }
+
+private:
+  UniqueKtxTexture2 Transcode(UniqueKtxTexture2 ktx_texture2,
+                              std::uint64_t ktx_data_hash,
+                              std::string_view ktx_name,
+                              const vk::PhysicalDeviceFeatures& physical_device_features,
+                              Log& log);
+
+  std::filesystem::path cache_directory_;
+  std::atomic<std::uint32_t> hit_count_ = 0;
+  std::atomic<std::uint32_t> miss_count_ = 0;
+};
+
+/**
+ * @brief Gets an identifier for the texture compression formats a physical device can transcode KTX textures to.
+ * @details KTX textures loaded with physical devices that share the same identifier are transcoded to the same image
+ *          formats which allows transcoded textures to be reused between them.
+ * @param physical_device_features The physical device features for determining available transcode targets.
+ * @return A value uniquely identifying the available transcode targets for @p physical_device_features.
+ */
+export [[nodiscard]] std::uint32_t GetTranscodeTargetId(const vk::PhysicalDeviceFeatures& physical_device_features);
+
+/**
+ * @brief Writes a KTX texture to memory.
+ * @details Writing a transcoded KTX texture allows its image data to be loaded again without transcoding.
+ * @param ktx_texture2 The KTX texture to write.
+ * @return The encoded KTX texture data.
+ * @throws std::runtime_error Thrown if @p ktx_texture2 could not be written.
+ */
+export [[nodiscard]] std::vector<std::byte> WriteToMemory(const ktxTexture2& ktx_texture2);
+
 /**
  * @brief Gets the buffer image copies for a KTX texture.
  * @details This function gets image copy subregions for mipmap images in a KTX texture for use in copying data from a
@@ -87,17 +190,44 @@ ktx_transcode_fmt_e SelectKtxTranscodeFormat(ktxTexture2& ktx_texture2,
   }
 
 #ifndef NDEBUG
-  log(Severity::kInfo) << std::format("No supported texture compression format could be found. Decompressing to {}",
-                                      ktxTranscodeFormatString(KTX_TTF_RGBA32));
+  log(Severity::kInfo).Print("No supported texture compression format could be found. Decompressing to {}",
+                             ktxTranscodeFormatString(KTX_TTF_RGBA32));
 #endif
   return KTX_TTF_RGBA32;  // fallback to RGBA32 if no supported transcode format is found
 }
 
-}  // namespace
+void TranscodeBasis(ktxTexture2& ktx_texture2,
+                    const ktx_transcode_fmt_e ktx_transcode_format,
+                    const std::string_view ktx_name) {
+  if (const auto ktx_error_code = ktxTexture2_TranscodeBasis(&ktx_texture2, ktx_transcode_format, 0);
+      ktx_error_code != KTX_SUCCESS) {
+    throw std::runtime_error{std::format("Failed to transcode {} to {} with error {}",
+                                         ktx_name,
+                                         ktxTranscodeFormatString(ktx_transcode_format),
+                                         ktxErrorString(ktx_error_code))};
+  }
+}
 
-UniqueKtxTexture2 Load(const std::filesystem::path& ktx_filepath,
-                       const vk::PhysicalDeviceFeatures& physical_device_features,
-                       Log& log) {
+void LoadImageData(ktxTexture2& ktx_texture2,
+                   const std::string_view ktx_name,
+                   const vk::PhysicalDeviceFeatures& physical_device_features,
+                   Log& log) {
+  if (ktxTexture2_NeedsTranscoding(&ktx_texture2)) {
+    const auto ktx_transcode_format = SelectKtxTranscodeFormat(ktx_texture2, physical_device_features, log);
+    TranscodeBasis(ktx_texture2, ktx_transcode_format, ktx_name);
+  } else if (ktx_texture2.pData == nullptr) {
+    // textures that do not require transcoding must have their image data loaded explicitly
+    if (const auto ktx_error_code = ktxTexture_LoadImageData(ktxTexture(&ktx_texture2), nullptr, 0);
+        ktx_error_code != KTX_SUCCESS) {
+      throw std::runtime_error{
+          std::format("Failed to load image data for {} with error {}", ktx_name, ktxErrorString(ktx_error_code))};
+    }
+  }
+}
+
+constexpr std::string_view kEmbeddedKtxName = "embedded KTX texture";
+
+UniqueKtxTexture2 CreateKtxTexture2(const std::filesystem::path& ktx_filepath) {
   UniqueKtxTexture2 ktx_texture2{nullptr, DestroyKtxTexture2};
 
   if (const auto ktx_error_code = ktxTexture2_CreateFromNamedFile(ktx_filepath.string().c_str(),
@@ -109,21 +239,153 @@ UniqueKtxTexture2 Load(const std::filesystem::path& ktx_filepath,
                                          ktxErrorString(ktx_error_code))};
   }
 
-  if (ktxTexture2_NeedsTranscoding(ktx_texture2.get())) {
-    const auto ktx_transcode_format = SelectKtxTranscodeFormat(*ktx_texture2, physical_device_features, log);
+  return ktx_texture2;
+}
 
-    if (const auto ktx_error_code = ktxTexture2_TranscodeBasis(ktx_texture2.get(), ktx_transcode_format, 0);
-        ktx_error_code != KTX_SUCCESS) {
-      throw std::runtime_error{std::format("Failed to transcode {} to {} with error {}",
-                                           ktx_filepath.string(),
-                                           ktxTranscodeFormatString(ktx_transcode_format),
-                                           ktxErrorString(ktx_error_code))};
-    }
+UniqueKtxTexture2 CreateKtxTexture2(const std::span<const std::byte> ktx_data) {
+  UniqueKtxTexture2 ktx_texture2{nullptr, DestroyKtxTexture2};
+
+  // textures in memory are not required to use basis universal supercompression because they may have already been
+  // transcoded and written to memory (e.g., by the asset cache) to avoid transcoding them again
+  if (const auto ktx_error_code =
+          ktxTexture2_CreateFromMemory(reinterpret_cast<const ktx_uint8_t*>(ktx_data.data()),
+                                       ktx_data.size(),
+                                       KTX_TEXTURE_CREATE_NO_FLAGS,
+                                       std::out_ptr(ktx_texture2));
+      ktx_error_code != KTX_SUCCESS) {
+    throw std::runtime_error{
+        std::format("Failed to create KTX texture from memory with error {}", ktxErrorString(ktx_error_code))};
+  }
+
+  return ktx_texture2;
+}
+
+UniqueKtxTexture2 LoadCachedKtxTexture2(const std::filesystem::path& cache_filepath) {
+  UniqueKtxTexture2 ktx_texture2{nullptr, DestroyKtxTexture2};
+  if (std::error_code error_code; !std::filesystem::exists(cache_filepath, error_code)) return ktx_texture2;
+
+  if (const auto ktx_error_code = ktxTexture2_CreateFromNamedFile(cache_filepath.string().c_str(),
+                                                                  KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT,
+                                                                  std::out_ptr(ktx_texture2));
+      ktx_error_code != KTX_SUCCESS || ktxTexture2_NeedsTranscoding(ktx_texture2.get())) {
+    ktx_texture2.reset();  // invalid cache files are treated as a cache miss and overwritten
+  }
+
+  return ktx_texture2;
+}
+
+void WriteCachedKtxTexture2(ktxTexture2& ktx_texture2, const std::filesystem::path& cache_filepath, Log& log) {
+  // write to a uniquely named temporary file first so that concurrent writers never observe a partially written file
+  auto temporary_filepath = cache_filepath;
+  temporary_filepath += std::format(".{:x}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+  std::error_code error_code;
+  std::filesystem::create_directories(cache_filepath.parent_path(), error_code);
+
+  if (const auto ktx_error_code = ktxTexture_WriteToNamedFile(ktxTexture(&ktx_texture2),
+                                                              temporary_filepath.string().c_str());
+      ktx_error_code != KTX_SUCCESS) {
+    log(Severity::kWarning).Print("Failed to write transcoded KTX texture {} with error {}",
+                                  cache_filepath.string(),
+                                  ktxErrorString(ktx_error_code));
+    std::filesystem::remove(temporary_filepath, error_code);
+    return;
+  }
+
+  if (std::filesystem::rename(temporary_filepath, cache_filepath, error_code); error_code) {
+    log(Severity::kWarning).Print("Failed to write transcoded KTX texture {} with error {}",
+                                  cache_filepath.string(),
+                                  error_code.message());
+    std::filesystem::remove(temporary_filepath, error_code);
   }
+}
+
+}  // namespace
 
+UniqueKtxTexture2 Load(const std::filesystem::path& ktx_filepath,
+                       const vk::PhysicalDeviceFeatures& physical_device_features,
+                       Log& log) {
+  const ProfileZone profile_zone{"ktx::Load"};
+  auto ktx_texture2 = CreateKtxTexture2(ktx_filepath);
+  LoadImageData(*ktx_texture2, ktx_filepath.string(), physical_device_features, log);
   return ktx_texture2;
 }
 
+UniqueKtxTexture2 Load(const std::span<const std::byte> ktx_data,
+                       const vk::PhysicalDeviceFeatures& physical_device_features,
+                       Log& log) {
+  const ProfileZone profile_zone{"ktx::Load"};
+  auto ktx_texture2 = CreateKtxTexture2(ktx_data);
+  LoadImageData(*ktx_texture2, kEmbeddedKtxName, physical_device_features, log);
+  return ktx_texture2;
+}
+
+UniqueKtxTexture2 TranscodeCache::Load(const std::filesystem::path& ktx_filepath,
+                                       const vk::PhysicalDeviceFeatures& physical_device_features,
+                                       Log& log) {
+  return Transcode(CreateKtxTexture2(ktx_filepath),
+                   HashFile(ktx_filepath),
+                   ktx_filepath.string(),
+                   physical_device_features,
+                   log);
+}
+
+UniqueKtxTexture2 TranscodeCache::Load(const std::span<const std::byte> ktx_data,
+                                       const vk::PhysicalDeviceFeatures& physical_device_features,
+                                       Log& log) {
+  return Transcode(CreateKtxTexture2(ktx_data), Hash(ktx_data), kEmbeddedKtxName, physical_device_features, log);
+}
+
+UniqueKtxTexture2 TranscodeCache::Transcode(UniqueKtxTexture2 ktx_texture2,
+                                            const std::uint64_t ktx_data_hash,
+                                            const std::string_view ktx_name,
+                                            const vk::PhysicalDeviceFeatures& physical_device_features,
+                                            Log& log) {
+  if (ktxTexture2_NeedsTranscoding(ktx_texture2.get()) == 0) {
+    LoadImageData(*ktx_texture2, ktx_name, physical_device_features, log);
+    return ktx_texture2;
+  }
+
+  // the transcode format depends on both the texture and physical device which makes it part of the cache key
+  const auto ktx_transcode_format = SelectKtxTranscodeFormat(*ktx_texture2, physical_device_features, log);
+  const auto cache_filepath =
+      cache_directory_ / std::format("{:016x}-{}.ktx2", ktx_data_hash, std::to_underlying(ktx_transcode_format));
+
+  if (auto cached_ktx_texture2 = LoadCachedKtxTexture2(cache_filepath); cached_ktx_texture2 != nullptr) {
+    hit_count_.fetch_add(1, std::memory_order_relaxed);
+    return cached_ktx_texture2;
+  }
+
+  miss_count_.fetch_add(1, std::memory_order_relaxed);
+  TranscodeBasis(*ktx_texture2, ktx_transcode_format, ktx_name);
+  WriteCachedKtxTexture2(*ktx_texture2, cache_filepath, log);
+  return ktx_texture2;
+}
+
+std::uint32_t GetTranscodeTargetId(const vk::PhysicalDeviceFeatures& physical_device_features) {
+  // transcode format selection only depends on the texture compression formats supported by the physical device
+  return static_cast<std::uint32_t>(physical_device_features.textureCompressionETC2 == vk::True)
+         | static_cast<std::uint32_t>(physical_device_features.textureCompressionBC == vk::True) << 1u
+         | static_cast<std::uint32_t>(physical_device_features.textureCompressionASTC_LDR == vk::True) << 2u;
+}
+
+std::vector<std::byte> WriteToMemory(const ktxTexture2& ktx_texture2) {
+  ktx_uint8_t* ktx_data = nullptr;
+  ktx_size_t ktx_data_size = 0;
+
+  // libktx does not modify textures when writing them to memory despite accepting a non-const pointer
+  auto* const ktx_texture = ktxTexture(const_cast<ktxTexture2*>(&ktx_texture2));  // NOLINT(*-pro-type-const-cast)
+  if (const auto ktx_error_code = ktxTexture_WriteToMemory(ktx_texture, &ktx_data, &ktx_data_size);
+      ktx_error_code != KTX_SUCCESS) {
+    throw std::runtime_error{
+        std::format("Failed to write KTX texture to memory with error {}", ktxErrorString(ktx_error_code))};
+  }
+
+  const std::unique_ptr<ktx_uint8_t, decltype(&std::free)> unique_ktx_data{ktx_data, std::free};
+  const auto ktx_bytes = std::as_bytes(std::span{unique_ktx_data.get(), ktx_data_size});
+  return std::vector(ktx_bytes.begin(), ktx_bytes.end());
+}
+
 std::vector<vk::BufferImageCopy> GetBufferImageCopies(const ktxTexture2& ktx_texture2) {
   return std::views::iota(0u, ktx_texture2.numLevels)
          | std::views::transform([ktx_texture = ktxTexture(&ktx_texture2)](const auto mip_level) {
@@ -1,19 +1,33 @@
 module;
 
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <format>
 #include <ios>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <print>
 #include <source_location>
+#include <streambuf>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <utility>
 
+// log messages with a severity below this value are removed at compile time (0 = info, 1 = warning, 2 = error)
+#ifndef VKTF_LOG_MIN_SEVERITY
+#define VKTF_LOG_MIN_SEVERITY 0
+#endif
+
 export module log;
 
+import trace_log;
+
 namespace vktf {
 
 /**
@@ -32,14 +46,31 @@ public:
   /** @brief An enumeration representing the severity of a log message. */
   enum class Severity : uint8_t { kInfo, kWarning, kError };
 
+  /**
+   * @brief An enumeration representing how log messages are written to output streams.
+   * @details Synchronous logs write each message directly to its output stream while holding a lock for the entire
+   *          line. Asynchronous logs format messages into per-thread buffers and push them onto a lock-free queue that
+   *          is drained by a background thread which prevents threads that log concurrently from serializing on a lock
+   *          and on output stream I/O.
+   */
+  enum class Mode : uint8_t { kSynchronous, kAsynchronous };
+
+  /**
+   * @brief The minimum severity of messages written by any log.
+   * @details This value is configured at compile time with @c VKTF_LOG_MIN_SEVERITY which allows the optimizer to
+   *          remove log messages with a lower severity entirely.
+   */
+  static constexpr auto kMinSeverity = static_cast<Severity>(VKTF_LOG_MIN_SEVERITY);
+
   /**
    * @brief Gets the default log implementation.
    * @details The default log implementation assigns messages with severity @ref Severity::kInfo to @c std::clog and
-   *          messages with severity @ref Severity::kWarning or @ref Severity::kError to @c std::cerr.
+   *          messages with severity @ref Severity::kWarning or @ref Severity::kError to @c std::cerr. Messages are
+   *          written asynchronously and all pending messages are written when the program exits normally.
    * @return A reference to the default log instance.
    */
   [[nodiscard]] static Log& Default() {
-    static Log default_log{std::clog, std::cerr, std::cerr};
+    static Log default_log{std::clog, std::cerr, std::cerr, Mode::kAsynchronous};
     return default_log;
   }
 
@@ -48,8 +79,12 @@ public:
    * @param info_ostream The output stream for messages with severity @ref Severity::kInfo.
    * @param warning_ostream The output stream for messages with severity @ref Severity::kWarning.
    * @param error_ostream The output stream for messages with severity @ref Severity::kError.
+   * @param mode Determines whether messages are written to output streams synchronously or asynchronously.
    */
-  Log(std::ostream& info_ostream, std::ostream& warning_ostream, std::ostream& error_ostream);
+  Log(std::ostream& info_ostream,
+      std::ostream& warning_ostream,
+      std::ostream& error_ostream,
+      Mode mode = Mode::kSynchronous);
 
   Log(const Log&) = delete;
   Log(Log&&) noexcept = delete;
@@ -59,23 +94,115 @@ public:
 
   /**
    * @brief Destroys a @ref Log.
-   * @details Flushes output streams to ensure log messages are correctly written on destruction.
+   * @details Flushes output streams to ensure log messages are correctly written on destruction. Asynchronous logs
+   *          first wait for all pending messages to be written.
    */
   ~Log() noexcept;
 
+  /**
+   * @brief Gets the runtime minimum severity of messages written by this log.
+   * @return The severity below which log messages are discarded.
+   */
+  [[nodiscard]] Severity min_severity() const noexcept { return min_severity_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Sets the runtime minimum severity of messages written by this log.
+   * @param severity The severity below which log messages are discarded.
+   * @note Messages with a severity below @ref kMinSeverity are always discarded regardless of this value.
+   */
+  void SetMinSeverity(const Severity severity) noexcept {
+    min_severity_.store(severity, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Sets a binary trace log to record messages.
+   * @details While a trace log is set, enabled messages are recorded in binary form instead of being written to output
+   *          streams. Messages written with @c Print record their raw format arguments which avoids text formatting
+   *          entirely while inserted values are formatted and recorded as a single string argument.
+   * @param trace_log The trace log to record messages to or @c nullptr to write messages to output streams.
+   * @warning The trace log must outlive all messages recorded by this log.
+   */
+  void SetTraceLog(TraceLog* const trace_log) noexcept { trace_log_.store(trace_log, std::memory_order_release); }
+
+  /**
+   * @brief Determines if messages with a given severity are written by this log.
+   * @param severity The log message severity.
+   * @return @c true if @p severity is at least @ref kMinSeverity and the runtime minimum severity, otherwise @c false.
+   */
+  [[nodiscard]] bool IsEnabled(const Severity severity) const noexcept {
+    return severity >= kMinSeverity && severity >= min_severity();
+  }
+
   /**
    * @brief Begins a new single-line log message.
+   * @details Messages with a severity that is not enabled do not acquire a lock and discard all inserted values. To
+   *          also skip formatting for these messages, prefer @c Print over inserting a @c std::format result.
    * @param severity The log message severity.
    * @param source_location The source code location indicating where the log message originates from.
    * @return A thread-safe proxy for writing single-line log messages with the provided @p severity.
    */
-  [[nodiscard]] LineProxy operator()(Severity severity,
-                                     const std::source_location& source_location = std::source_location::current());
+  [[nodiscard]] LineProxy operator()(const Severity severity,
+                                     const std::source_location& source_location = std::source_location::current()) {
+    return LineProxy{*this, severity, source_location};
+  }
 
 private:
+  struct Record {
+    Severity severity = Severity::kInfo;
+    std::string message;
+    Record* next = nullptr;
+  };
+
+  // a stream buffer that formats messages directly into a record which asynchronous logs recycle after writing its
+  // message to retain the capacity of its string between log messages
+  class LineBuffer final : std::streambuf {
+  public:
+    LineBuffer() : ostream_{this} {}
+
+    LineBuffer(const LineBuffer&) = delete;
+    LineBuffer(LineBuffer&&) noexcept = delete;
+
+    LineBuffer& operator=(const LineBuffer&) = delete;
+    LineBuffer& operator=(LineBuffer&&) noexcept = delete;
+
+    ~LineBuffer() noexcept override;
+
+    [[nodiscard]] std::ostream& ostream() noexcept { return ostream_; }
+
+    [[nodiscard]] std::string_view message() const noexcept { return record_->message; }
+
+    [[nodiscard]] bool Acquire(Log& log);
+
+    // transfers ownership of the formatted record which is replaced when the line buffer is next acquired
+    [[nodiscard]] Record* Release(Severity severity) noexcept;
+
+    // retains the formatted record for the next message after its contents have been consumed
+    void Discard() noexcept;
+
+  private:
+    int_type overflow(const int_type value) override {
+      if (!traits_type::eq_int_type(value, traits_type::eof())) {
+        record_->message.push_back(traits_type::to_char_type(value));
+      }
+      return traits_type::not_eof(value);
+    }
+
+    std::streamsize xsputn(const char_type* const data, const std::streamsize size) override {
+      record_->message.append(data, static_cast<std::size_t>(size));
+      return size;
+    }
+
+    Record* record_ = nullptr;
+    Record* free_records_ = nullptr;  // records taken from a log that are reused before taking more records
+    std::ostream ostream_;
+    bool in_use_ = false;
+  };
+
   class [[nodiscard]] LineProxy {
   public:
-    LineProxy(std::mutex& ostream_mutex, std::ostream& ostream, const std::source_location& source_location);
+    LineProxy(Log& log, const Severity severity, const std::source_location& source_location) {
+      if (log.IsEnabled(severity)) Begin(log, severity, source_location);
+    }
 
     LineProxy(const LineProxy&) = delete;
     LineProxy(LineProxy&&) noexcept = delete;
@@ -83,28 +210,59 @@ private:
     LineProxy& operator=(const LineProxy&) = delete;
     LineProxy& operator=(LineProxy&&) noexcept = delete;
 
-    ~LineProxy() noexcept;
+    ~LineProxy() noexcept {
+      if (ostream_ != nullptr) End();
+    }
 
     template <typename T>
     LineProxy& operator<<(T&& value) {
-      ostream_ << std::forward<T>(value);
+      if (ostream_ != nullptr) *ostream_ << std::forward<T>(value);
       return *this;
     }
 
     template <typename... Args>
     void Print(const std::format_string<Args...> format_string, Args&&... args) {
-      std::print(ostream_, format_string, std::forward<Args>(args)...);
+      if (trace_log_ != nullptr) {
+        trace_log_->Write(std::to_underlying(severity_), source_location_, format_string.get(), args...);
+      } else if (ostream_ != nullptr) {
+        std::print(*ostream_, format_string, std::forward<Args>(args)...);
+      }
     }
 
   private:
-    std::scoped_lock<std::mutex> ostream_lock_;
-    std::ostream& ostream_;
+    void Begin(Log& log, Severity severity, const std::source_location& source_location);
+    void End() noexcept;
+    LineBuffer& AcquireLineBuffer();
+
+    Log* log_ = nullptr;
+    Severity severity_ = Severity::kInfo;
+    std::source_location source_location_;
+    TraceLog* trace_log_ = nullptr;
+    std::unique_lock<std::mutex> ostream_lock_;      // only acquired by synchronous logs
+    std::unique_ptr<LineBuffer> owned_line_buffer_;  // only created for nested asynchronous log lines on one thread
+    LineBuffer* line_buffer_ = nullptr;              // only used by asynchronous logs
+    std::ostream* ostream_ = nullptr;                // only assigned when the log message severity is enabled
   };
 
+  [[nodiscard]] bool asynchronous() const noexcept { return writer_thread_.joinable(); }
+  [[nodiscard]] std::ostream& ostream(Severity severity) const noexcept;
+
+  static void DeleteRecords(Record* record) noexcept;
+
+  void Push(Record* record) noexcept;
+  void Recycle(Record* record) noexcept;
+  void WriteRecords();
+
   std::mutex ostream_mutex_;
   std::ostream& info_ostream_;
   std::ostream& warning_ostream_;
   std::ostream& error_ostream_;
+  std::atomic<Severity> min_severity_ = kMinSeverity;
+  std::atomic<TraceLog*> trace_log_ = nullptr;
+  std::atomic<Record*> records_ = nullptr;       // a lock-free stack of pending records in reverse order
+  std::atomic<Record*> free_records_ = nullptr;  // a lock-free stack of written records reused by line buffers
+  Record last_record_;                           // pushed on destruction to stop the writer thread
+  std::jthread writer_thread_;
 };
 
 }  // namespace vktf
@@ -140,10 +298,19 @@ std::string GetPreamble(const std::source_location& source_location) {
 
 }  // namespace
 
-Log::Log(std::ostream& info_ostream, std::ostream& warning_ostream, std::ostream& error_ostream)
-    : info_ostream_{info_ostream}, warning_ostream_{warning_ostream}, error_ostream_{error_ostream} {}
+Log::Log(std::ostream& info_ostream, std::ostream& warning_ostream, std::ostream& error_ostream, const Mode mode)
+    : info_ostream_{info_ostream}, warning_ostream_{warning_ostream}, error_ostream_{error_ostream} {
+  if (mode == Mode::kAsynchronous) {
+    writer_thread_ = std::jthread{[this] { WriteRecords(); }};
+  }
+}
 
 Log::~Log() noexcept {
+  if (asynchronous()) {
+    Push(&last_record_);  // records are written in the order they were pushed which ensures no message is dropped
+    writer_thread_.join();
+    DeleteRecords(free_records_.load(std::memory_order_acquire));
+  }
   try {
     if (info_ostream_) info_ostream_.flush();
     if (warning_ostream_) warning_ostream_.flush();
@@ -153,22 +320,143 @@ Log::~Log() noexcept {
   }
 }
 
-Log::LineProxy Log::operator()(const Severity severity, const std::source_location& source_location) {
-  auto& ostream = GetLogStream(severity, info_ostream_, warning_ostream_, error_ostream_);
-  return LineProxy{ostream_mutex_, ostream, source_location};
+std::ostream& Log::ostream(const Severity severity) const noexcept {
+  return GetLogStream(severity, info_ostream_, warning_ostream_, error_ostream_);
+}
+
+void Log::DeleteRecords(Record* record) noexcept {
+  while (record != nullptr) {
+    delete std::exchange(record, record->next);
+  }
+}
+
+void Log::Push(Record* const record) noexcept {
+  record->next = records_.load(std::memory_order_relaxed);
+  while (!records_.compare_exchange_weak(record->next, record, std::memory_order_release, std::memory_order_relaxed)) {
+  }
+
+  // the writer thread only waits when no records are pending which is the only case it needs to be notified
+  if (record->next == nullptr) records_.notify_one();
+}
+
+void Log::Recycle(Record* const record) noexcept {
+  record->next = free_records_.load(std::memory_order_relaxed);
+  while (!free_records_.compare_exchange_weak(record->next,
+                                              record,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed)) {
+  }
+}
+
+void Log::WriteRecords() {
+  for (auto is_last_record_written = false; !is_last_record_written;) {
+    records_.wait(nullptr, std::memory_order_acquire);
+    auto* record = records_.exchange(nullptr, std::memory_order_acquire);
+
+    // records are pushed onto a stack which must be reversed to write messages in the order they were logged
+    Record* first_record = nullptr;
+    while (record != nullptr) {
+      first_record = std::exchange(record, std::exchange(record->next, first_record));
+    }
+
+    while (first_record != nullptr) {
+      auto* const next_record = first_record->next;
+      if (first_record == &last_record_) {
+        is_last_record_written = true;
+      } else {
+        try {
+          if (auto& log_ostream = ostream(first_record->severity); log_ostream) {
+            log_ostream << first_record->message << '\n';
+          }
+        } catch (const std::ios_base::failure&) {
+          assert(false);  // prevent exception propagation from the writer thread
+        }
+        Recycle(first_record);
+      }
+      first_record = next_record;
+    }
+  }
+}
+
+void Log::LineProxy::Begin(Log& log, const Severity severity, const std::source_location& source_location) {
+  log_ = &log;
+  severity_ = severity;
+
+  if (trace_log_ = log.trace_log_.load(std::memory_order_acquire); trace_log_ != nullptr) {
+    source_location_ = source_location;  // trace logs record source locations instead of formatting a preamble
+    ostream_ = &AcquireLineBuffer().ostream();
+    return;
+  }
+
+  if (log.asynchronous()) {
+    ostream_ = &AcquireLineBuffer().ostream();
+  } else {
+    ostream_lock_ = std::unique_lock{log.ostream_mutex_};
+    ostream_ = &log.ostream(severity);
+  }
+
+  *ostream_ << GetPreamble(source_location);
+}
+
+Log::LineBuffer::~LineBuffer() noexcept {
+  delete record_;
+  DeleteRecords(free_records_);
+}
+
+bool Log::LineBuffer::Acquire(Log& log) {
+  if (in_use_) return false;
+
+  if (record_ == nullptr) {
+    // the entire stack is taken at once which avoids the ABA problem of popping single records from a lock-free stack
+    if (free_records_ == nullptr) free_records_ = log.free_records_.exchange(nullptr, std::memory_order_acquire);
+    record_ = free_records_ == nullptr ? new Record{} : std::exchange(free_records_, free_records_->next);
+    record_->message.clear();
+  }
+  in_use_ = true;
+  return true;
+}
+
+Log::Record* Log::LineBuffer::Release(const Severity severity) noexcept {
+  in_use_ = false;
+  record_->severity = severity;
+  record_->next = nullptr;
+  return std::exchange(record_, nullptr);
 }
 
-Log::LineProxy::LineProxy(std::mutex& ostream_mutex, std::ostream& ostream, const std::source_location& source_location)
-    : ostream_lock_{ostream_mutex}, ostream_{ostream} {
-  ostream << GetPreamble(source_location);
+void Log::LineBuffer::Discard() noexcept {
+  in_use_ = false;
+  record_->message.clear();
 }
 
-Log::LineProxy::~LineProxy() noexcept {
+Log::LineBuffer& Log::LineProxy::AcquireLineBuffer() {
+  // each thread reuses a single line buffer to avoid allocating a new buffer for every message
+  thread_local LineBuffer thread_line_buffer;
+  if (thread_line_buffer.Acquire(*log_)) {
+    line_buffer_ = &thread_line_buffer;
+  } else {
+    owned_line_buffer_ = std::make_unique<LineBuffer>();
+    line_buffer_ = owned_line_buffer_.get();
+    [[maybe_unused]] const auto acquired = line_buffer_->Acquire(*log_);
+  }
+  return *line_buffer_;
+}
+
+void Log::LineProxy::End() noexcept {
   try {
-    if (ostream_) ostream_ << '\n';
-  } catch (const std::ios_base::failure&) {
+    if (trace_log_ != nullptr) {
+      // values inserted into a traced message are recorded as a single preformatted string argument
+      if (const auto message = line_buffer_->message(); !message.empty()) {
+        trace_log_->Write(std::to_underlying(severity_), source_location_, "{}", message);
+      }
+    } else if (line_buffer_ == nullptr) {
+      if (*ostream_) *ostream_ << '\n';
+    } else {
+      log_->Push(line_buffer_->Release(severity_));  // formatted records are pushed without copying their message
+    }
+  } catch (const std::exception&) {
     assert(false);  // prevent exception propagation from noexcept destructor
   }
+  if (trace_log_ != nullptr) line_buffer_->Discard();  // traced messages are copied when written
 }
 
 }  // namespace vktf
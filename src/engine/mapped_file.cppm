@@ -0,0 +1,263 @@
+module;
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+export module mapped_file;
+
+namespace vktf {
+
+/**
+ * @brief A read-only memory mapping of a file.
+ * @details File contents are paged in on demand by the operating system which avoids copying file data into heap
+ *          allocations and allows memory to be shared with the page cache.
+ */
+export class [[nodiscard]] MappedFile {
+public:
+  /**
+   * @brief Creates a @ref MappedFile.
+   * @param filepath The filepath of the file to map into memory.
+   * @throws std::runtime_error Thrown if the file at @p filepath could not be opened or mapped.
+   */
+  explicit MappedFile(const std::filesystem::path& filepath);
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&& mapped_file) noexcept { *this = std::move(mapped_file); }
+
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&& mapped_file) noexcept;
+
+  /** @brief Unmaps the file from memory. */
+  ~MappedFile() noexcept;
+
+  /** @brief Gets a view of the mapped file contents. */
+  [[nodiscard]] std::span<const std::byte> data() const noexcept { return std::span{data_, size_bytes_}; }
+
+private:
+  const std::byte* data_ = nullptr;
+  std::size_t size_bytes_ = 0;
+};
+
+/**
+ * @brief A writable memory mapping of a file.
+ * @details Writes to mapped memory are shared with the page cache and written back to the file by the operating system
+ *          which preserves file contents if the process terminates unexpectedly.
+ */
+export class [[nodiscard]] WritableMappedFile {
+public:
+  /**
+   * @brief Creates a @ref WritableMappedFile.
+   * @param filepath The filepath of the file to create or overwrite and map into memory.
+   * @param size_bytes The size in bytes of the file which is initially filled with zeros.
+   * @throws std::runtime_error Thrown if the file at @p filepath could not be created or mapped.
+   */
+  WritableMappedFile(const std::filesystem::path& filepath, std::size_t size_bytes);
+
+  WritableMappedFile(const WritableMappedFile&) = delete;
+  WritableMappedFile(WritableMappedFile&& mapped_file) noexcept { *this = std::move(mapped_file); }
+
+  WritableMappedFile& operator=(const WritableMappedFile&) = delete;
+  WritableMappedFile& operator=(WritableMappedFile&& mapped_file) noexcept;
+
+  /** @brief Unmaps the file from memory. */
+  ~WritableMappedFile() noexcept;
+
+  /** @brief Gets a view of the mapped file contents. */
+  [[nodiscard]] std::span<std::byte> data() const noexcept { return std::span{data_, size_bytes_}; }
+
+private:
+  std::byte* data_ = nullptr;
+  std::size_t size_bytes_ = 0;
+};
+
+}  // namespace vktf
+
+module :private;
+
+namespace vktf {
+
+namespace {
+
+#ifdef _WIN32
+
+std::pair<const std::byte*, std::size_t> MapFile(const std::filesystem::path& filepath) {
+  const auto file_handle = CreateFileW(filepath.c_str(),
+                                       GENERIC_READ,
+                                       FILE_SHARE_READ,
+                                       nullptr,
+                                       OPEN_EXISTING,
+                                       FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                       nullptr);
+  if (file_handle == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error{std::format("Failed to open {}", filepath.string())};
+  }
+
+  LARGE_INTEGER file_size{};
+  if (GetFileSizeEx(file_handle, &file_size) == 0) {
+    CloseHandle(file_handle);
+    throw std::runtime_error{std::format("Failed to get the size of {}", filepath.string())};
+  }
+  if (file_size.QuadPart == 0) {
+    CloseHandle(file_handle);
+    return std::pair{nullptr, 0};  // empty files cannot be mapped
+  }
+
+  const auto file_mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file_handle);  // the file mapping maintains its own reference to the file
+  if (file_mapping_handle == nullptr) {
+    throw std::runtime_error{std::format("Failed to create a file mapping for {}", filepath.string())};
+  }
+
+  const auto* const data = MapViewOfFile(file_mapping_handle, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(file_mapping_handle);  // the mapped view maintains its own reference to the file mapping
+  if (data == nullptr) {
+    throw std::runtime_error{std::format("Failed to map {}", filepath.string())};
+  }
+
+  return std::pair{static_cast<const std::byte*>(data), static_cast<std::size_t>(file_size.QuadPart)};
+}
+
+std::byte* MapWritableFile(const std::filesystem::path& filepath, const std::size_t size_bytes) {
+  const auto file_handle = CreateFileW(filepath.c_str(),
+                                       GENERIC_READ | GENERIC_WRITE,
+                                       FILE_SHARE_READ,
+                                       nullptr,
+                                       CREATE_ALWAYS,
+                                       FILE_ATTRIBUTE_NORMAL,
+                                       nullptr);
+  if (file_handle == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error{std::format("Failed to create {}", filepath.string())};
+  }
+
+  // creating a file mapping larger than the file extends the file to the mapping size
+  const auto file_mapping_handle = CreateFileMappingW(file_handle,
+                                                      nullptr,
+                                                      PAGE_READWRITE,
+                                                      static_cast<DWORD>(static_cast<std::uint64_t>(size_bytes) >> 32u),
+                                                      static_cast<DWORD>(size_bytes),
+                                                      nullptr);
+  CloseHandle(file_handle);  // the file mapping maintains its own reference to the file
+  if (file_mapping_handle == nullptr) {
+    throw std::runtime_error{std::format("Failed to create a file mapping for {}", filepath.string())};
+  }
+
+  auto* const data = MapViewOfFile(file_mapping_handle, FILE_MAP_WRITE, 0, 0, size_bytes);
+  CloseHandle(file_mapping_handle);  // the mapped view maintains its own reference to the file mapping
+  if (data == nullptr) {
+    throw std::runtime_error{std::format("Failed to map {}", filepath.string())};
+  }
+
+  return static_cast<std::byte*>(data);
+}
+
+void UnmapFile(const std::byte* const data, [[maybe_unused]] const std::size_t size_bytes) noexcept {
+  if (data != nullptr) {
+    UnmapViewOfFile(data);
+  }
+}
+
+#else
+
+std::pair<const std::byte*, std::size_t> MapFile(const std::filesystem::path& filepath) {
+  const auto file_descriptor = open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file_descriptor == -1) {
+    throw std::runtime_error{std::format("Failed to open {}", filepath.string())};
+  }
+
+  struct stat file_status{};
+  if (fstat(file_descriptor, &file_status) == -1) {
+    close(file_descriptor);
+    throw std::runtime_error{std::format("Failed to get the size of {}", filepath.string())};
+  }
+  if (file_status.st_size == 0) {
+    close(file_descriptor);
+    return std::pair{nullptr, 0};  // empty files cannot be mapped
+  }
+
+  const auto size_bytes = static_cast<std::size_t>(file_status.st_size);
+  auto* const data = mmap(nullptr, size_bytes, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  close(file_descriptor);  // the mapping maintains its own reference to the file
+  if (data == MAP_FAILED) {
+    throw std::runtime_error{std::format("Failed to map {}", filepath.string())};
+  }
+
+  madvise(data, size_bytes, MADV_WILLNEED);  // request read-ahead since mapped files are expected to be read in full
+
+  return std::pair{static_cast<const std::byte*>(data), size_bytes};
+}
+
+std::byte* MapWritableFile(const std::filesystem::path& filepath, const std::size_t size_bytes) {
+  const auto file_descriptor = open(filepath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (file_descriptor == -1) {
+    throw std::runtime_error{std::format("Failed to create {}", filepath.string())};
+  }
+
+  if (ftruncate(file_descriptor, static_cast<off_t>(size_bytes)) == -1) {
+    close(file_descriptor);
+    throw std::runtime_error{std::format("Failed to resize {} to {} bytes", filepath.string(), size_bytes)};
+  }
+
+  auto* const data = mmap(nullptr, size_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+  close(file_descriptor);  // the mapping maintains its own reference to the file
+  if (data == MAP_FAILED) {
+    throw std::runtime_error{std::format("Failed to map {}", filepath.string())};
+  }
+
+  return static_cast<std::byte*>(data);
+}
+
+void UnmapFile(const std::byte* const data, const std::size_t size_bytes) noexcept {
+  if (data != nullptr) {
+    munmap(const_cast<std::byte*>(data), size_bytes);  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+  }
+}
+
+#endif
+
+}  // namespace
+
+MappedFile::MappedFile(const std::filesystem::path& filepath) {
+  std::tie(data_, size_bytes_) = MapFile(filepath);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& mapped_file) noexcept {
+  if (this != &mapped_file) {
+    UnmapFile(data_, size_bytes_);
+    data_ = std::exchange(mapped_file.data_, nullptr);
+    size_bytes_ = std::exchange(mapped_file.size_bytes_, 0);
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() noexcept { UnmapFile(data_, size_bytes_); }
+
+WritableMappedFile::WritableMappedFile(const std::filesystem::path& filepath, const std::size_t size_bytes)
+    : data_{MapWritableFile(filepath, size_bytes)}, size_bytes_{size_bytes} {}
+
+WritableMappedFile& WritableMappedFile::operator=(WritableMappedFile&& mapped_file) noexcept {
+  if (this != &mapped_file) {
+    UnmapFile(data_, size_bytes_);
+    data_ = std::exchange(mapped_file.data_, nullptr);
+    size_bytes_ = std::exchange(mapped_file.size_bytes_, 0);
+  }
+  return *this;
+}
+
+WritableMappedFile::~WritableMappedFile() noexcept { UnmapFile(data_, size_bytes_); }
+
+}  // namespace vktf
@@ -1,8 +1,11 @@
 module;
 
 #include <array>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <span>
 
-#include <ktx.h>
 #include <glm/glm.hpp>
 #include <vulkan/vulkan.hpp>
 
@@ -46,20 +49,25 @@ public:
     /** @brief @copybrief MaterialProperties */
     const MaterialProperties& material_properties;
 
-    /** @brief The base color KTX texture. */
-    const ktxTexture2& base_color_ktx_texture;
+    /**
+     * @brief The base color staging texture.
+     * @details Staging textures are shared because they are created concurrently as soon as their image data is loaded
+     *          and may be referenced by multiple materials.
+     */
+    std::shared_ptr<const StagingTexture> base_color_texture;
 
-    /** @brief The metallic-roughness KTX texture. */
-    const ktxTexture2& metallic_roughness_ktx_texture;
+    /** @brief The metallic-roughness staging texture. */
+    std::shared_ptr<const StagingTexture> metallic_roughness_texture;
 
-    /** @brief The normal map KTX texture. */
-    const ktxTexture2& normal_ktx_texture;
+    /** @brief The normal map staging texture. */
+    std::shared_ptr<const StagingTexture> normal_texture;
   };
 
   /**
    * @brief Creates a @ref StagingMaterial.
    * @param allocator The allocator for creating staging buffers.
    * @param create_info @copybrief StagingMaterial::CreateInfo
+   * @warning The caller is responsible for ensuring all staging textures in @p create_info are not null.
    */
   StagingMaterial(const vma::Allocator& allocator, const CreateInfo& create_info);
 
@@ -67,19 +75,19 @@ public:
   [[nodiscard]] const HostVisibleBuffer& properties_buffer() const noexcept { return properties_buffer_; }
 
   /** @brief Gets the base color staging texture. */
-  [[nodiscard]] const StagingTexture& base_color_texture() const noexcept { return base_color_texture_; }
+  [[nodiscard]] const StagingTexture& base_color_texture() const noexcept { return *base_color_texture_; }
 
   /** @brief Gets the metallic-roughness staging texture. */
-  [[nodiscard]] const StagingTexture& metallic_roughness_texture() const { return metallic_roughness_texture_; }
+  [[nodiscard]] const StagingTexture& metallic_roughness_texture() const { return *metallic_roughness_texture_; }
 
   /** @brief Gets the normal map staging texture. */
-  [[nodiscard]] const StagingTexture& normal_texture() const noexcept { return normal_texture_; }
+  [[nodiscard]] const StagingTexture& normal_texture() const noexcept { return *normal_texture_; }
 
 private:
   HostVisibleBuffer properties_buffer_;
-  StagingTexture base_color_texture_;
-  StagingTexture metallic_roughness_texture_;
-  StagingTexture normal_texture_;
+  std::shared_ptr<const StagingTexture> base_color_texture_;
+  std::shared_ptr<const StagingTexture> metallic_roughness_texture_;
+  std::shared_ptr<const StagingTexture> normal_texture_;
 };
 
 /**
@@ -105,6 +113,9 @@ public:
 
     /** @brief The descriptor set to update with this material's resources. */
     vk::DescriptorSet descriptor_set;
+
+    /** @brief The unique queue families that access material buffers and images concurrently. */
+    std::span<const std::uint32_t> queue_family_indices;
   };
 
   /**
@@ -174,9 +185,11 @@ void UpdateDescriptorSet(const vk::Device device,
 
 StagingMaterial::StagingMaterial(const vma::Allocator& allocator, const CreateInfo& create_info)
     : properties_buffer_{CreateStagingBuffer<MaterialProperties>(allocator, create_info.material_properties)},
-      base_color_texture_{allocator, create_info.base_color_ktx_texture},
-      metallic_roughness_texture_{allocator, create_info.metallic_roughness_ktx_texture},
-      normal_texture_{allocator, create_info.normal_ktx_texture} {}
+      base_color_texture_{create_info.base_color_texture},
+      metallic_roughness_texture_{create_info.metallic_roughness_texture},
+      normal_texture_{create_info.normal_texture} {
+  assert(base_color_texture_ != nullptr && metallic_roughness_texture_ != nullptr && normal_texture_ != nullptr);
+}
 
 Material::Material(const vma::Allocator& allocator,
                    const vk::CommandBuffer command_buffer,
@@ -184,20 +197,24 @@ Material::Material(const vma::Allocator& allocator,
     : properties_uniform_buffer_{CreateDeviceLocalBuffer(allocator,
                                                          command_buffer,
                                                          create_info.staging_material.properties_buffer(),
-                                                         vk::BufferUsageFlagBits::eUniformBuffer)},
+                                                         vk::BufferUsageFlagBits::eUniformBuffer,
+                                                         create_info.queue_family_indices)},
       base_color_texture_{allocator,
                           command_buffer,
                           Texture::CreateInfo{.staging_texture = create_info.staging_material.base_color_texture(),
-                                              .sampler = create_info.base_color_sampler}},
+                                              .sampler = create_info.base_color_sampler,
+                                              .queue_family_indices = create_info.queue_family_indices}},
       metallic_roughness_texture_{
           allocator,
           command_buffer,
           Texture::CreateInfo{.staging_texture = create_info.staging_material.metallic_roughness_texture(),
-                              .sampler = create_info.metallic_roughness_sampler}},
+                              .sampler = create_info.metallic_roughness_sampler,
+                              .queue_family_indices = create_info.queue_family_indices}},
       normal_texture_{allocator,
                       command_buffer,
                       Texture::CreateInfo{.staging_texture = create_info.staging_material.normal_texture(),
-                                          .sampler = create_info.normal_sampler}},
+                                          .sampler = create_info.normal_sampler,
+                                          .queue_family_indices = create_info.queue_family_indices}},
       descriptor_set_{create_info.descriptor_set} {
   UpdateDescriptorSet(allocator.device(),
                       descriptor_set_,
@@ -1,7 +1,12 @@
 module;
 
+#include <array>
+#include <cassert>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <ranges>
 #include <span>
 #include <utility>
 #include <vector>
@@ -13,7 +18,6 @@ export module mesh;
 
 import bounding_box;
 import buffer;
-import data_view;
 import vma_allocator;
 
 namespace vktf {
@@ -58,102 +62,218 @@ consteval vk::IndexType GetIndexType() {
   }
 }
 
+/** @brief The number of supported vertex index types. */
+export constexpr std::size_t kIndexTypeCount = 3;
+
+constexpr std::size_t GetIndexBufferIndex(const vk::IndexType index_type) {
+  switch (index_type) {
+    case vk::IndexType::eUint8:
+      return 0;
+    case vk::IndexType::eUint16:
+      return 1;
+    case vk::IndexType::eUint32:
+      return 2;
+    default:
+      std::unreachable();
+  }
+}
+
+/**
+ * @brief The location of mesh primitive vertices and indices in a geometry arena.
+ * @details Offsets are expressed in elements rather than bytes to allow them to be passed directly to indexed draw
+ *          commands.
+ */
+export struct [[nodiscard]] PrimitiveGeometry {
+  /** @brief The vertex index type which determines the arena index buffer containing the primitive indices. */
+  vk::IndexType index_type = vk::IndexType::eUint32;
+
+  /** @brief The number of vertex indices. */
+  std::uint32_t index_count = 0;
+
+  /** @brief The offset of the first primitive index in the arena index buffer for @ref index_type. */
+  std::uint32_t first_index = 0;
+
+  /** @brief The offset added to each primitive index to locate its vertex in the arena vertex buffer. */
+  std::int32_t vertex_offset = 0;
+};
+
 /**
- * @brief A mesh primitive in host-visible memory.
- * @details This class handles creating host-visible staging buffers with vertex and index data for a mesh primitive.
+ * @brief A layout for packing mesh primitive vertices and indices into contiguous memory.
+ * @details Vertices for all primitives are allocated from a single sequence and indices are allocated from one sequence
+ *          per index type. Primitive indices are not rebased and instead rely on @ref PrimitiveGeometry::vertex_offset.
+ *          Only element counts are recorded which allows staging buffers to be sized before any vertex data is written.
  */
-export class [[nodiscard]] StagingPrimitive {
+export class [[nodiscard]] GeometryArenaLayout {
 public:
   /**
-   * @brief The parameters for creating a @ref StagingPrimitive.
+   * @brief Allocates space in the arena for mesh primitive vertices and indices.
    * @tparam T The vertex index type.
+   * @param vertex_count The number of primitive vertices.
+   * @param index_count The number of primitive indices.
+   * @return The location of the primitive vertices and indices in the arena.
    */
   template <IndexType T>
-  struct [[nodiscard]] CreateInfo {
-    /** @brief The primitive vertices. */
-    std::span<const Vertex> vertices;
+  PrimitiveGeometry Add(const std::uint32_t vertex_count, const std::uint32_t index_count) {
+    auto& arena_index_count = index_counts_[GetIndexBufferIndex(GetIndexType<T>())];
+    const PrimitiveGeometry primitive_geometry{.index_type = GetIndexType<T>(),
+                                               .index_count = index_count,
+                                               .first_index = arena_index_count,
+                                               .vertex_offset = static_cast<std::int32_t>(vertex_count_)};
+    vertex_count_ += vertex_count;
+    arena_index_count += index_count;
+    return primitive_geometry;
+  }
+
+  /** @brief Gets the number of vertices for all primitives in the arena. */
+  [[nodiscard]] std::uint32_t vertex_count() const noexcept { return vertex_count_; }
 
-    /** @brief The primitive indices. */
-    std::span<const T> indices;
-  };
+  /** @brief Gets the number of indices for all primitives in the arena ordered by index type. */
+  [[nodiscard]] const std::array<std::uint32_t, kIndexTypeCount>& index_counts() const noexcept {
+    return index_counts_;
+  }
 
+private:
+  std::uint32_t vertex_count_ = 0;
+  std::array<std::uint32_t, kIndexTypeCount> index_counts_{};
+};
+
+/**
+ * @brief A geometry arena in host-visible memory.
+ * @details This class handles creating a single host-visible staging buffer for vertex data and one staging buffer per
+ *          index type for index data sized from a @ref GeometryArenaLayout. Staging buffers remain mapped until
+ *          @ref StagingGeometryArena::Flush is invoked which allows vertex attributes to be interleaved directly into
+ *          staging memory without intermediate copies.
+ */
+export class [[nodiscard]] StagingGeometryArena {
+public:
   /**
-   * @brief Creates a @ref StagingPrimitive.
-   * @tparam T The vertex index type.
+   * @brief Creates a @ref StagingGeometryArena.
    * @param allocator The allocator for creating staging buffers.
-   * @param create_info @copybrief StagingPrimitive::CreateInfo
+   * @param geometry_arena_layout The layout containing vertex and index counts for all mesh primitives.
+   */
+  StagingGeometryArena(const vma::Allocator& allocator, const GeometryArenaLayout& geometry_arena_layout);
+
+  /**
+   * @brief Gets a view of the staging memory for mesh primitive vertices.
+   * @param primitive_geometry The location of the primitive in the arena.
+   * @param vertex_count The number of primitive vertices allocated for @p primitive_geometry.
+   * @warning The caller is responsible for ensuring @ref StagingGeometryArena::Flush has not been invoked.
+   */
+  [[nodiscard]] std::span<Vertex> GetVertices(const PrimitiveGeometry& primitive_geometry,
+                                              std::uint32_t vertex_count) const;
+
+  /**
+   * @brief Gets a view of the staging memory for mesh primitive indices.
+   * @tparam T The vertex index type which must match @ref PrimitiveGeometry::index_type.
+   * @param primitive_geometry The location of the primitive in the arena.
+   * @warning The caller is responsible for ensuring @ref StagingGeometryArena::Flush has not been invoked.
    */
   template <IndexType T>
-  StagingPrimitive(const vma::Allocator& allocator, const CreateInfo<T>& create_info)
-      : vertex_buffer_{CreateStagingBuffer<Vertex>(allocator, create_info.vertices)},
-        index_buffer_{CreateStagingBuffer<T>(allocator, create_info.indices)},
-        index_type_{GetIndexType<T>()},
-        index_count_{static_cast<std::uint32_t>(create_info.indices.size())} {}
+  [[nodiscard]] std::span<T> GetIndices(const PrimitiveGeometry& primitive_geometry) const {
+    assert(primitive_geometry.index_type == GetIndexType<T>());
+    const auto& index_buffer = index_buffers_[GetIndexBufferIndex(primitive_geometry.index_type)];
+    assert(index_buffer.has_value());
+    return index_buffer->GetMappedData<T>().subspan(primitive_geometry.first_index, primitive_geometry.index_count);
+  }
 
-  /** @brief Gets the vertex staging buffer. */
-  [[nodiscard]] const HostVisibleBuffer& vertex_buffer() const noexcept { return vertex_buffer_; }
+  /** @brief Flushes and unmaps all staging buffers once vertex and index data has been written. */
+  void Flush();
 
-  /** @brief Gets the index staging buffer. */
-  [[nodiscard]] const HostVisibleBuffer& index_buffer() const noexcept { return index_buffer_; }
+  /**
+   * @brief Gets the vertex staging buffer.
+   * @note A value of @c std::nullopt indicates the arena does not contain any vertices.
+   */
+  [[nodiscard]] const std::optional<HostVisibleBuffer>& vertex_buffer() const noexcept { return vertex_buffer_; }
 
-  /** @brief Gets the vertex index type. */
-  [[nodiscard]] vk::IndexType index_type() const noexcept { return index_type_; }
+  /**
+   * @brief Gets the index staging buffers ordered by @c std::uint8_t, @c std::uint16_t, and @c std::uint32_t indices.
+   * @note A value of @c std::nullopt indicates the arena does not contain any indices with that index type.
+   */
+  [[nodiscard]] const std::array<std::optional<HostVisibleBuffer>, kIndexTypeCount>& index_buffers() const noexcept {
+    return index_buffers_;
+  }
 
-  /** @brief Gets the number of vertex indices. */
-  [[nodiscard]] std::uint32_t index_count() const noexcept { return index_count_; }
+private:
+  std::optional<HostVisibleBuffer> vertex_buffer_;
+  std::array<std::optional<HostVisibleBuffer>, kIndexTypeCount> index_buffers_;
+};
+
+/**
+ * @brief A geometry arena in device-local memory.
+ * @details This class handles creating a single device-local vertex buffer and one index buffer per index type for all
+ *          mesh primitives in a model. Suballocating primitives from shared buffers reduces the number of memory
+ *          allocations and allows vertex buffers to be bound once for all primitives.
+ */
+export class [[nodiscard]] GeometryArena {
+public:
+  /**
+   * @brief Creates a @ref GeometryArena.
+   * @param allocator The allocator for creating device-local buffers.
+   * @param command_buffer The command buffer for recording copy commands.
+   * @param staging_geometry_arena The staging geometry arena to copy to device-local memory.
+   * @param queue_family_indices The unique queue families that access the arena buffers concurrently.
+   * @warning The caller is responsible for submitting @p command_buffer to a Vulkan queue to begin execution.
+   */
+  GeometryArena(const vma::Allocator& allocator,
+                vk::CommandBuffer command_buffer,
+                const StagingGeometryArena& staging_geometry_arena,
+                std::span<const std::uint32_t> queue_family_indices);
+
+  /**
+   * @brief Records a command to bind the arena vertex buffer.
+   * @param command_buffer The command buffer for recording the bind command.
+   * @note If the arena does not contain any vertices, this function does nothing.
+   */
+  void BindVertexBuffer(vk::CommandBuffer command_buffer) const;
+
+  /**
+   * @brief Records a command to bind the arena index buffer for an index type.
+   * @param command_buffer The command buffer for recording the bind command.
+   * @param index_type The vertex index type for the index buffer to bind.
+   * @warning The caller is responsible for ensuring the arena contains indices with @p index_type.
+   */
+  void BindIndexBuffer(vk::CommandBuffer command_buffer, vk::IndexType index_type) const;
 
 private:
-  HostVisibleBuffer vertex_buffer_;
-  HostVisibleBuffer index_buffer_;
-  vk::IndexType index_type_;
-  std::uint32_t index_count_;
+  std::optional<Buffer> vertex_buffer_;
+  std::array<std::optional<Buffer>, kIndexTypeCount> index_buffers_;
 };
 
 /**
  * @brief A mesh primitive in device-local memory.
- * @details This class handles creating device-local vertex and index buffers, recording copy commands to transfer data
- *          from host-visible staging buffers, and assigning a descriptor set that references its material resources.
+ * @details This class represents a range of vertices and indices in a @ref GeometryArena and the draw batch that groups
+ *          it with other primitives sharing the same material and index type.
  */
 export class [[nodiscard]] Primitive {
 public:
-  /** @brief The parameters for creating a @ref Primitive. */
-  struct [[nodiscard]] CreateInfo {
-    /** @brief The staging primitive to copy to device-local memory. */
-    const StagingPrimitive& staging_primitive;
-
-    /** @brief The descriptor set for the primitive material. */
-    vk::DescriptorSet material_descriptor_set;
-  };
-
   /**
    * @brief Creates a @ref Primitive.
-   * @param allocator The allocator for creating device-local buffers.
-   * @param command_buffer The command buffer for recording copy commands.
-   * @param create_info @copybrief Primitive::CreateInfo
-   * @warning The caller is responsible for submitting @p command_buffer to a Vulkan queue to begin execution.
+   * @param geometry @copybrief PrimitiveGeometry
+   * @param draw_batch_index The index of the draw batch for the primitive within its model.
    */
-  Primitive(const vma::Allocator& allocator, vk::CommandBuffer command_buffer, const CreateInfo& create_info);
+  Primitive(const PrimitiveGeometry& geometry, const std::uint32_t draw_batch_index) noexcept
+      : geometry_{geometry}, draw_batch_index_{draw_batch_index} {}
 
-  /** @brief Gets the descriptor set for the primitive material. */
-  [[nodiscard]] vk::DescriptorSet material_descriptor_set() const noexcept { return material_descriptor_set_; }
+  /** @brief Gets the index of the draw batch for the primitive within its model. */
+  [[nodiscard]] std::uint32_t draw_batch_index() const noexcept { return draw_batch_index_; }
 
   /**
-   * @brief Records draw commands to render the primitive.
-   * @param command_buffer The command buffer for recording draw commands.
-   * @warning The caller is responsible for submitting @p command_buffer to a Vulkan queue to begin execution.
+   * @brief Gets an indexed draw command to render a single instance of the primitive.
+   * @param instance_index The index of the instance transform which the vertex shader reads using @c gl_InstanceIndex.
+   * @return An indexed draw command which can be recorded directly or written to an indirect draw buffer.
    */
-  void Render(const vk::CommandBuffer command_buffer) const {
-    command_buffer.bindVertexBuffers(0, *vertex_buffer_, static_cast<vk::DeviceSize>(0));
-    command_buffer.bindIndexBuffer(*index_buffer_, 0, index_type_);
-    command_buffer.drawIndexed(index_count_, 1, 0, 0, 0);
+  [[nodiscard]] vk::DrawIndexedIndirectCommand GetDrawCommand(const std::uint32_t instance_index) const noexcept {
+    const auto& [_, index_count, first_index, vertex_offset] = geometry_;
+    return vk::DrawIndexedIndirectCommand{.indexCount = index_count,
+                                          .instanceCount = 1,
+                                          .firstIndex = first_index,
+                                          .vertexOffset = vertex_offset,
+                                          .firstInstance = instance_index};
   }
 
 private:
-  Buffer vertex_buffer_;
-  Buffer index_buffer_;
-  vk::IndexType index_type_;
-  std::uint32_t index_count_;
-  vk::DescriptorSet material_descriptor_set_;
+  PrimitiveGeometry geometry_;
+  std::uint32_t draw_batch_index_;
 };
 
 /**
@@ -186,20 +306,93 @@ module :private;
 
 namespace vktf {
 
-Primitive::Primitive(const vma::Allocator& allocator,
-                     const vk::CommandBuffer command_buffer,
-                     const CreateInfo& create_info)
-    : vertex_buffer_{CreateDeviceLocalBuffer(allocator,
-                                             command_buffer,
-                                             create_info.staging_primitive.vertex_buffer(),
-                                             vk::BufferUsageFlagBits::eVertexBuffer)},
-      index_buffer_{CreateDeviceLocalBuffer(allocator,
-                                            command_buffer,
-                                            create_info.staging_primitive.index_buffer(),
-                                            vk::BufferUsageFlagBits::eIndexBuffer)},
-      index_type_{create_info.staging_primitive.index_type()},
-      index_count_{create_info.staging_primitive.index_count()},
-      material_descriptor_set_{create_info.material_descriptor_set} {}
+namespace {
+
+std::optional<HostVisibleBuffer> CreateOptionalStagingBuffer(const vma::Allocator& allocator,
+                                                             const std::uint32_t element_count,
+                                                             const vk::DeviceSize element_size_bytes) {
+  if (element_count == 0) return std::nullopt;  // zero-sized buffers are not permitted
+  HostVisibleBuffer staging_buffer{allocator,
+                                   HostVisibleBuffer::CreateInfo{.size_bytes = element_count * element_size_bytes,
+                                                                 .usage_flags = vk::BufferUsageFlagBits::eTransferSrc}};
+  staging_buffer.MapMemory();  // staging buffers remain mapped until the arena is flushed
+  return staging_buffer;
+}
+
+std::optional<Buffer> CreateOptionalDeviceLocalBuffer(const vma::Allocator& allocator,
+                                                      const vk::CommandBuffer command_buffer,
+                                                      const std::optional<HostVisibleBuffer>& staging_buffer,
+                                                      const vk::BufferUsageFlags usage_flags,
+                                                      const std::span<const std::uint32_t> queue_family_indices) {
+  if (!staging_buffer.has_value()) return std::nullopt;
+  return CreateDeviceLocalBuffer(allocator, command_buffer, *staging_buffer, usage_flags, queue_family_indices);
+}
+
+}  // namespace
+
+StagingGeometryArena::StagingGeometryArena(const vma::Allocator& allocator,
+                                           const GeometryArenaLayout& geometry_arena_layout)
+    : vertex_buffer_{CreateOptionalStagingBuffer(allocator, geometry_arena_layout.vertex_count(), sizeof(Vertex))} {
+  static constexpr std::array<vk::DeviceSize, kIndexTypeCount> kIndexSizes{sizeof(std::uint8_t),
+                                                                           sizeof(std::uint16_t),
+                                                                           sizeof(std::uint32_t)};
+  for (const auto& [index_buffer, index_count, index_size] :
+       std::views::zip(index_buffers_, geometry_arena_layout.index_counts(), kIndexSizes)) {
+    index_buffer = CreateOptionalStagingBuffer(allocator, index_count, index_size);
+  }
+}
+
+std::span<Vertex> StagingGeometryArena::GetVertices(const PrimitiveGeometry& primitive_geometry,
+                                                    const std::uint32_t vertex_count) const {
+  assert(vertex_buffer_.has_value());
+  return vertex_buffer_->GetMappedData<Vertex>().subspan(static_cast<std::size_t>(primitive_geometry.vertex_offset),
+                                                         vertex_count);
+}
+
+void StagingGeometryArena::Flush() {
+  // staging buffers are copied once so they can be unmapped as soon as all writes are visible to the device
+  for (auto& index_buffer : index_buffers_) {
+    if (index_buffer.has_value()) {
+      index_buffer->Flush();
+      index_buffer->UnmapMemory();
+    }
+  }
+  if (vertex_buffer_.has_value()) {
+    vertex_buffer_->Flush();
+    vertex_buffer_->UnmapMemory();
+  }
+}
+
+GeometryArena::GeometryArena(const vma::Allocator& allocator,
+                             const vk::CommandBuffer command_buffer,
+                             const StagingGeometryArena& staging_geometry_arena,
+                             const std::span<const std::uint32_t> queue_family_indices)
+    : vertex_buffer_{CreateOptionalDeviceLocalBuffer(allocator,
+                                                     command_buffer,
+                                                     staging_geometry_arena.vertex_buffer(),
+                                                     vk::BufferUsageFlagBits::eVertexBuffer,
+                                                     queue_family_indices)} {
+  for (const auto& [index_buffer, staging_index_buffer] :
+       std::views::zip(index_buffers_, staging_geometry_arena.index_buffers())) {
+    index_buffer = CreateOptionalDeviceLocalBuffer(allocator,
+                                                   command_buffer,
+                                                   staging_index_buffer,
+                                                   vk::BufferUsageFlagBits::eIndexBuffer,
+                                                   queue_family_indices);
+  }
+}
+
+void GeometryArena::BindVertexBuffer(const vk::CommandBuffer command_buffer) const {
+  if (vertex_buffer_.has_value()) {
+    command_buffer.bindVertexBuffers(0, **vertex_buffer_, static_cast<vk::DeviceSize>(0));
+  }
+}
+
+void GeometryArena::BindIndexBuffer(const vk::CommandBuffer command_buffer, const vk::IndexType index_type) const {
+  const auto& index_buffer = index_buffers_[GetIndexBufferIndex(index_type)];
+  assert(index_buffer.has_value());
+  command_buffer.bindIndexBuffer(**index_buffer, 0, index_type);
+}
 
 Mesh::Mesh(std::vector<Primitive> primitives, const BoundingBox& bounding_box)
     : primitives_{std::move(primitives)}, bounding_box_{bounding_box} {}
@@ -8,12 +8,15 @@ module;
 #include <filesystem>
 #include <future>
 #include <limits>
+#include <map>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -27,16 +30,82 @@ export module model;
 import bounding_box;
 import descriptor_pool;
 import gltf_asset;
-import graphics_pipeline;
 import ktx_texture;
 import log;
 import material;
 import mesh;
-import view_frustum;
+import node_hierarchy;
+import texture;
+import thread_pool;
 import vma_allocator;
 
 namespace vktf {
 
+/** @brief A type alias for a shared future to a staging texture which is @c nullptr if the texture is unsupported. */
+export using StagingTextureFuture = std::shared_future<std::shared_ptr<const StagingTexture>>;
+
+export class StagingTextureFutures;
+
+/**
+ * @brief Creates staging textures for a glTF asset asynchronously.
+ * @details Each texture is loaded, transcoded if necessary, and copied to a staging buffer in a single thread pool task
+ *          which allows textures to be staged as soon as their image data is available rather than after all textures
+ *          have been loaded. Starting texture creation for all assets before creating any staging model allows texture
+ *          loading to overlap with staging and uploading other assets. Only textures referenced by materials that
+ *          support the PBR metallic-roughness workflow are staged because no other textures are used by a model.
+ * @param allocator The allocator for creating staging buffers.
+ * @param gltf_asset The glTF asset containing the textures to stage.
+ * @param physical_device_features The physical device features for determining the transcode target of KTX textures.
+ * @param thread_pool The thread pool for creating staging textures concurrently.
+ * @param log The log for writing messages when creating staging textures.
+ * @return The staging texture futures by glTF texture key.
+ * @warning The caller is responsible for ensuring all arguments outlive the returned futures.
+ */
+export [[nodiscard]] StagingTextureFutures CreateStagingTexturesAsync(
+    const vma::Allocator& allocator,
+    const gltf::Asset& gltf_asset,
+    const vk::PhysicalDeviceFeatures& physical_device_features,
+    ThreadPool& thread_pool,
+    Log& log);
+
+/**
+ * @brief Staging texture futures by glTF texture key created by @ref CreateStagingTexturesAsync.
+ * @details Staging texture tasks reference the glTF asset, allocator, and log they were created with. Destroying this
+ *          object waits for all outstanding tasks which guarantees they do not outlive those arguments when it's
+ *          declared after them, including when an exception is thrown before every staging texture is used.
+ */
+export class [[nodiscard]] StagingTextureFutures {
+public:
+  StagingTextureFutures() noexcept = default;
+
+  StagingTextureFutures(const StagingTextureFutures&) = delete;
+  StagingTextureFutures(StagingTextureFutures&& staging_texture_futures) noexcept;
+
+  StagingTextureFutures& operator=(const StagingTextureFutures&) = delete;
+  StagingTextureFutures& operator=(StagingTextureFutures&& staging_texture_futures) noexcept;
+
+  ~StagingTextureFutures() noexcept;
+
+  /**
+   * @brief Finds the staging texture future for a glTF texture.
+   * @param gltf_texture The glTF texture to find.
+   * @return The staging texture future or @c nullptr if @p gltf_texture was not staged.
+   */
+  [[nodiscard]] const StagingTextureFuture* Find(const gltf::Texture* gltf_texture) const noexcept;
+
+  /** @brief Waits for all staging texture tasks to complete. */
+  void Wait() const noexcept;
+
+private:
+  friend StagingTextureFutures CreateStagingTexturesAsync(const vma::Allocator&,
+                                                          const gltf::Asset&,
+                                                          const vk::PhysicalDeviceFeatures&,
+                                                          ThreadPool&,
+                                                          Log&);
+
+  std::unordered_map<const gltf::Texture*, StagingTextureFuture> futures_;
+};
+
 /**
  * @brief A model in host-visible memory.
  * @details This class handles creating host-visible staging buffers with texture, material, and mesh data from a glTF
@@ -47,16 +116,16 @@ public:
   /** @brief A type alias for an optional staging material. */
   using Material = std::optional<pbr_metallic_roughness::StagingMaterial>;
 
-  /** @brief A type alias for a vector of optional staging primitives. */
-  using Mesh = std::vector<std::optional<StagingPrimitive>>;
+  /** @brief A type alias for a vector of optional mesh primitive locations in the staging geometry arena. */
+  using Mesh = std::vector<std::optional<PrimitiveGeometry>>;
 
   /** @brief The parameters to create a @ref StagingModel. */
   struct [[nodiscard]] CreateInfo {
     /** @brief The glTF asset to copy to host-visible memory. */
     const gltf::Asset& gltf_asset;
 
-    /** @brief The physical device features for determining the transcode target of basis universal KTX textures. */
-    const vk::PhysicalDeviceFeatures& physical_device_features;
+    /** @brief The staging textures for @ref gltf_asset created by @ref CreateStagingTexturesAsync. */
+    const StagingTextureFutures& staging_textures;
 
     /** @brief The log for writing messages when creating a staging model. */
     Log& log;
@@ -75,9 +144,13 @@ public:
   /** @brief Gets a map of staging meshes by glTF mesh key. */
   [[nodiscard]] const std::unordered_map<const gltf::Mesh*, Mesh>& meshes() const noexcept { return meshes_; }
 
+  /** @brief Gets the staging geometry arena containing vertex and index data for all staging meshes. */
+  [[nodiscard]] const StagingGeometryArena& geometry_arena() const noexcept { return *geometry_arena_; }
+
 private:
   std::unordered_map<const gltf::Material*, Material> materials_;
   std::unordered_map<const gltf::Mesh*, Mesh> meshes_;
+  std::optional<StagingGeometryArena> geometry_arena_;  // guaranteed to be valid upon staging model construction
 };
 
 /**
@@ -99,25 +172,29 @@ public:
     Type type = Type::kDirectional;
   };
 
-  /** @brief A hierarchical graph node. */
+  /**
+   * @brief A hierarchical graph node.
+   * @note Node transforms are stored separately in @ref Model::node_hierarchy at the same index as the node.
+   */
   struct [[nodiscard]] Node {
-    /** @brief The local transform representing the node position and orientation relative to its parent.  */
-    glm::mat4 local_transform{0.0f};
-
-    /**
-     * @brief The global transform representing the world-space node position and orientation.
-     * @note This property is calculated once per frame by @ref Model::Update.
-     */
-    glm::mat4 global_transform{0.0f};
-
     /** @brief The non-owning pointer to the node mesh. */
     const Mesh* mesh = nullptr;
 
-    /** @brief The non-owning pointer to the node light. S*/
+    /** @brief The non-owning pointer to the node light. */
     const Light* light = nullptr;
+  };
 
-    /** @brief A list of non-owning pointers to the node children. */
-    std::vector<Node*> children;
+  /**
+   * @brief A group of mesh primitives that can be rendered with the same bound resources.
+   * @details Primitives in the same draw batch share a material descriptor set and an index buffer which allows all
+   *          visible instances of those primitives to be rendered with a single multi-draw indirect command.
+   */
+  struct [[nodiscard]] DrawBatch {
+    /** @brief The descriptor set for the material shared by all primitives in the draw batch. */
+    vk::DescriptorSet material_descriptor_set;
+
+    /** @brief The vertex index type which determines the geometry arena index buffer to bind. */
+    vk::IndexType index_type = vk::IndexType::eUint32;
   };
 
   /** @brief The parameters for creating a @ref Model. */
@@ -140,6 +217,13 @@ public:
      * @note A value of @c std::nullopt indicates this feature is not enabled.
      */
     std::optional<float> sampler_anisotropy;
+
+    /**
+     * @brief The unique queue families that access device-local model resources concurrently.
+     * @note This allows resources copied on a dedicated transfer queue to be used by a graphics queue without
+     *       transferring queue family ownership.
+     */
+    std::span<const std::uint32_t> queue_family_indices;
   };
 
   /**
@@ -153,56 +237,57 @@ public:
   Model(const vma::Allocator& allocator, vk::CommandBuffer command_buffer, const CreateInfo& create_info);
 
   /**
-   * @brief Updates each node in the model.
-   * @details This function traverses the node hierarchy, updates the global transform for each node, and invokes a node
-   *          visitor on each node to allow the caller to respond to updates after the node and all its children have
-   *          been updated (i.e., post-order traversal).
-   * @tparam Fn The callable function type for @p node_visitor.
-   * @param node_visitor The function to be invoked on each node after its entire subtree has been updated.
+   * @brief Sets the local transform for a node.
+   * @param node_index The index of the node in @ref Model::nodes to update.
+   * @param local_transform The node transform relative to its parent.
+   * @note The global transforms for the node and its descendants are recalculated by the next @ref Model::Update.
    */
-  template <std::invocable<const Node&> Fn>
-  void Update(Fn&& node_visitor) {
-    for (auto* const root_node : root_nodes_) {
-      assert(root_node != nullptr);  // guaranteed by root node construction
-      Update(*root_node, root_transform_, std::forward<Fn>(node_visitor));
-    }
+  void SetLocalTransform(const std::uint32_t node_index, const glm::mat4& local_transform) {
+    node_hierarchy_.SetLocalTransform(node_index, local_transform);
   }
 
   /**
-   * @brief Records draw commands to render visible meshes in the model.
-   * @details This function traverses the node hierarchy and records draw commands for each visible mesh.
-   * @param command_buffer The command buffer for recording draw commands.
-   * @param pipeline_layout The pipeline layout for binding push constants and descriptor sets.
-   * @param view_frustum The camera view frustum for determining mesh visibility.
-   * @warning The caller is responsible for submitting @p command_buffer to a Vulkan queue to begin execution.
+   * @brief Updates the global transform for each node whose local transform or ancestor changed since the last update.
+   * @return @c true if any global transform was updated, otherwise @c false.
+   * @see NodeHierarchy::updated for determining which nodes were updated.
    */
-  void Render(vk::CommandBuffer command_buffer,
-              vk::PipelineLayout pipeline_layout,
-              const ViewFrustum& view_frustum) const;
+  bool Update() { return node_hierarchy_.Update(); }
 
-private:
-  template <std::invocable<const Node&> Fn>
-  static void Update(Node& node, const glm::mat4& global_transform, Fn&& node_visitor) {
-    node.global_transform = global_transform * node.local_transform;
+  /**
+   * @brief Updates the global transform for each node whose local transform or ancestor changed on a thread pool.
+   * @param thread_pool The thread pool for executing update tasks.
+   * @return Futures for each update task which are empty if no global transform needs to be updated.
+   * @warning The caller is responsible for waiting on all returned futures before accessing or modifying the model.
+   * @see NodeHierarchy::UpdateAsync for details on how nodes are divided between tasks.
+   */
+  [[nodiscard]] std::vector<std::future<void>> UpdateAsync(ThreadPool& thread_pool) {
+    return node_hierarchy_.UpdateAsync(thread_pool);
+  }
 
-    for (const auto& child_node : node.children) {
-      assert(child_node != nullptr);  // guaranteed by node construction
-      Update(*child_node, node.global_transform, std::forward<Fn>(node_visitor));
-    }
+  /** @brief Gets the nodes in the default glTF scene stored in depth-first pre-order. */
+  [[nodiscard]] const std::vector<Node>& nodes() const noexcept { return nodes_; }
 
-    std::forward<Fn>(node_visitor)(node);  // visit node after its children have been updated
-  }
+  /** @brief Gets the local and global transforms for each node indexed the same as @ref Model::nodes. */
+  [[nodiscard]] const NodeHierarchy& node_hierarchy() const noexcept { return node_hierarchy_; }
+
+  /** @brief Gets the geometry arena containing vertex and index data for all model meshes. */
+  [[nodiscard]] const GeometryArena& geometry_arena() const noexcept { return *geometry_arena_; }
 
+  /** @brief Gets the draw batches indexed by @ref Primitive::draw_batch_index for all model mesh primitives. */
+  [[nodiscard]] const std::vector<DrawBatch>& draw_batches() const noexcept { return draw_batches_; }
+
+private:
   using Material = pbr_metallic_roughness::Material;
 
   std::vector<vk::UniqueSampler> samplers_;
   std::vector<std::unique_ptr<const Material>> materials_;
   std::optional<DescriptorPool> material_descriptor_pool_;  // guaranteed to be valid upon model construction
+  std::optional<GeometryArena> geometry_arena_;            // guaranteed to be valid upon model construction
+  std::vector<DrawBatch> draw_batches_;
   std::vector<std::unique_ptr<const Mesh>> meshes_;
   std::vector<std::unique_ptr<const Light>> lights_;
-  std::vector<std::unique_ptr<Node>> nodes_;
-  std::vector<Node*> root_nodes_;
-  glm::mat4 root_transform_{1.0f};
+  std::vector<Node> nodes_;
+  NodeHierarchy node_hierarchy_;
 };
 
 }  // namespace vktf
@@ -293,27 +378,25 @@ vk::Sampler GetSampler(const gltf::Texture* const gltf_texture,
 }
 
 // =====================================================================================================================
-// KTX Textures
+// Staging Textures
 // =====================================================================================================================
 
-using KtxTextureFuture = std::shared_future<ktx::UniqueKtxTexture2>;
-
 const std::optional<std::filesystem::path>& GetKtxFilepath(const gltf::Texture* const gltf_texture, Log& log) {
   static const std::optional<std::filesystem::path> kInvalidKtxFilepath = std::nullopt;
   if (gltf_texture == nullptr) return kInvalidKtxFilepath;
 
   const auto& ktx_filepath = gltf_texture->filepath;
   if (!ktx_filepath.has_value()) {
-    log(Severity::kError) << std::format("Failed to get KTX filepath for texture {}", GetName(*gltf_texture));
+    log(Severity::kError).Print("Failed to get KTX filepath for texture {}", GetName(*gltf_texture));
     return kInvalidKtxFilepath;
   }
 
   // exclude raw image files because they do not encode what color space to be rendered in and supporting that scenario
   // requires coupling material and texture creation which introduces an unnecessary dependency for a suboptimal format
   if (static constexpr std::string_view kKtx2Extension = ".ktx2"; ktx_filepath->extension() != kKtx2Extension) {
-    log(Severity::kError) << std::format("Failed to get KTX filepath for texture {} with bad file extension {}",
-                                         GetName(*gltf_texture),
-                                         ktx_filepath->extension().string());
+    log(Severity::kError).Print("Failed to get KTX filepath for texture {} with bad file extension {}",
+                                GetName(*gltf_texture),
+                                ktx_filepath->extension().string());
     return kInvalidKtxFilepath;
   }
 
@@ -323,6 +406,16 @@ const std::optional<std::filesystem::path>& GetKtxFilepath(const gltf::Texture*
 ktx::UniqueKtxTexture2 CreateKtxTexture(const gltf::Texture* const gltf_texture,
                                         const vk::PhysicalDeviceFeatures& physical_device_features,
                                         Log& log) {
+  if (gltf_texture != nullptr && !gltf_texture->image_data.empty()) {
+    if (static constexpr std::string_view kKtx2MimeType = "image/ktx2"; gltf_texture->mime_type != kKtx2MimeType) {
+      log(Severity::kError).Print("Failed to create KTX texture {} with unsupported media type {}",
+                                  GetName(*gltf_texture),
+                                  gltf_texture->mime_type.value_or("undefined"));
+      return ktx::UniqueKtxTexture2{nullptr, nullptr};
+    }
+    return ktx::Load(gltf_texture->image_data, physical_device_features, log);
+  }
+
   return GetKtxFilepath(gltf_texture, log)
       .transform([&physical_device_features, &log](const auto& ktx_filepath) {
         return ktx::Load(ktx_filepath, physical_device_features, log);
@@ -330,33 +423,38 @@ ktx::UniqueKtxTexture2 CreateKtxTexture(const gltf::Texture* const gltf_texture,
       .value_or(ktx::UniqueKtxTexture2{nullptr, nullptr});
 }
 
-GltfResourceMap<gltf::Texture, KtxTextureFuture> CreateKtxTexturesAsync(
-    const std::vector<gltf::UniqueTexture>& gltf_textures,
-    const vk::PhysicalDeviceFeatures& physical_device_features,
-    Log& log) {
-  return gltf_textures  //
-         | std::views::transform([&physical_device_features, &log](const auto& gltf_texture) {
-             assert(gltf_texture != nullptr);  // guaranteed by glTF asset construction
-             const auto* const gltf_texture_ptr = gltf_texture.get();
-             auto future = std::async(std::launch::async,
-                                      CreateKtxTexture,
-                                      gltf_texture_ptr,
-                                      physical_device_features,
-                                      std::ref(log));
-             return std::pair{gltf_texture_ptr, future.share()};
-           })
-         | std::ranges::to<std::unordered_map>();
+std::shared_ptr<const StagingTexture> CreateStagingTexture(const vma::Allocator& allocator,
+                                                           const gltf::Texture* const gltf_texture,
+                                                           const vk::PhysicalDeviceFeatures& physical_device_features,
+                                                           Log& log) {
+  // KTX textures are released as soon as their image data is copied to limit peak host memory usage
+  const auto ktx_texture = CreateKtxTexture(gltf_texture, physical_device_features, log);
+  if (ktx_texture == nullptr) return nullptr;
+  return std::make_shared<const StagingTexture>(allocator, *ktx_texture);
+}
+
+std::shared_ptr<const StagingTexture> GetStagingTexture(const gltf::Texture* const gltf_texture,
+                                                        const StagingTextureFutures& staging_texture_futures) {
+  const auto* const staging_texture_future = staging_texture_futures.Find(gltf_texture);
+  return staging_texture_future == nullptr ? nullptr : staging_texture_future->get();
 }
 
-const ktx::UniqueKtxTexture2& GetKtxTexture(
-    const gltf::Texture* const gltf_texture,
-    const GltfResourceMap<gltf::Texture, KtxTextureFuture>& ktx_texture_futures) {
-  const auto& ktx_texture_future = Get(gltf_texture, ktx_texture_futures);
-  if (!ktx_texture_future.valid()) {
-    static constexpr ktx::UniqueKtxTexture2 kInvalidKtxTexture{nullptr, nullptr};
-    return kInvalidKtxTexture;
+std::unordered_set<const gltf::Texture*> GetMaterialTextures(const gltf::Asset& gltf_asset) {
+  std::unordered_set<const gltf::Texture*> material_textures;
+  for (const auto& gltf_material : gltf_asset.materials) {
+    assert(gltf_material != nullptr);  // guaranteed by glTF asset construction
+    const auto& pbr_metallic_roughness = gltf_material->pbr_metallic_roughness;
+    if (!pbr_metallic_roughness.has_value()) continue;  // materials without PBR properties are not supported
+
+    for (const auto* const gltf_texture : {pbr_metallic_roughness->base_color_texture,
+                                           pbr_metallic_roughness->metallic_roughness_texture,
+                                           gltf_material->normal_texture}) {
+      if (gltf_texture != nullptr) {
+        material_textures.insert(gltf_texture);
+      }
+    }
   }
-  return ktx_texture_future.get();
+  return material_textures;
 }
 
 // =====================================================================================================================
@@ -368,12 +466,12 @@ using namespace pbr_metallic_roughness;
 StagingModel::Material CreateStagingMaterial(
     const vma::Allocator& allocator,
     const gltf::Material& gltf_material,
-    const GltfResourceMap<gltf::Texture, KtxTextureFuture>& ktx_texture_futures,
+    const StagingTextureFutures& staging_texture_futures,
     Log& log) {
   const auto& [_, pbr_metallic_roughness, normal_scale, normal_texture] = gltf_material;
 
   if (!pbr_metallic_roughness.has_value()) {
-    log(Severity::kError) << std::format(
+    log(Severity::kError).Print(
         "Failed to create material {} because it does not support PBR metallic-roughness properties",
         GetName(gltf_material));
     return std::nullopt;  // TODO: add support for non-PBR metallic-roughness materials
@@ -382,17 +480,19 @@ StagingModel::Material CreateStagingMaterial(
   const auto& [base_color_factor, base_color_texture, metallic_factor, roughness_factor, metallic_roughness_texture] =
       *pbr_metallic_roughness;
 
-  const auto& base_color_ktx_texture = GetKtxTexture(base_color_texture, ktx_texture_futures);
-  const auto& metallic_roughness_ktx_texture = GetKtxTexture(metallic_roughness_texture, ktx_texture_futures);
-  const auto& normal_ktx_texture = GetKtxTexture(normal_texture, ktx_texture_futures);
-
-  for (const auto& [texture_name, ktx_texture] : std::views::zip(
-           std::array{"base color", "metallic-roughness", "normal"},
-           std::array{base_color_ktx_texture.get(), metallic_roughness_ktx_texture.get(), normal_ktx_texture.get()})) {
-    if (ktx_texture == nullptr) {
-      log(Severity::kError) << std::format("Failed to create material {} with missing {} texture",
-                                           GetName(gltf_material),
-                                           texture_name);
+  auto base_color_staging_texture = GetStagingTexture(base_color_texture, staging_texture_futures);
+  auto metallic_roughness_staging_texture = GetStagingTexture(metallic_roughness_texture, staging_texture_futures);
+  auto normal_staging_texture = GetStagingTexture(normal_texture, staging_texture_futures);
+
+  for (const auto& [texture_name, staging_texture] :
+       std::views::zip(std::array{"base color", "metallic-roughness", "normal"},
+                       std::array{base_color_staging_texture.get(),
+                                  metallic_roughness_staging_texture.get(),
+                                  normal_staging_texture.get()})) {
+    if (staging_texture == nullptr) {
+      log(Severity::kError).Print("Failed to create material {} with missing {} texture",
+                                  GetName(gltf_material),
+                                  texture_name);
       return std::nullopt;  // TODO: add support for optional material textures
     }
   }
@@ -403,21 +503,21 @@ StagingModel::Material CreateStagingMaterial(
                                                                        .metallic_roughness_factor =
                                                                            glm::vec2{metallic_factor, roughness_factor},
                                                                        .normal_scale = normal_scale},
-                             .base_color_ktx_texture = *base_color_ktx_texture,
-                             .metallic_roughness_ktx_texture = *metallic_roughness_ktx_texture,
-                             .normal_ktx_texture = *normal_ktx_texture}};
+                             .base_color_texture = std::move(base_color_staging_texture),
+                             .metallic_roughness_texture = std::move(metallic_roughness_staging_texture),
+                             .normal_texture = std::move(normal_staging_texture)}};
 }
 
 GltfResourceMap<gltf::Material, StagingModel::Material> CreateStagingMaterials(
     const vma::Allocator& allocator,
     const std::vector<gltf::UniqueMaterial>& gltf_materials,
-    const GltfResourceMap<gltf::Texture, KtxTextureFuture>& ktx_texture_futures,
+    const StagingTextureFutures& staging_texture_futures,
     Log& log) {
   return gltf_materials  //
-         | std::views::transform([&allocator, &ktx_texture_futures, &log](const auto& gltf_material) {
+         | std::views::transform([&allocator, &staging_texture_futures, &log](const auto& gltf_material) {
              assert(gltf_material != nullptr);  // guaranteed by glTF asset construction
              return std::pair{gltf_material.get(),
-                              CreateStagingMaterial(allocator, *gltf_material, ktx_texture_futures, log)};
+                              CreateStagingMaterial(allocator, *gltf_material, staging_texture_futures, log)};
            })
          | std::ranges::to<std::unordered_map>();
 }
@@ -458,7 +558,8 @@ UniqueMaterial CreateMaterial(const vma::Allocator& allocator,
                               const gltf::Material& gltf_material,
                               const StagingMaterial& staging_material,
                               const GltfResourceMap<gltf::Sampler, vk::UniqueSampler>& samplers,
-                              const vk::DescriptorSet descriptor_set) {
+                              const vk::DescriptorSet descriptor_set,
+                              const std::span<const std::uint32_t> queue_family_indices) {
   const auto& pbr_metallic_roughness = gltf_material.pbr_metallic_roughness;
   assert(pbr_metallic_roughness.has_value());  // guaranteed by staging material construction
 
@@ -470,7 +571,8 @@ UniqueMaterial CreateMaterial(const vma::Allocator& allocator,
           .base_color_sampler = GetSampler(pbr_metallic_roughness->base_color_texture, samplers),
           .metallic_roughness_sampler = GetSampler(pbr_metallic_roughness->metallic_roughness_texture, samplers),
           .normal_sampler = GetSampler(gltf_material.normal_texture, samplers),
-          .descriptor_set = descriptor_set});
+          .descriptor_set = descriptor_set,
+          .queue_family_indices = queue_family_indices});
 }
 
 GltfResourceMap<gltf::Material, UniqueMaterial> CreateMaterials(
@@ -478,7 +580,8 @@ GltfResourceMap<gltf::Material, UniqueMaterial> CreateMaterials(
     const vk::CommandBuffer command_buffer,
     const GltfResourceMap<gltf::Material, StagingModel::Material>& staging_materials,
     const GltfResourceMap<gltf::Sampler, vk::UniqueSampler>& samplers,
-    const std::vector<vk::DescriptorSet>& descriptor_sets) {
+    const std::vector<vk::DescriptorSet>& descriptor_sets,
+    const std::span<const std::uint32_t> queue_family_indices) {
   // descriptor sets are allocated based on the number of supported materials
   assert(descriptor_sets.size() == CountSupportedMaterials(staging_materials | std::views::values));
   std::size_t descriptor_set_index = 0;
@@ -499,7 +602,8 @@ GltfResourceMap<gltf::Material, UniqueMaterial> CreateMaterials(
                                                *gltf_material,
                                                *staging_material,
                                                samplers,
-                                               descriptor_sets[descriptor_set_index++])};
+                                               descriptor_sets[descriptor_set_index++],
+                                               queue_family_indices)};
              })
          | std::ranges::to<std::unordered_map>();
 }
@@ -513,19 +617,24 @@ using NormalAttribute = gltf::Attributes::Normal;
 using TangentAttribute = gltf::Attributes::Tangent;
 using TexCoord0Attribute = gltf::Attributes::TexCoord0;
 
-std::vector<Vertex> CreateVertices(const PositionAttribute::Data& position_data,
-                                   const NormalAttribute::Data& normal_data,
-                                   const TangentAttribute::Data& tangent_data,
-                                   const TexCoord0Attribute::Data& texcoord_0_data) {
-  return std::views::zip_transform(
-             [](const auto position, const auto& normal, const auto& tangent, const auto& texcoord_0) {
-               return Vertex{.position = position, .normal = normal, .tangent = tangent, .texcoord_0 = texcoord_0};
-             },
-             position_data,
-             normal_data,
-             tangent_data,
-             texcoord_0_data)
-         | std::ranges::to<std::vector>();
+// vertices are only created for the number of elements shared by every attribute
+std::uint32_t GetVertexCount(const gltf::Attributes& attributes) {
+  const auto& [position_attribute, normal_attribute, tangent_attribute, texcoord_0_attribute] = attributes;
+  return static_cast<std::uint32_t>(std::min({position_attribute.data.size(),
+                                              normal_attribute.data->size(),
+                                              tangent_attribute.data->size(),
+                                              texcoord_0_attribute.data->size()}));
+}
+
+void WriteVertices(const gltf::Attributes& attributes, const std::span<Vertex> vertices) {
+  const auto& [position_attribute, normal_attribute, tangent_attribute, texcoord_0_attribute] = attributes;
+  for (auto&& [vertex, position, normal, tangent, texcoord_0] : std::views::zip(vertices,
+                                                                                 position_attribute.data,
+                                                                                 *normal_attribute.data,
+                                                                                 *tangent_attribute.data,
+                                                                                 *texcoord_0_attribute.data)) {
+    vertex = Vertex{.position = position, .normal = normal, .tangent = tangent, .texcoord_0 = texcoord_0};
+  }
 }
 
 std::optional<std::string_view> FindMissingAttributeName(const gltf::Attributes& attributes) {
@@ -536,99 +645,135 @@ std::optional<std::string_view> FindMissingAttributeName(const gltf::Attributes&
   return std::nullopt;
 }
 
-std::optional<StagingPrimitive> CreateStagingPrimitive(
-    const vma::Allocator& allocator,
+std::optional<PrimitiveGeometry> CreateStagingPrimitive(
     const gltf::Mesh& gltf_mesh,
     const std::size_t primitive_index,
     const GltfResourceMap<gltf::Material, StagingModel::Material>& staging_materials,
+    GeometryArenaLayout& geometry_arena_layout,
     Log& log) {
   assert(primitive_index < gltf_mesh.primitives.size());
   const auto& [attributes, indices_variant, gltf_material] = gltf_mesh.primitives[primitive_index];
 
   if (const auto attribute_name = FindMissingAttributeName(attributes); attribute_name.has_value()) {
-    log(Severity::kError) << std::format("Failed to create mesh primitive {}[{}] with missing {} attribute",
-                                         GetName(gltf_mesh),
-                                         primitive_index,
-                                         *attribute_name);
+    log(Severity::kError).Print("Failed to create mesh primitive {}[{}] with missing {} attribute",
+                                GetName(gltf_mesh),
+                                primitive_index,
+                                *attribute_name);
     return std::nullopt;  // TODO: add support for optional vertex attributes
   }
 
   if (!indices_variant.has_value()) {
-    log(Severity::kError) << std::format("Failed to create mesh primitive {}[{}] with missing indices",
-                                         GetName(gltf_mesh),
-                                         primitive_index);
+    log(Severity::kError).Print("Failed to create mesh primitive {}[{}] with missing indices",
+                                GetName(gltf_mesh),
+                                primitive_index);
     return std::nullopt;  // TODO: add support for non-indexed mesh primitives
   }
 
   if (const auto& staging_material = Get(gltf_material, staging_materials); !staging_material.has_value()) {
-    log(Severity::kError) << std::format("Failed to create mesh primitive {}[{}] with unsupported material",
-                                         GetName(gltf_mesh),
-                                         primitive_index);
+    log(Severity::kError).Print("Failed to create mesh primitive {}[{}] with unsupported material",
+                                GetName(gltf_mesh),
+                                primitive_index);
     return std::nullopt;  // TODO: add support for default materials
   }
 
   return std::visit(
-      [&allocator, &attributes]<typename Indices>(const Indices& indices) {
-        const auto& [position_attribute, normal_attribute, tangent_attribute, texcoord_0_attribute] = attributes;
+      [&attributes, &geometry_arena_layout]<typename Indices>(const Indices& indices) {
         using IndexType = typename Indices::value_type;
-
-        return StagingPrimitive{
-            allocator,
-            StagingPrimitive::CreateInfo<IndexType>{.vertices = CreateVertices(position_attribute.data,
-                                                                               *normal_attribute.data,
-                                                                               *tangent_attribute.data,
-                                                                               *texcoord_0_attribute.data),
-                                                    .indices = indices}};
+        return geometry_arena_layout.Add<IndexType>(GetVertexCount(attributes),
+                                                    static_cast<std::uint32_t>(indices.size()));
       },
       *indices_variant);
 }
 
-StagingModel::Mesh CreateStagingMesh(const vma::Allocator& allocator,
-                                     const gltf::Mesh& gltf_mesh,
+StagingModel::Mesh CreateStagingMesh(const gltf::Mesh& gltf_mesh,
                                      const GltfResourceMap<gltf::Material, StagingModel::Material>& staging_materials,
+                                     GeometryArenaLayout& geometry_arena_layout,
                                      Log& log) {
   return std::views::iota(0uz, gltf_mesh.primitives.size())
-         | std::views::transform([&allocator, &gltf_mesh, &staging_materials, &log](const auto primitive_index) {
-             return CreateStagingPrimitive(allocator, gltf_mesh, primitive_index, staging_materials, log);
-           })
+         | std::views::transform(
+             [&gltf_mesh, &staging_materials, &geometry_arena_layout, &log](const auto primitive_index) {
+               return CreateStagingPrimitive(gltf_mesh,
+                                             primitive_index,
+                                             staging_materials,
+                                             geometry_arena_layout,
+                                             log);
+             })
          | std::ranges::to<std::vector>();
 }
 
 GltfResourceMap<gltf::Mesh, StagingModel::Mesh> CreateStagingMeshes(
-    const vma::Allocator& allocator,
     const std::vector<gltf::UniqueMesh>& gltf_meshes,
     const GltfResourceMap<gltf::Material, StagingModel::Material>& staging_materials,
+    GeometryArenaLayout& geometry_arena_layout,
     Log& log) {
   return gltf_meshes  //
-         | std::views::transform([&allocator, &staging_materials, &log](const auto& gltf_mesh) {
+         | std::views::transform([&staging_materials, &geometry_arena_layout, &log](const auto& gltf_mesh) {
              assert(gltf_mesh != nullptr);  // guaranteed by glTF asset construction
-             return std::pair{gltf_mesh.get(), CreateStagingMesh(allocator, *gltf_mesh, staging_materials, log)};
+             return std::pair{gltf_mesh.get(),
+                              CreateStagingMesh(*gltf_mesh, staging_materials, geometry_arena_layout, log)};
            })
          | std::ranges::to<std::unordered_map>();
 }
 
+// vertex attributes are interleaved directly into mapped staging memory once the arena is sized by its layout
+void WriteStagingMeshes(const GltfResourceMap<gltf::Mesh, StagingModel::Mesh>& staging_meshes,
+                        StagingGeometryArena& staging_geometry_arena) {
+  for (const auto& [gltf_mesh, staging_mesh] : staging_meshes) {
+    for (const auto& [gltf_primitive, primitive_geometry] : std::views::zip(gltf_mesh->primitives, staging_mesh)) {
+      if (!primitive_geometry.has_value()) continue;
+      const auto& [attributes, indices_variant, _] = gltf_primitive;
+      assert(indices_variant.has_value());  // guaranteed by staging primitive creation
+
+      WriteVertices(attributes, staging_geometry_arena.GetVertices(*primitive_geometry, GetVertexCount(attributes)));
+      std::visit(
+          [&staging_geometry_arena, &primitive_geometry]<typename Indices>(const Indices& indices) {
+            using IndexType = typename Indices::value_type;
+            std::ranges::copy(indices, staging_geometry_arena.GetIndices<IndexType>(*primitive_geometry).begin());
+          },
+          *indices_variant);
+    }
+  }
+  staging_geometry_arena.Flush();
+}
+
 // =====================================================================================================================
 // Meshes
 // =====================================================================================================================
 
 using UniqueMesh = std::unique_ptr<const Mesh>;
+using DrawBatch = Model::DrawBatch;
+
+struct DrawBatches {
+  std::map<std::pair<const Material*, vk::IndexType>, std::uint32_t> indices;
+  std::vector<DrawBatch> values;
+};
+
+std::uint32_t GetDrawBatchIndex(const Material& material, const vk::IndexType index_type, DrawBatches& draw_batches) {
+  auto& [draw_batch_indices, draw_batch_values] = draw_batches;
+  const auto draw_batch_index = static_cast<std::uint32_t>(draw_batch_values.size());
+  const auto [iterator, inserted] = draw_batch_indices.try_emplace(std::pair{&material, index_type}, draw_batch_index);
+  if (inserted) {
+    draw_batch_values.push_back(
+        DrawBatch{.material_descriptor_set = material.descriptor_set(), .index_type = index_type});
+  }
+  return iterator->second;
+}
 
 BoundingBox Union(const BoundingBox& lhs, const BoundingBox& rhs) {
   return BoundingBox{.min = glm::min(lhs.min, rhs.min), .max = glm::max(lhs.max, rhs.max)};
 }
 
-UniqueMesh CreateMesh(const vma::Allocator& allocator,
-                      const vk::CommandBuffer command_buffer,
-                      const gltf::Mesh& gltf_mesh,
+UniqueMesh CreateMesh(const gltf::Mesh& gltf_mesh,
                       const StagingModel::Mesh& staging_mesh,
-                      const GltfResourceMap<gltf::Material, UniqueMaterial>& materials) {
+                      const GltfResourceMap<gltf::Material, UniqueMaterial>& materials,
+                      DrawBatches& draw_batches) {
   assert(gltf_mesh.primitives.size() == staging_mesh.size());  // guaranteed by staging mesh construction
 
   std::vector<Primitive> primitives;
   primitives.reserve(gltf_mesh.primitives.size());
 
   BoundingBox bounding_box{.min = glm::vec3{std::numeric_limits<float>::max()},
-                           .max = glm::vec3{std::numeric_limits<float>::min()}};
+                           .max = glm::vec3{std::numeric_limits<float>::lowest()}};
 
   for (const auto& [gltf_primitive, staging_primitive] : std::views::zip(gltf_mesh.primitives, staging_mesh)) {
     if (!staging_primitive.has_value()) continue;  // skip unsupported mesh primitive
@@ -639,24 +784,21 @@ UniqueMesh CreateMesh(const vma::Allocator& allocator,
     const auto& material = Get(gltf_primitive.material, materials);
     assert(material != nullptr);  // guaranteed by staging primitive construction
 
-    primitives.emplace_back(allocator,
-                            command_buffer,
-                            Primitive::CreateInfo{.staging_primitive = *staging_primitive,
-                                                  .material_descriptor_set = material->descriptor_set()});
+    primitives.emplace_back(*staging_primitive,
+                            GetDrawBatchIndex(*material, staging_primitive->index_type, draw_batches));
   }
 
   return primitives.empty() ? nullptr : std::make_unique<Mesh>(std::move(primitives), bounding_box);
 }
 
 GltfResourceMap<gltf::Mesh, UniqueMesh> CreateMeshes(
-    const vma::Allocator& allocator,
-    const vk::CommandBuffer command_buffer,
     const GltfResourceMap<gltf::Mesh, StagingModel::Mesh>& staging_meshes,
-    const GltfResourceMap<gltf::Material, UniqueMaterial>& materials) {
+    const GltfResourceMap<gltf::Material, UniqueMaterial>& materials,
+    DrawBatches& draw_batches) {
   return staging_meshes  //
-         | std::views::transform([&allocator, command_buffer, &materials](const auto& key_value_pair) {
+         | std::views::transform([&materials, &draw_batches](const auto& key_value_pair) {
              const auto& [gltf_mesh, staging_mesh] = key_value_pair;
-             return std::pair{gltf_mesh, CreateMesh(allocator, command_buffer, *gltf_mesh, staging_mesh, materials)};
+             return std::pair{gltf_mesh, CreateMesh(*gltf_mesh, staging_mesh, materials, draw_batches)};
            })
          | std::ranges::to<std::unordered_map>();
 }
@@ -695,38 +837,31 @@ GltfResourceMap<gltf::Light, UniqueLight> CreateLights(const std::vector<gltf::U
 // =====================================================================================================================
 
 using Node = Model::Node;
-using UniqueNode = std::unique_ptr<Node>;
 
-constexpr glm::mat4 kIdentityTransform{1.0f};
+std::vector<Node> CreateNodes(const gltf::Scene& gltf_scene,
+                              const GltfResourceMap<gltf::Mesh, UniqueMesh>& meshes,
+                              const GltfResourceMap<gltf::Light, UniqueLight>& lights,
+                              NodeHierarchy& node_hierarchy) {
+  std::vector<Node> nodes;
+  std::vector<std::pair<const gltf::Node*, std::uint32_t>> pending_nodes;  // glTF nodes paired with a parent index
 
-std::vector<Node*> GetChildren(const gltf::Node& gltf_parent_node,
-                               const GltfResourceMap<gltf::Node, UniqueNode>& nodes) {
-  return gltf_parent_node.children  //
-         | std::views::transform([&nodes](const auto* const gltf_child_node) {
-             assert(gltf_child_node != nullptr);  // guaranteed by glTF node construction
-             const auto& child_node = Get(gltf_child_node, nodes);
-             return child_node.get();
-           })
-         | std::ranges::to<std::vector>();
-}
+  for (const auto* const gltf_root_node : gltf_scene.root_nodes | std::views::reverse) {
+    pending_nodes.emplace_back(gltf_root_node, NodeHierarchy::kNoParent);
+  }
+
+  // nodes are added in depth-first pre-order which guarantees parents are always stored before their children
+  while (!pending_nodes.empty()) {
+    const auto [gltf_node, parent_index] = pending_nodes.back();
+    pending_nodes.pop_back();
+
+    assert(gltf_node != nullptr);  // guaranteed by glTF asset construction
+    const auto& [name, local_transform, gltf_mesh, gltf_light, gltf_children] = *gltf_node;
+    const auto node_index = node_hierarchy.Add(local_transform, parent_index);
+    nodes.emplace_back(Get(gltf_mesh, meshes).get(), Get(gltf_light, lights).get());
 
-GltfResourceMap<gltf::Node, UniqueNode> CreateNodes(const std::vector<gltf::UniqueNode>& gltf_nodes,
-                                                    const GltfResourceMap<gltf::Mesh, UniqueMesh>& meshes,
-                                                    const GltfResourceMap<gltf::Light, UniqueLight>& lights) {
-  auto nodes =
-      gltf_nodes  //
-      | std::views::transform([&meshes, &lights](const auto& gltf_node) {
-          assert(gltf_node != nullptr);  // guaranteed by glTF asset construction
-          const auto& [name, local_transform, gltf_mesh, gltf_light, _] = *gltf_node;
-          const auto& mesh = Get(gltf_mesh, meshes);
-          const auto& light = Get(gltf_light, lights);
-          return std::pair{gltf_node.get(),
-                           std::make_unique<Node>(local_transform, kIdentityTransform, mesh.get(), light.get())};
-        })
-      | std::ranges::to<std::unordered_map>();
-
-  for (auto& [gltf_node, node] : nodes) {
-    node->children = GetChildren(*gltf_node, nodes);  // assign children after all nodes have been created
+    for (const auto* const gltf_child_node : gltf_children | std::views::reverse) {
+      pending_nodes.emplace_back(gltf_child_node, node_index);
+    }
   }
 
   return nodes;
@@ -743,102 +878,96 @@ const gltf::Scene& GetDefaultGltfScene(const gltf::Asset& gltf_asset) {
   throw std::runtime_error{std::format("Failed to get the default scene for glTF asset {}", gltf_asset.name)};
 }
 
-std::vector<Node*> GetRootNodes(const gltf::Scene& gltf_scene, const GltfResourceMap<gltf::Node, UniqueNode>& nodes) {
-  return gltf_scene.root_nodes  //
-         | std::views::transform([&nodes](const auto* const gltf_node) {
-             assert(gltf_node != nullptr);  // guaranteed by glTF asset construction
-             const auto& root_node = Get(gltf_node, nodes);
-             return root_node.get();
-           })
-         | std::ranges::to<std::vector>();
-}
-
-// =====================================================================================================================
-// Rendering
-// =====================================================================================================================
+}  // namespace
 
-void Render(const Mesh& mesh,
-            const glm::mat4& model_transform,
-            const vk::CommandBuffer command_buffer,
-            const vk::PipelineLayout pipeline_layout,
-            const ViewFrustum& view_frustum) {
-  if (const auto& world_bounding_box = Transform(mesh.bounding_box(), model_transform);
-      !view_frustum.Intersects(world_bounding_box)) {
-    return;  // skip mesh primitive outside the view frustum
+StagingTextureFutures CreateStagingTexturesAsync(const vma::Allocator& allocator,
+                                                 const gltf::Asset& gltf_asset,
+                                                 const vk::PhysicalDeviceFeatures& physical_device_features,
+                                                 ThreadPool& thread_pool,
+                                                 Log& log) {
+  // futures are inserted as they are submitted so tasks submitted before an exception is thrown are still waited on
+  StagingTextureFutures staging_texture_futures;
+  const auto material_textures = GetMaterialTextures(gltf_asset);
+
+  for (const auto& gltf_texture : gltf_asset.textures) {
+    assert(gltf_texture != nullptr);  // guaranteed by glTF asset construction
+    const auto* const gltf_texture_ptr = gltf_texture.get();
+    if (!material_textures.contains(gltf_texture_ptr)) continue;
+
+    auto future = thread_pool.Submit([&allocator, gltf_texture_ptr, &physical_device_features, &log] {
+      return CreateStagingTexture(allocator, gltf_texture_ptr, physical_device_features, log);
+    });
+    staging_texture_futures.futures_.emplace(gltf_texture_ptr, future.share());
   }
 
-  using ModelTransform = decltype(GraphicsPipeline::PushConstants::model_transform);
-  command_buffer.pushConstants<ModelTransform>(pipeline_layout,
-                                               vk::ShaderStageFlagBits::eVertex,
-                                               offsetof(GraphicsPipeline::PushConstants, model_transform),
-                                               model_transform);
-
-  for (const auto& primitive : mesh.primitives()) {
-    // TODO: avoid per-primitive material descriptor set binding
-    command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                                      pipeline_layout,
-                                      1,
-                                      primitive.material_descriptor_set(),
-                                      nullptr);
-    primitive.Render(command_buffer);
-  }
+  return staging_texture_futures;
 }
 
-void Render(const Node& node,
-            const vk::CommandBuffer command_buffer,
-            const vk::PipelineLayout pipeline_layout,
-            const ViewFrustum& view_frustum) {
-  if (const auto* const mesh = node.mesh; mesh != nullptr) {
-    Render(*mesh, node.global_transform, command_buffer, pipeline_layout, view_frustum);
-  }
+StagingTextureFutures::StagingTextureFutures(StagingTextureFutures&& staging_texture_futures) noexcept
+    : futures_{std::exchange(staging_texture_futures.futures_, {})} {}
 
-  for (const auto& child_node : node.children) {
-    assert(child_node != nullptr);  // guaranteed by node construction
-    Render(*child_node, command_buffer, pipeline_layout, view_frustum);
+StagingTextureFutures& StagingTextureFutures::operator=(StagingTextureFutures&& staging_texture_futures) noexcept {
+  if (this != &staging_texture_futures) {
+    Wait();
+    futures_ = std::exchange(staging_texture_futures.futures_, {});
   }
+  return *this;
 }
 
-}  // namespace
+StagingTextureFutures::~StagingTextureFutures() noexcept { Wait(); }
+
+const StagingTextureFuture* StagingTextureFutures::Find(const gltf::Texture* const gltf_texture) const noexcept {
+  const auto iterator = futures_.find(gltf_texture);
+  return iterator == futures_.cend() ? nullptr : &iterator->second;
+}
+
+void StagingTextureFutures::Wait() const noexcept {
+  for (const auto& future : futures_ | std::views::values) {
+    future.wait();
+  }
+}
 
 StagingModel::StagingModel(const vma::Allocator& allocator, const CreateInfo& create_info) {
-  const auto& [gltf_asset, physical_device_features, log] = create_info;
-  const auto ktx_texture_futures = CreateKtxTexturesAsync(gltf_asset.textures, physical_device_features, log);
-  materials_ = CreateStagingMaterials(allocator, gltf_asset.materials, ktx_texture_futures, log);
-  meshes_ = CreateStagingMeshes(allocator, gltf_asset.meshes, materials_, log);
+  const auto& [gltf_asset, staging_textures, log] = create_info;
+  materials_ = CreateStagingMaterials(allocator, gltf_asset.materials, staging_textures, log);
+
+  GeometryArenaLayout geometry_arena_layout;
+  meshes_ = CreateStagingMeshes(gltf_asset.meshes, materials_, geometry_arena_layout, log);
+  geometry_arena_.emplace(allocator, geometry_arena_layout);
+  WriteStagingMeshes(meshes_, *geometry_arena_);
 }
 
 Model::Model(const vma::Allocator& allocator, const vk::CommandBuffer command_buffer, const CreateInfo& create_info)
     : material_descriptor_pool_{CreateMaterialDescriptorPool(allocator.device(),
                                                              create_info.staging_model.materials(),
                                                              create_info.material_descriptor_set_layout)} {
-  const auto& [gltf_asset, staging_model, material_descriptor_set_layout, sampler_anisotropy] = create_info;
+  const auto& [gltf_asset, staging_model, material_descriptor_set_layout, sampler_anisotropy, queue_family_indices] =
+      create_info;
   const auto& device = allocator.device();
   const auto& staging_materials = staging_model.materials();
   const auto& staging_meshes = staging_model.meshes();
   const auto& material_descriptor_sets = material_descriptor_pool_->descriptor_sets();
 
   auto samplers = CreateSamplers(device, gltf_asset.samplers, sampler_anisotropy);
-  auto materials = CreateMaterials(allocator, command_buffer, staging_materials, samplers, material_descriptor_sets);
-  auto meshes = CreateMeshes(allocator, command_buffer, staging_meshes, materials);
+  auto materials = CreateMaterials(allocator,
+                                   command_buffer,
+                                   staging_materials,
+                                   samplers,
+                                   material_descriptor_sets,
+                                   queue_family_indices);
+  geometry_arena_.emplace(allocator, command_buffer, staging_model.geometry_arena(), queue_family_indices);
+  DrawBatches draw_batches;
+  auto meshes = CreateMeshes(staging_meshes, materials, draw_batches);
   auto lights = CreateLights(gltf_asset.lights);
-  auto nodes = CreateNodes(gltf_asset.nodes, meshes, lights);
-
   const auto& gltf_scene = GetDefaultGltfScene(gltf_asset);
-  root_nodes_ = GetRootNodes(gltf_scene, nodes);
+  nodes_ = CreateNodes(gltf_scene, meshes, lights, node_hierarchy_);
+  node_hierarchy_.Update();
+
   samplers_ = GetValues(std::move(samplers));
   materials_ = GetValues(std::move(materials));
+  draw_batches_ = std::move(draw_batches.values);
   meshes_ = GetValues(std::move(meshes));
   lights_ = GetValues(std::move(lights));
-  nodes_ = GetValues(std::move(nodes));
-}
-
-void Model::Render(const vk::CommandBuffer command_buffer,
-                   const vk::PipelineLayout pipeline_layout,
-                   const ViewFrustum& view_frustum) const {
-  for (const auto* const root_node : root_nodes_) {
-    assert(root_node != nullptr);  // guaranteed by root node construction
-    vktf::Render(*root_node, command_buffer, pipeline_layout, view_frustum);
-  }
 }
 
 }  // namespace vktf
@@ -0,0 +1,239 @@
+module;
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+export module node_hierarchy;
+
+import thread_pool;
+
+namespace vktf {
+
+/**
+ * @brief A hierarchy of node transforms stored in contiguous, topologically sorted arrays.
+ * @details Nodes are identified by their index and must be added after their parent which guarantees a parent's global
+ *          transform is always updated before any of its children. This allows global transforms to be propagated with
+ *          a single linear pass over the hierarchy rather than recursively traversing pointers to heap-allocated nodes.
+ *          Local transforms, global transforms, and parent indices are stored in separate arrays so the propagation
+ *          pass only reads and writes the data it needs. Nodes are marked dirty when their local transform changes and
+ *          only dirty nodes and their descendants are updated which makes updating a static hierarchy nearly free.
+ *          The hierarchy is also divided into contiguous segments where no node has a parent in an earlier segment
+ *          (e.g., the subtree of each root node when nodes are added in depth-first pre-order) which allows disjoint
+ *          segments to be updated concurrently.
+ * @code
+ * vktf::NodeHierarchy node_hierarchy;
+ * const auto parent_index = node_hierarchy.Add(glm::translate(glm::mat4{1.0f}, glm::vec3{1.0f, 0.0f, 0.0f}));
+ * const auto child_index = node_hierarchy.Add(glm::mat4{1.0f}, parent_index);
+ * assert(node_hierarchy.Update());
+ * assert(node_hierarchy.global_transforms()[child_index] == node_hierarchy.global_transforms()[parent_index]);
+ * assert(!node_hierarchy.Update());
+ * @endcode
+ */
+export class [[nodiscard]] NodeHierarchy {
+public:
+  /** @brief The parent index for root nodes. */
+  static constexpr auto kNoParent = std::numeric_limits<std::uint32_t>::max();
+
+  /** @brief Gets the number of nodes in the hierarchy. */
+  [[nodiscard]] std::size_t size() const noexcept { return parent_indices_.size(); }
+
+  /** @brief Gets the parent index for each node or @ref NodeHierarchy::kNoParent for root nodes. */
+  [[nodiscard]] const std::vector<std::uint32_t>& parent_indices() const noexcept { return parent_indices_; }
+
+  /**
+   * @brief Gets the index of the first node in each segment that can be updated independently of all other segments.
+   * @note Segment offsets are sorted in ascending order and always begin with zero for a non-empty hierarchy.
+   */
+  [[nodiscard]] const std::vector<std::uint32_t>& segment_offsets() const noexcept { return segment_offsets_; }
+
+  /** @brief Gets the local transform for each node relative to its parent. */
+  [[nodiscard]] const std::vector<glm::mat4>& local_transforms() const noexcept { return local_transforms_; }
+
+  /**
+   * @brief Gets the global transform for each node.
+   * @note Global transforms are calculated by @ref NodeHierarchy::Update.
+   */
+  [[nodiscard]] const std::vector<glm::mat4>& global_transforms() const noexcept { return global_transforms_; }
+
+  /**
+   * @brief Tests if a node's global transform was recalculated by the most recent call to @ref NodeHierarchy::Update.
+   * @param node_index The index of the node to test.
+   * @return @c true if the node or one of its ancestors was dirty when the hierarchy was last updated.
+   */
+  [[nodiscard]] bool updated(const std::uint32_t node_index) const noexcept { return updated_[node_index] != 0; }
+
+  /**
+   * @brief Reserves storage for a number of nodes.
+   * @param capacity The number of nodes to reserve storage for.
+   */
+  void Reserve(std::size_t capacity);
+
+  /**
+   * @brief Adds a node to the hierarchy.
+   * @param local_transform The node transform relative to its parent.
+   * @param parent_index The index of a previously added parent node or @ref NodeHierarchy::kNoParent for root nodes.
+   * @return The index of the added node.
+   */
+  std::uint32_t Add(const glm::mat4& local_transform, std::uint32_t parent_index = kNoParent);
+
+  /**
+   * @brief Sets the local transform for a node and marks its subtree for update.
+   * @param node_index The index of the node to update.
+   * @param local_transform The node transform relative to its parent.
+   */
+  void SetLocalTransform(std::uint32_t node_index, const glm::mat4& local_transform);
+
+  /**
+   * @brief Sets the transform applied to all root nodes and marks the entire hierarchy for update.
+   * @param root_transform The transform applied to all root nodes.
+   */
+  void SetRootTransform(const glm::mat4& root_transform);
+
+  /**
+   * @brief Updates the global transform for each dirty node and its descendants.
+   * @return @c true if any global transform was updated, otherwise @c false.
+   */
+  bool Update();
+
+  /**
+   * @brief Updates the global transform for each dirty node and its descendants on a thread pool.
+   * @details Dirty nodes are divided into groups of consecutive segments with similar node counts that are updated in
+   *          separate tasks. Because each node is updated with the same operations as @ref NodeHierarchy::Update, the
+   *          results are identical to a serial update regardless of how nodes are divided between tasks.
+   * @param thread_pool The thread pool for executing update tasks.
+   * @return Futures for each update task which are empty if no global transform needs to be updated.
+   * @warning The caller is responsible for waiting on all returned futures before accessing or modifying the hierarchy.
+   */
+  [[nodiscard]] std::vector<std::future<void>> UpdateAsync(ThreadPool& thread_pool);
+
+private:
+  void MarkDirty(std::size_t node_index) noexcept;
+  [[nodiscard]] std::size_t BeginUpdate();
+  void Update(std::size_t first_index, std::size_t last_index);
+
+  std::vector<std::uint32_t> parent_indices_;
+  std::vector<std::uint32_t> segment_offsets_;
+  std::vector<glm::mat4> local_transforms_;
+  std::vector<glm::mat4> global_transforms_;
+  std::vector<std::uint8_t> dirty_;    // nodes whose local transform changed since the last update
+  std::vector<std::uint8_t> updated_;  // nodes whose global transform changed in the last update
+  std::size_t first_dirty_index_ = 0;    // equal to size() when no nodes are dirty
+  std::size_t first_updated_index_ = 0;  // equal to size() when no nodes were updated
+  glm::mat4 root_transform_{1.0f};
+};
+
+}  // namespace vktf
+
+module :private;
+
+namespace vktf {
+
+void NodeHierarchy::Reserve(const std::size_t capacity) {
+  parent_indices_.reserve(capacity);
+  local_transforms_.reserve(capacity);
+  global_transforms_.reserve(capacity);
+  dirty_.reserve(capacity);
+  updated_.reserve(capacity);
+}
+
+std::uint32_t NodeHierarchy::Add(const glm::mat4& local_transform, const std::uint32_t parent_index) {
+  assert(parent_index == kNoParent || parent_index < size());  // parents must be added before their children
+  const auto node_index = static_cast<std::uint32_t>(size());
+
+  // a child invalidates every segment after its parent because those segments now depend on an earlier node
+  if (parent_index == kNoParent) {
+    segment_offsets_.push_back(node_index);
+  } else {
+    while (segment_offsets_.back() > parent_index) segment_offsets_.pop_back();
+  }
+
+  parent_indices_.push_back(parent_index);
+  local_transforms_.push_back(local_transform);
+  global_transforms_.push_back(local_transform);
+  dirty_.push_back(0);
+  updated_.push_back(0);
+  MarkDirty(node_index);
+  return node_index;
+}
+
+void NodeHierarchy::SetLocalTransform(const std::uint32_t node_index, const glm::mat4& local_transform) {
+  assert(node_index < size());
+  local_transforms_[node_index] = local_transform;
+  MarkDirty(node_index);
+}
+
+void NodeHierarchy::SetRootTransform(const glm::mat4& root_transform) {
+  root_transform_ = root_transform;
+  std::ranges::fill(dirty_, 1);
+  first_dirty_index_ = 0;
+}
+
+bool NodeHierarchy::Update() {
+  const auto first_dirty_index = BeginUpdate();
+  if (first_dirty_index == size()) return false;
+
+  Update(first_dirty_index, size());
+  return true;
+}
+
+std::vector<std::future<void>> NodeHierarchy::UpdateAsync(ThreadPool& thread_pool) {
+  const auto first_dirty_index = BeginUpdate();
+  if (first_dirty_index == size()) return {};
+
+  // small tasks are avoided because the cost of scheduling a task exceeds the cost of updating a few nodes
+  static constexpr auto kMinTaskNodeCount = 4'096uz;
+  auto segment_offset = std::ranges::upper_bound(segment_offsets_, first_dirty_index);
+  const auto first_index = static_cast<std::size_t>(*std::prev(segment_offset));
+  const auto task_node_count = std::max(kMinTaskNodeCount, (size() - first_index) / thread_pool.thread_count());
+
+  std::vector<std::future<void>> update_futures;
+  for (auto task_first_index = first_index; task_first_index < size();) {
+    const auto task_target_index = task_first_index + task_node_count;
+    segment_offset = std::ranges::lower_bound(segment_offset, segment_offsets_.end(), task_target_index);
+    const auto task_last_index = segment_offset == segment_offsets_.end() ? size() : *segment_offset;
+    update_futures.push_back(thread_pool.Submit([this, task_first_index, task_last_index] {
+      Update(task_first_index, task_last_index);
+    }));
+    task_first_index = task_last_index;
+  }
+
+  return update_futures;
+}
+
+void NodeHierarchy::MarkDirty(const std::size_t node_index) noexcept {
+  dirty_[node_index] = 1;
+  first_dirty_index_ = std::min(first_dirty_index_, node_index);
+}
+
+std::size_t NodeHierarchy::BeginUpdate() {
+  // reset flags from the previous update which only needs to visit the range of nodes that were updated
+  std::ranges::fill(updated_.begin() + static_cast<std::ptrdiff_t>(first_updated_index_), updated_.end(), 0);
+  first_updated_index_ = first_dirty_index_;
+  return std::exchange(first_dirty_index_, size());
+}
+
+void NodeHierarchy::Update(const std::size_t first_index, const std::size_t last_index) {
+  // a node must be updated if it's dirty or if its parent was updated which is always known in advance because parents
+  // are stored before their children and never stored in an earlier segment
+  for (auto node_index = first_index; node_index < last_index; ++node_index) {
+    const auto parent_index = parent_indices_[node_index];
+    const auto is_root = parent_index == kNoParent;
+    if (dirty_[node_index] == 0 && (is_root || updated_[parent_index] == 0)) continue;
+
+    const auto& parent_transform = is_root ? root_transform_ : global_transforms_[parent_index];
+    global_transforms_[node_index] = parent_transform * local_transforms_[node_index];
+    dirty_[node_index] = 0;
+    updated_[node_index] = 1;
+  }
+}
+
+}  // namespace vktf
@@ -95,18 +95,26 @@ bool HasRequiredExtensions(const vk::PhysicalDevice physical_device,
   });
 }
 
+bool IsDedicatedTransferQueueFamily(const vk::QueueFlags queue_flags) {
+  return (queue_flags & vk::QueueFlagBits::eTransfer)
+         && !(queue_flags & (vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute));
+}
+
 std::optional<QueueFamilies> FindQueueFamilies(const vk::PhysicalDevice physical_device, const vk::SurfaceKHR surface) {
+  std::optional<QueueFamily> combined_queue_family;
   std::optional<QueueFamily> graphics_queue_family;
   std::optional<QueueFamily> present_queue_family;
+  std::optional<QueueFamily> transfer_queue_family;
 
   for (std::uint32_t index = 0; const auto& queue_family_properties : physical_device.getQueueFamilyProperties()) {
     assert(queue_family_properties.queueCount > 0);  // required by the Vulkan specification
     const QueueFamily queue_family{.index = index++, .queue_count = queue_family_properties.queueCount};
-    const auto has_graphics_support = queue_family_properties.queueFlags & vk::QueueFlagBits::eGraphics;
+    const auto queue_flags = queue_family_properties.queueFlags;
+    const auto has_graphics_support = queue_flags & vk::QueueFlagBits::eGraphics;
     const auto has_present_support = physical_device.getSurfaceSupportKHR(queue_family.index, surface) == vk::True;
 
-    if (has_graphics_support && has_present_support) {  // prefer combined graphics and present queue family
-      return QueueFamilies{.graphics_family = queue_family, .present_family = queue_family};
+    if (!combined_queue_family.has_value() && has_graphics_support && has_present_support) {
+      combined_queue_family = queue_family;
     }
     if (!graphics_queue_family.has_value() && has_graphics_support) {
       graphics_queue_family = queue_family;
@@ -114,13 +122,24 @@ std::optional<QueueFamilies> FindQueueFamilies(const vk::PhysicalDevice physical
     if (!present_queue_family.has_value() && has_present_support) {
       present_queue_family = queue_family;
     }
+    // dedicated transfer queue families typically map to DMA engines that copy data concurrently with graphics work
+    if (!transfer_queue_family.has_value() && IsDedicatedTransferQueueFamily(queue_flags)) {
+      transfer_queue_family = queue_family;
+    }
+  }
+
+  if (combined_queue_family.has_value()) {  // prefer combined graphics and present queue family
+    graphics_queue_family = present_queue_family = combined_queue_family;
   }
 
   if (!graphics_queue_family.has_value() || !present_queue_family.has_value()) {
     return std::nullopt;
   }
 
-  return QueueFamilies{.graphics_family = *graphics_queue_family, .present_family = *present_queue_family};
+  // graphics queue families implicitly support transfer operations
+  return QueueFamilies{.graphics_family = *graphics_queue_family,
+                       .present_family = *present_queue_family,
+                       .transfer_family = transfer_queue_family.value_or(*graphics_queue_family)};
 }
 
 RankedPhysicalDevice GetRankedPhysicalDevice(const vk::PhysicalDevice physical_device,
@@ -0,0 +1,342 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <ios>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+export module pipeline_cache;
+
+import hash;
+import log;
+
+namespace vktf {
+
+/**
+ * @brief A persistent Vulkan pipeline cache.
+ * @details The pipeline cache is loaded from disk on creation and written back on destruction which allows pipelines
+ *          created in previous runs to skip driver compilation. Cache files are discarded when the cache format
+ *          version, physical device, driver version, or pipeline cache UUID changes or when the cached data is
+ *          corrupted. Each pipeline is created with pipeline creation feedback to report cache hits and the estimated
+ *          time saved.
+ * @see https://registry.khronos.org/vulkan/specs/latest/man/html/VkPipelineCache.html VkPipelineCache
+ */
+export class [[nodiscard]] PipelineCache {
+public:
+  /** @brief The parameters for creating a @ref PipelineCache. */
+  struct [[nodiscard]] CreateInfo {
+    /** @brief The physical device for validating cache files against the device and driver that created them. */
+    vk::PhysicalDevice physical_device;
+
+    /** @brief The cache filepath to read from and write to whose parent directory is created if it does not exist. */
+    std::filesystem::path cache_filepath;
+
+    /**
+     * @brief The log for writing messages when reading, writing, and creating pipelines with the pipeline cache.
+     * @warning The caller is responsible for ensuring the log outlives the pipeline cache.
+     */
+    Log& log;
+  };
+
+  /**
+   * @brief Creates a @ref PipelineCache.
+   * @details If a valid cache file does not exist at @ref PipelineCache::CreateInfo::cache_filepath, an empty pipeline
+   *          cache is created instead. Failing to read a cache file is not an error and only results in pipelines
+   *          being compiled by the driver again.
+   * @param device The device for creating the pipeline cache.
+   * @param create_info @copybrief PipelineCache::CreateInfo
+   */
+  PipelineCache(vk::Device device, const CreateInfo& create_info);
+
+  PipelineCache(const PipelineCache&) = delete;
+  PipelineCache(PipelineCache&&) noexcept = delete;
+
+  PipelineCache& operator=(const PipelineCache&) = delete;
+  PipelineCache& operator=(PipelineCache&&) noexcept = delete;
+
+  /**
+   * @brief Destroys a @ref PipelineCache.
+   * @details Writes the pipeline cache to disk if any pipeline was compiled by the driver since the cache was loaded.
+   *          Pipelines created without valid pipeline creation feedback only cause the cache to be written if the
+   *          driver changed the pipeline cache data. Failing to write a cache file is logged as a warning.
+   */
+  ~PipelineCache() noexcept;
+
+  /** @brief Gets the underlying Vulkan pipeline cache handle. */
+  [[nodiscard]] vk::PipelineCache operator*() const noexcept { return *pipeline_cache_; }
+
+  /** @brief Gets the number of pipelines created by this pipeline cache that did not require driver compilation. */
+  [[nodiscard]] std::uint32_t hit_count() const noexcept { return hit_count_; }
+
+  /** @brief Gets the number of pipelines created by this pipeline cache that required driver compilation. */
+  [[nodiscard]] std::uint32_t miss_count() const noexcept { return miss_count_; }
+
+  /** @brief Gets the number of pipelines created by this pipeline cache without valid pipeline creation feedback. */
+  [[nodiscard]] std::uint32_t unknown_count() const noexcept { return unknown_count_; }
+
+  /**
+   * @brief Creates a graphics pipeline with the pipeline cache.
+   * @param graphics_pipeline_create_info The parameters for creating the graphics pipeline.
+   * @return The created graphics pipeline.
+   * @throws std::runtime_error Thrown if the graphics pipeline could not be created.
+   * @note This function is thread-safe and may be called concurrently to create multiple pipelines.
+   */
+  [[nodiscard]] vk::UniquePipeline CreateGraphicsPipeline(
+      const vk::GraphicsPipelineCreateInfo& graphics_pipeline_create_info);
+
+private:
+  using Duration = std::chrono::nanoseconds;
+
+  void Write() const;
+
+  vk::Device device_;
+  vk::PhysicalDeviceProperties physical_device_properties_;
+  std::filesystem::path cache_filepath_;
+  Log& log_;
+  vk::UniquePipelineCache pipeline_cache_;
+  Duration prev_miss_duration_{0};  // the total pipeline compilation time recorded by previous runs
+  std::uint64_t prev_miss_count_ = 0;
+  std::uint64_t prev_data_hash_ = 0;  // the hash of the pipeline cache data loaded from the cache file
+  std::atomic<std::uint32_t> hit_count_ = 0;
+  std::atomic<std::uint32_t> miss_count_ = 0;
+  std::atomic<std::uint32_t> unknown_count_ = 0;
+  std::atomic<Duration::rep> hit_duration_ = 0;
+  std::atomic<Duration::rep> miss_duration_ = 0;
+};
+
+}  // namespace vktf
+
+module :private;
+
+namespace vktf {
+
+namespace {
+
+using Severity = Log::Severity;
+
+constexpr std::uint64_t kMagic = 0x4550495046544B56;  // "VKTFPIPE" in little-endian byte order
+constexpr std::uint32_t kVersion = 1;                 // increment when the cache file format changes
+
+// Vulkan validates its own pipeline cache header but some drivers fail to reject incompatible data which is why cache
+// files are also validated against the driver version and checksummed before being passed to the driver
+struct CacheHeader {
+  std::uint64_t magic = 0;
+  std::uint32_t version = 0;
+  std::uint32_t vendor_id = 0;
+  std::uint32_t device_id = 0;
+  std::uint32_t driver_version = 0;
+  std::array<std::uint8_t, vk::UuidSize> pipeline_cache_uuid{};
+  std::uint64_t data_size = 0;
+  std::uint64_t data_hash = 0;
+  std::uint64_t miss_count = 0;       // the total number of pipelines compiled while building the cache
+  std::int64_t miss_duration_ns = 0;  // the total time spent compiling pipelines while building the cache
+};
+
+static_assert(sizeof(CacheHeader) == 72);  // cache headers are written without padding bytes
+
+CacheHeader CreateCacheHeader(const vk::PhysicalDeviceProperties& physical_device_properties) {
+  CacheHeader cache_header{.magic = kMagic,
+                           .version = kVersion,
+                           .vendor_id = physical_device_properties.vendorID,
+                           .device_id = physical_device_properties.deviceID,
+                           .driver_version = physical_device_properties.driverVersion};
+  std::ranges::copy(physical_device_properties.pipelineCacheUUID, cache_header.pipeline_cache_uuid.begin());
+  return cache_header;
+}
+
+bool IsCompatible(const CacheHeader& cache_header, const CacheHeader& expected_cache_header) {
+  return cache_header.magic == expected_cache_header.magic && cache_header.version == expected_cache_header.version
+         && cache_header.vendor_id == expected_cache_header.vendor_id
+         && cache_header.device_id == expected_cache_header.device_id
+         && cache_header.driver_version == expected_cache_header.driver_version
+         && cache_header.pipeline_cache_uuid == expected_cache_header.pipeline_cache_uuid;
+}
+
+std::vector<std::byte> ReadCacheFile(const std::filesystem::path& cache_filepath) {
+  std::ifstream ifstream{cache_filepath, std::ios::binary};
+  if (!ifstream) throw std::runtime_error{std::format("Failed to open {}", cache_filepath.string())};
+  const auto size_bytes = std::filesystem::file_size(cache_filepath);
+
+  std::vector<std::byte> bytes(size_bytes);
+  ifstream.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  if (!ifstream) throw std::runtime_error{std::format("Failed to read {}", cache_filepath.string())};
+  return bytes;
+}
+
+void WriteCacheFile(const std::filesystem::path& cache_filepath,
+                    const CacheHeader& cache_header,
+                    const std::span<const std::uint8_t> data) {
+  std::filesystem::create_directories(cache_filepath.parent_path());
+
+  // write to a temporary file first so that an interrupted write never leaves a partially written cache file
+  auto temporary_filepath = cache_filepath;
+  temporary_filepath += ".tmp";
+  {
+    std::ofstream ofstream{temporary_filepath, std::ios::binary | std::ios::trunc};
+    ofstream.write(reinterpret_cast<const char*>(&cache_header), sizeof(CacheHeader));
+    ofstream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!ofstream) throw std::runtime_error{std::format("Failed to write {}", temporary_filepath.string())};
+  }
+  std::filesystem::rename(temporary_filepath, cache_filepath);
+}
+
+std::optional<CacheHeader> ReadCacheHeader(const std::span<const std::byte> bytes,
+                                           const CacheHeader& expected_cache_header) {
+  if (bytes.size() < sizeof(CacheHeader)) return std::nullopt;
+
+  CacheHeader cache_header;
+  std::memcpy(&cache_header, bytes.data(), sizeof(CacheHeader));
+  if (!IsCompatible(cache_header, expected_cache_header)) return std::nullopt;
+
+  const auto data = bytes.subspan(sizeof(CacheHeader));
+  if (cache_header.data_size != data.size() || cache_header.data_hash != Hash(data)) return std::nullopt;
+  return cache_header;
+}
+
+double ToMilliseconds(const std::chrono::nanoseconds duration) {
+  return std::chrono::duration<double, std::milli>{duration}.count();
+}
+
+}  // namespace
+
+PipelineCache::PipelineCache(const vk::Device device, const CreateInfo& create_info)
+    : device_{device},
+      physical_device_properties_{create_info.physical_device.getProperties()},
+      cache_filepath_{create_info.cache_filepath},
+      log_{create_info.log} {
+  std::vector<std::byte> cache_data;
+
+  if (std::error_code error_code; std::filesystem::exists(cache_filepath_, error_code)) {
+    try {
+      auto bytes = ReadCacheFile(cache_filepath_);
+      if (const auto cache_header = ReadCacheHeader(bytes, CreateCacheHeader(physical_device_properties_));
+          cache_header.has_value()) {
+        prev_miss_count_ = cache_header->miss_count;
+        prev_miss_duration_ = Duration{cache_header->miss_duration_ns};
+        prev_data_hash_ = cache_header->data_hash;
+        bytes.erase(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(sizeof(CacheHeader)));
+        cache_data = std::move(bytes);
+      } else {
+        log_(Severity::kInfo).Print("Discarding stale pipeline cache file {}", cache_filepath_.string());
+      }
+    } catch (const std::exception& exception) {
+      log_(Severity::kWarning).Print("Failed to read pipeline cache file {} with error {}",
+                                     cache_filepath_.string(),
+                                     exception.what());
+    }
+  }
+
+  pipeline_cache_ = device_.createPipelineCacheUnique(
+      vk::PipelineCacheCreateInfo{.initialDataSize = cache_data.size(), .pInitialData = cache_data.data()});
+}
+
+PipelineCache::~PipelineCache() noexcept {
+  const auto hit_count = hit_count_.load();
+  const auto miss_count = miss_count_.load();
+  const auto unknown_count = unknown_count_.load();
+  if (const auto pipeline_count = hit_count + miss_count + unknown_count; pipeline_count > 0) {
+    // pipelines without valid feedback are excluded from the hit rate because their cache result is unknown
+    const auto known_pipeline_count = hit_count + miss_count;
+    const auto hit_rate = known_pipeline_count == 0 ? 0.0 : 100.0 * hit_count / known_pipeline_count;
+
+    // time saved is estimated by comparing pipeline cache hits to the average compilation time of pipeline cache misses
+    const auto total_miss_count = prev_miss_count_ + miss_count;
+    const auto total_miss_duration = prev_miss_duration_ + Duration{miss_duration_.load()};
+    const auto avg_miss_duration =
+        total_miss_count == 0 ? Duration{0} : total_miss_duration / static_cast<Duration::rep>(total_miss_count);
+    const auto saved_duration = avg_miss_duration * hit_count - Duration{hit_duration_.load()};
+
+    log_(Severity::kInfo).Print(
+        "Created {} pipelines with {} pipeline cache hits, {} misses, and {} unknown results ({:.1f}% hit rate) saving "
+        "about {:.2f} ms",
+        pipeline_count,
+        hit_count,
+        miss_count,
+        unknown_count,
+        hit_rate,
+        ToMilliseconds(std::max(saved_duration, Duration{0})));
+  }
+
+  // the pipeline cache only changes when the driver compiles a new pipeline which is unknown without valid feedback
+  if (miss_count == 0 && unknown_count == 0) return;
+
+  try {
+    Write();
+  } catch (const std::exception& exception) {
+    log_(Severity::kWarning).Print("Failed to write pipeline cache file {} with error {}",
+                                   cache_filepath_.string(),
+                                   exception.what());
+  }
+}
+
+vk::UniquePipeline PipelineCache::CreateGraphicsPipeline(
+    const vk::GraphicsPipelineCreateInfo& graphics_pipeline_create_info) {
+  vk::PipelineCreationFeedback pipeline_creation_feedback;
+  const vk::PipelineCreationFeedbackCreateInfo pipeline_creation_feedback_create_info{
+      .pNext = graphics_pipeline_create_info.pNext,
+      .pPipelineCreationFeedback = &pipeline_creation_feedback};
+
+  auto feedback_graphics_pipeline_create_info = graphics_pipeline_create_info;
+  feedback_graphics_pipeline_create_info.pNext = &pipeline_creation_feedback_create_info;
+
+  const auto start_time = std::chrono::steady_clock::now();
+  auto [result, graphics_pipeline] =
+      device_.createGraphicsPipelineUnique(*pipeline_cache_, feedback_graphics_pipeline_create_info);
+  vk::detail::resultCheck(result, "Graphics pipeline creation failed");
+
+  // driver-reported durations are preferred because they exclude time spent in validation layers
+  using enum vk::PipelineCreationFeedbackFlagBits;
+  const auto is_feedback_valid = (pipeline_creation_feedback.flags & eValid) == eValid;
+  const auto duration = is_feedback_valid
+                            ? Duration{pipeline_creation_feedback.duration}
+                            : std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now() - start_time);
+
+  // pipelines without valid feedback are counted separately to avoid skewing hit rates and average compilation times
+  const auto is_hit = is_feedback_valid && (pipeline_creation_feedback.flags & eApplicationPipelineCacheHit);
+  if (!is_feedback_valid) {
+    ++unknown_count_;
+  } else if (is_hit) {
+    ++hit_count_;
+    hit_duration_ += duration.count();
+  } else {
+    ++miss_count_;
+    miss_duration_ += duration.count();
+  }
+
+  log_(Severity::kInfo).Print("Created graphics pipeline in {:.2f} ms with a pipeline cache {}",
+                              ToMilliseconds(duration),
+                              is_feedback_valid ? (is_hit ? "hit" : "miss") : "result unavailable");
+
+  return std::move(graphics_pipeline);  // return value optimization not available here
+}
+
+void PipelineCache::Write() const {
+  const auto data = device_.getPipelineCacheData(*pipeline_cache_);
+
+  auto cache_header = CreateCacheHeader(physical_device_properties_);
+  cache_header.data_size = data.size();
+  cache_header.data_hash = Hash(std::as_bytes(std::span{data}));
+  if (cache_header.data_hash == prev_data_hash_) return;  // avoid rewriting a cache the driver did not change
+  cache_header.miss_count = prev_miss_count_ + miss_count_.load();
+  cache_header.miss_duration_ns = (prev_miss_duration_ + Duration{miss_duration_.load()}).count();
+
+  WriteCacheFile(cache_filepath_, cache_header, data);
+}
+
+}  // namespace vktf
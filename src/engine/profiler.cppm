@@ -0,0 +1,329 @@
+module;
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+export module profiler;
+
+namespace vktf {
+
+/**
+ * @brief A low-overhead CPU profiler that records scoped zones into per-thread event buffers.
+ * @details Zones are recorded with @ref ProfileZone and exported in the Chrome trace event format which can be viewed
+ *          with tools such as Perfetto (https://ui.perfetto.dev) or @c chrome://tracing. Each thread appends events to
+ *          its own fixed-capacity buffer without synchronizing with other threads. When a thread buffer is full,
+ *          subsequent events on that thread are dropped until the next capture begins.
+ * @code
+ * auto& profiler = Profiler::Default();
+ * profiler.Start();
+ * {
+ *   const ProfileZone profile_zone{"Work"};
+ *   // ...
+ * }
+ * profiler.Stop();
+ * profiler.WriteChromeTrace("profile.json");
+ * @endcode
+ */
+export class [[nodiscard]] Profiler {
+public:
+  /** @brief The default maximum number of events recorded by each thread during a capture. */
+  static constexpr std::size_t kDefaultThreadEventCapacity = 1u << 16u;
+
+  /** @brief The clock used to timestamp profile zones. */
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Gets the default profiler used by engine subsystems.
+   * @return A reference to the default profiler instance which is initially stopped.
+   */
+  [[nodiscard]] static Profiler& Default() {
+    static Profiler default_profiler;
+    return default_profiler;
+  }
+
+  /**
+   * @brief Creates a @ref Profiler.
+   * @param thread_event_capacity The maximum number of events recorded by each thread during a capture.
+   */
+  explicit Profiler(std::size_t thread_event_capacity = kDefaultThreadEventCapacity);
+
+  Profiler(const Profiler&) = delete;
+  Profiler(Profiler&&) noexcept = delete;
+
+  Profiler& operator=(const Profiler&) = delete;
+  Profiler& operator=(Profiler&&) noexcept = delete;
+
+  ~Profiler() noexcept;
+
+  /** @brief Determines if the profiler is currently recording profile zones. */
+  [[nodiscard]] bool is_recording() const noexcept { return is_recording_.load(std::memory_order_relaxed); }
+
+  /** @brief Gets the number of events dropped during the current capture because a thread buffer was full. */
+  [[nodiscard]] std::size_t dropped_event_count() const noexcept {
+    return dropped_event_count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Begins a new capture.
+   * @details Events recorded during a previous capture are discarded.
+   */
+  void Start() noexcept;
+
+  /** @brief Ends the current capture. */
+  void Stop() noexcept;
+
+  /**
+   * @brief Writes events recorded during the most recent capture in the Chrome trace event format.
+   * @param ostream The output stream to write JSON to.
+   * @warning Events recorded while writing are not guaranteed to be included.
+   */
+  void WriteChromeTrace(std::ostream& ostream) const;
+
+  /**
+   * @brief Writes events recorded during the most recent capture to a Chrome trace file.
+   * @param trace_filepath The filepath of the JSON file to create or overwrite.
+   * @throws std::runtime_error Thrown if the trace file could not be written.
+   */
+  void WriteChromeTrace(const std::filesystem::path& trace_filepath) const;
+
+private:
+  friend class ProfileZone;
+
+  struct Event {
+    const char* name = nullptr;
+    Clock::time_point start_time;
+    Clock::time_point end_time;
+  };
+
+  struct ThreadBuffer;
+
+  void Record(const Event& event) noexcept;
+  [[nodiscard]] ThreadBuffer* GetThreadBuffer();
+
+  std::uint64_t id_;
+  std::size_t thread_event_capacity_;
+  Clock::time_point start_time_;
+  std::atomic<bool> is_recording_ = false;
+  std::atomic<std::uint64_t> capture_index_ = 0;
+  std::atomic<std::size_t> dropped_event_count_ = 0;
+  mutable std::mutex thread_buffers_mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers_;
+};
+
+/**
+ * @brief A scoped profile zone that records the time between its construction and destruction.
+ * @details Zones on the same thread nest according to their lifetimes. When the profiler is not recording, creating a
+ *          zone only checks an atomic flag.
+ */
+export class [[nodiscard]] ProfileZone {
+public:
+  /**
+   * @brief Begins a profile zone.
+   * @param name The zone name which must remain valid for the lifetime of @p profiler (e.g., a string literal).
+   * @param profiler The profiler to record the zone to.
+   */
+  explicit ProfileZone(const char* const name, Profiler& profiler = Profiler::Default()) noexcept
+      : profiler_{profiler.is_recording() ? &profiler : nullptr},
+        name_{name},
+        start_time_{profiler_ == nullptr ? Profiler::Clock::time_point{} : Profiler::Clock::now()} {}
+
+  ProfileZone(const ProfileZone&) = delete;
+  ProfileZone(ProfileZone&&) noexcept = delete;
+
+  ProfileZone& operator=(const ProfileZone&) = delete;
+  ProfileZone& operator=(ProfileZone&&) noexcept = delete;
+
+  /** @brief Ends the profile zone. */
+  ~ProfileZone() noexcept {
+    if (profiler_ != nullptr) {
+      profiler_->Record(Profiler::Event{.name = name_, .start_time = start_time_, .end_time = Profiler::Clock::now()});
+    }
+  }
+
+private:
+  Profiler* profiler_;
+  const char* name_;
+  Profiler::Clock::time_point start_time_;
+};
+
+}  // namespace vktf
+
+module :private;
+
+namespace vktf {
+
+// events are only written by the owning thread and published to other threads by atomically incrementing the count
+struct Profiler::ThreadBuffer {
+  std::uint32_t thread_index = 0;
+  std::atomic<std::uint64_t> capture_index = 0;
+  std::unique_ptr<Event[]> events;  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  std::atomic<std::size_t> event_count = 0;
+};
+
+namespace {
+
+std::uint64_t GetNextProfilerId() {
+  static std::atomic<std::uint64_t> next_profiler_id = 0;
+  return next_profiler_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+// zone names are expected to be identifiers but are escaped to guarantee valid JSON
+void WriteJsonString(std::ostream& ostream, const std::string_view value) {
+  ostream << '"';
+  for (const auto character : value) {
+    switch (character) {
+      case '"':
+        ostream << "\\\"";
+        break;
+      case '\\':
+        ostream << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(character) < 0x20) {
+          ostream << std::format("\\u{:04x}", static_cast<unsigned char>(character));
+        } else {
+          ostream << character;
+        }
+        break;
+    }
+  }
+  ostream << '"';
+}
+
+double ToMicroseconds(const Profiler::Clock::duration duration) {
+  return std::chrono::duration<double, std::micro>{duration}.count();
+}
+
+}  // namespace
+
+Profiler::Profiler(const std::size_t thread_event_capacity)
+    : id_{GetNextProfilerId()}, thread_event_capacity_{thread_event_capacity}, start_time_{Clock::now()} {}
+
+Profiler::~Profiler() noexcept = default;
+
+void Profiler::Start() noexcept {
+  dropped_event_count_.store(0, std::memory_order_relaxed);
+  capture_index_.fetch_add(1, std::memory_order_relaxed);  // thread buffers are lazily cleared by their owning thread
+  is_recording_.store(true, std::memory_order_release);
+}
+
+void Profiler::Stop() noexcept { is_recording_.store(false, std::memory_order_release); }
+
+void Profiler::Record(const Event& event) noexcept {
+  ThreadBuffer* thread_buffer = nullptr;
+  try {
+    thread_buffer = GetThreadBuffer();
+  } catch (const std::exception&) {
+    dropped_event_count_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  if (const auto capture_index = capture_index_.load(std::memory_order_relaxed);
+      thread_buffer->capture_index.load(std::memory_order_relaxed) != capture_index) {
+    thread_buffer->event_count.store(0, std::memory_order_relaxed);
+    thread_buffer->capture_index.store(capture_index, std::memory_order_release);
+  }
+
+  const auto event_index = thread_buffer->event_count.load(std::memory_order_relaxed);
+  if (event_index == thread_event_capacity_) {
+    dropped_event_count_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  thread_buffer->events[event_index] = event;
+  thread_buffer->event_count.store(event_index + 1, std::memory_order_release);
+}
+
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer() {
+  // each thread caches the buffer of the profiler it most recently recorded to which avoids acquiring a lock per event
+  struct ThreadBufferCache {
+    std::uint64_t profiler_id = ~std::uint64_t{0};
+    ThreadBuffer* thread_buffer = nullptr;
+  };
+  thread_local ThreadBufferCache thread_buffer_cache;
+  if (thread_buffer_cache.profiler_id == id_) return thread_buffer_cache.thread_buffer;
+
+  // thread buffers are owned by the profiler so that events remain available after their thread exits
+  thread_local std::vector<ThreadBufferCache> thread_buffers;
+  const auto iterator = std::ranges::find(thread_buffers, id_, &ThreadBufferCache::profiler_id);
+  auto* thread_buffer = iterator == thread_buffers.end() ? nullptr : iterator->thread_buffer;
+
+  if (thread_buffer == nullptr) {
+    auto owned_thread_buffer = std::make_unique<ThreadBuffer>();
+    owned_thread_buffer->events = std::make_unique_for_overwrite<Event[]>(thread_event_capacity_);
+
+    std::scoped_lock thread_buffers_lock{thread_buffers_mutex_};
+    owned_thread_buffer->thread_index = static_cast<std::uint32_t>(thread_buffers_.size());
+    owned_thread_buffer->capture_index.store(capture_index_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    thread_buffer = thread_buffers_.emplace_back(std::move(owned_thread_buffer)).get();
+    thread_buffers.push_back(ThreadBufferCache{.profiler_id = id_, .thread_buffer = thread_buffer});
+  }
+
+  thread_buffer_cache = ThreadBufferCache{.profiler_id = id_, .thread_buffer = thread_buffer};
+  return thread_buffer;
+}
+
+void Profiler::WriteChromeTrace(std::ostream& ostream) const {
+  const auto capture_index = capture_index_.load(std::memory_order_relaxed);
+  std::scoped_lock thread_buffers_lock{thread_buffers_mutex_};
+
+  ostream << R"({"displayTimeUnit":"ms","traceEvents":[)";
+  auto is_first_event = true;
+
+  for (const auto& thread_buffer : thread_buffers_) {
+    const auto thread_index = thread_buffer->thread_index;
+    ostream << std::format(R"({}{{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"Thread {}"}}}})",
+                           is_first_event ? "" : ",",
+                           thread_index,
+                           thread_index);
+    is_first_event = false;
+
+    // skip threads which did not record events during the most recent capture
+    if (thread_buffer->capture_index.load(std::memory_order_acquire) != capture_index) continue;
+
+    const auto event_count = thread_buffer->event_count.load(std::memory_order_acquire);
+    for (std::size_t event_index = 0; event_index < event_count; ++event_index) {
+      const auto& [name, start_time, end_time] = thread_buffer->events[event_index];
+      ostream << R"(,{"name":)";
+      WriteJsonString(ostream, name);
+      ostream << std::format(R"(,"cat":"vktf","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                             thread_index,
+                             ToMicroseconds(start_time - start_time_),
+                             ToMicroseconds(end_time - start_time));
+    }
+  }
+
+  ostream << "]}\n";
+}
+
+void Profiler::WriteChromeTrace(const std::filesystem::path& trace_filepath) const {
+  if (trace_filepath.has_parent_path()) {
+    std::filesystem::create_directories(trace_filepath.parent_path());
+  }
+
+  std::ofstream trace_ofstream{trace_filepath};
+  if (!trace_ofstream.is_open()) {
+    throw std::runtime_error{std::format("Failed to open {}", trace_filepath.string())};
+  }
+
+  WriteChromeTrace(trace_ofstream);
+  if (!trace_ofstream.flush()) {
+    throw std::runtime_error{std::format("Failed to write {}", trace_filepath.string())};
+  }
+}
+
+}  // namespace vktf
@@ -25,6 +25,12 @@ export struct [[nodiscard]] QueueFamilies {
 
   /** @brief A queue family that supports presenting images to a Vulkan surface. */
   QueueFamily present_family;
+
+  /**
+   * @brief A queue family that supports transfer capabilities.
+   * @note This is a dedicated transfer queue family when available, otherwise it's the graphics queue family.
+   */
+  QueueFamily transfer_family;
 };
 
 /**
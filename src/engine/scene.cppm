@@ -2,12 +2,24 @@ module;
 
 #include <algorithm>
 #include <array>
+#include <cassert>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
-#include <filesystem>
-#include <limits>
+#include <deque>
+#include <exception>
+#include <format>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <ranges>
 #include <span>
+#include <stop_token>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -16,14 +28,23 @@ module;
 
 export module scene;
 
+import bounding_box;
+import bounding_volume_hierarchy;
 import buffer;
 import camera;
 import command_pool;
+import glslang_compiler;
 import gltf_asset;
+import gpu_profiler;
 import graphics_pipeline;
 import log;
+import mesh;
 import model;
+import node_hierarchy;
+import pipeline_cache;
+import profiler;
 import queue;
+import thread_pool;
 import view_frustum;
 import vma_allocator;
 
@@ -34,10 +55,17 @@ namespace vktf {
  * @details This class handles loading multiple glTF assets that combine together to form a cohesive scene and manages
  *          global resources that are common to all models in the scene (e.g., cameras, lights). When constructed, it
  *          handles the creation and submission of command buffers to copy glTF asset resources to device-local memory.
- *          It also provides high-level APIs for updating and rendering the scene on a per-frame basis.
+ *          Models can also be streamed into and out of the scene at runtime. Streamed glTF assets are loaded, staged,
+ *          and recorded on a background thread and only submitted, inserted, and retired by the thread that renders
+ *          the scene which never waits for a model to load or upload. Each model is culled with its own bounding
+ *          volume hierarchy so adding or removing a model never rebuilds data for other models in the scene. It also
+ *          provides high-level APIs for updating and rendering the scene on a per-frame basis.
  */
 export class [[nodiscard]] Scene {
 public:
+  /** @brief A type alias for the unique identifier of a model in the scene. */
+  using ModelId = std::uint32_t;
+
   /** @brief A structure representing properties for the active camera in the scene. */
   struct [[nodiscard]] CameraProperties {
     /** @brief The view-projection matrix that transforms a world-space vertex position into clip-space coordinates. */
@@ -62,23 +90,88 @@ public:
     glm::vec4 color{0.0f};
   };
 
+  /** @brief The header of the world-space lights uniform buffer which precedes an array of @ref WorldLight. */
+  struct [[nodiscard]] WorldLightsHeader {
+    /** @brief The number of active lights in the uniform buffer. */
+    std::uint32_t light_count = 0;
+
+    /** @attention The header is padded to conform to std140 layout requirements for the array of lights. */
+    std::array<std::uint32_t, 3> padding{};
+  };
+
   /** @brief The parameters for creating a @ref Scene. */
   struct [[nodiscard]] CreateInfo {
-    /** @brief The glTF assets to load. */
+    /**
+     * @brief The glTF assets to load.
+     * @note Models created from these assets are assigned consecutive model IDs beginning with zero.
+     */
     std::span<const gltf::Asset> gltf_assets;
 
-    /** @brief The queue for submitting command buffers that require transfer capabilities. */
+    /**
+     * @brief The queue for submitting copy commands that upload glTF asset resources to device-local memory.
+     * @note Uploads are submitted asynchronously and models are only rendered once their uploads complete.
+     * @warning The caller is responsible for ensuring the queue outlives the scene.
+     */
     const Queue& transfer_queue;
 
+    /**
+     * @brief The unique queue families that access device-local scene resources.
+     * @note This must include the queue families for @ref Scene::CreateInfo::transfer_queue and the queue that executes
+     *       command buffers recorded by @ref Scene::Render.
+     */
+    std::span<const std::uint32_t> queue_family_indices;
+
     /** @brief The physical device features for determining the transcode target of basis universal KTX textures. */
     const vk::PhysicalDeviceFeatures& physical_device_features;
 
+    /**
+     * @brief The thread pool for compiling shaders and for per-frame update and command recording tasks.
+     * @warning The caller is responsible for ensuring the thread pool outlives the scene when parallel updates are
+     *          enabled.
+     */
+    ThreadPool& thread_pool;
+
+    /**
+     * @brief The thread pool for loading textures concurrently.
+     * @details This should be separate from @ref Scene::CreateInfo::thread_pool and ideally run at a lower priority so
+     *          streaming models with @ref Scene::AddAsync does not delay per-frame tasks.
+     * @warning The caller is responsible for ensuring the thread pool outlives the scene when models are streamed with
+     *          @ref Scene::AddAsync.
+     */
+    ThreadPool& streaming_thread_pool;
+
     /**
      * @brief The anisotropy for sampling textures.
      * @note A value of @c std::nullopt indicates this feature is not enabled.
      */
     std::optional<float> sampler_anisotropy;
 
+    /**
+     * @brief Indicates whether draw batches should be rendered with multi-draw indirect commands.
+     * @note When this feature is not enabled, draw commands are recorded individually from host memory instead.
+     */
+    bool multi_draw_indirect = false;
+
+    /**
+     * @brief Indicates whether node transforms should be updated concurrently on @ref Scene::CreateInfo::thread_pool.
+     * @note Parallel updates produce the same results as serial updates because each node, light, and mesh instance is
+     *       written to a fixed location regardless of the order in which update tasks complete.
+     */
+    bool parallel_update = false;
+
+    /**
+     * @brief The maximum number of lights that can be rendered in a single frame.
+     * @note This value is fixed because it specializes the size of the lights array in the fragment shader. Lights in
+     *       models added after this limit is reached are ignored until lights in other models are removed.
+     */
+    std::uint32_t max_light_count = 1;
+
+    /**
+     * @brief The maximum number of frames that can be rendered concurrently.
+     * @note Removed models are destroyed once this many frames have begun since they were last rendered.
+     */
+    std::uint32_t max_render_frames = 1;
+
     /** @brief The fixed viewport and scissor extent for creating graphics pipelines. */
     vk::Extent2D viewport_extent;
 
@@ -94,6 +187,18 @@ public:
      */
     vk::DescriptorSetLayout global_descriptor_set_layout;
 
+    /**
+     * @brief The pipeline cache for creating graphics pipelines.
+     * @warning The caller is responsible for ensuring the pipeline cache outlives the scene.
+     */
+    PipelineCache& pipeline_cache;
+
+    /**
+     * @brief The SPIR-V cache for GLSL shaders compiled at runtime when creating graphics pipelines.
+     * @warning The caller is responsible for ensuring the SPIR-V cache outlives the scene.
+     */
+    glslang::SpirvCache& spirv_cache;
+
     /** @brief The log for writing messages when creating the scene. */
     Log& log;
   };
@@ -102,40 +207,288 @@ public:
    * @brief Creates a @ref Scene.
    * @param allocator The allocator for creating buffers and images.
    * @param create_info @copybrief Scene::CreateInfo.
+   * @warning The caller is responsible for ensuring @p allocator outlives the scene.
    */
   Scene(const vma::Allocator& allocator, const CreateInfo& create_info);
 
+  Scene(const Scene&) = delete;
+  Scene(Scene&&) noexcept = default;
+
+  Scene& operator=(const Scene&) = delete;
+  Scene& operator=(Scene&&) = delete;  // the streaming thread may reference resources replaced by move assignment
+
   /** @brief Gets the active camera in the scene. */
   [[nodiscard]] auto& camera(this auto& self) noexcept { return self.camera_; }
 
-  /** @brief Gets the number of lights in the scene. */
+  /**
+   * @brief Gets a model that is currently rendered in the scene.
+   * @param model_id The ID of the model to get.
+   * @return The model for @p model_id or @c nullptr if the model is still loading or has been removed.
+   * @note Node transforms updated with @ref Model::SetLocalTransform are applied by the next @ref Scene::Update.
+   */
+  [[nodiscard]] Model* FindModel(ModelId model_id) noexcept;
+
+  /** @copydoc Scene::FindModel */
+  [[nodiscard]] const Model* FindModel(ModelId model_id) const noexcept;
+
+  /** @brief Gets the number of lights in models currently rendered in the scene. */
   [[nodiscard]] std::uint32_t light_count() const noexcept { return light_count_; }
 
+  /** @brief Gets the maximum number of lights that can be rendered in a single frame. */
+  [[nodiscard]] std::uint32_t max_light_count() const noexcept { return max_light_count_; }
+
+  /**
+   * @brief Gets the timeline semaphore signaled when model uploads complete.
+   * @note The semaphore value is the number of model uploads that have been copied to device-local memory.
+   */
+  [[nodiscard]] vk::Semaphore upload_semaphore() const noexcept { return *upload_semaphore_; }
+
+  /**
+   * @brief Gets the upload semaphore value that command buffers recorded by @ref Scene::Render must wait on.
+   * @note This value is calculated by @ref Scene::UpdateResidentModels and has always been signaled when it's
+   *       returned. Waiting on it never stalls the queue and only guarantees uploaded resources are visible to commands
+   *       that render them.
+   */
+  [[nodiscard]] std::uint64_t upload_semaphore_value() const noexcept { return upload_semaphore_value_; }
+
+  /**
+   * @brief Gets the maximum number of mesh instances that can be rendered in a single frame.
+   * @note This value changes when models are inserted or removed by @ref Scene::UpdateResidentModels.
+   */
+  [[nodiscard]] std::uint32_t max_instance_count() const noexcept { return max_instance_count_; }
+
+  /**
+   * @brief Gets the maximum number of draw commands that can be recorded in a single frame.
+   * @note This value changes when models are inserted or removed by @ref Scene::UpdateResidentModels.
+   */
+  [[nodiscard]] std::uint32_t max_draw_count() const noexcept { return max_draw_count_; }
+
+  /**
+   * @brief Gets the number of draw commands for visible mesh primitives in the current frame.
+   * @note This value is calculated by @ref Scene::Update and can be used to measure draw command recording throughput.
+   */
+  [[nodiscard]] std::uint32_t draw_count() const noexcept { return static_cast<std::uint32_t>(draw_commands_.size()); }
+
+  /**
+   * @brief Adds a glTF asset to the scene asynchronously.
+   * @details The glTF asset is loaded, staged, and recorded into a copy command buffer on a background thread which
+   *          processes requests in the order they were added. The copy commands are submitted by the next
+   *          @ref Scene::UpdateResidentModels after recording completes and the model is rendered once its upload
+   *          completes.
+   * @param load_gltf_asset The function for loading the glTF asset which is invoked on the background thread.
+   * @param log The log for writing messages when loading the model.
+   * @return The ID of the model which can be used to remove the model from the scene at any time.
+   * @note Models that fail to load are never added to the scene and the reason is written to @p log.
+   * @warning The caller is responsible for ensuring @p load_gltf_asset and @p log can be safely invoked on another
+   *          thread and that @p log outlives the scene.
+   */
+  ModelId AddAsync(std::function<gltf::Asset()> load_gltf_asset, Log& log);
+
+  /**
+   * @brief Removes a model from the scene.
+   * @details Removed models are no longer rendered by the next frame and their resources are destroyed once every
+   *          frame that may have rendered them has completed. Models that are still loading or uploading are discarded
+   *          as soon as it's safe to do so.
+   * @param model_id The ID of the model to remove.
+   * @return @c true if the model was removed, otherwise @c false if the model does not exist in the scene.
+   */
+  bool Remove(ModelId model_id);
+
+  /**
+   * @brief Updates which models are rendered in the scene.
+   * @details This function submits copy commands for models recorded on the background thread, inserts models whose
+   *          uploads have completed, and destroys removed models that are no longer used by frames in flight. It only
+   *          polls upload progress and never waits for the background thread or the device.
+   * @warning This function must be called exactly once per frame after waiting for the frame that last used the same
+   *          frame-dependent resources and before @ref Scene::Update.
+   */
+  void UpdateResidentModels();
+
   /**
    * @brief Updates each node in the scene.
-   * @details This function traverses the scene graph, updates global transforms for each node in the scene, and copies
-   *          global scene data to frame-dependent resources managed by @ref Engine.
+   * @details This function updates global transforms, world-space lights, and world-space bounding boxes for nodes
+   *          whose local transform changed since the last update, culls mesh instances outside the camera view frustum,
+   *          and copies global scene data and draw commands for visible mesh instances to frame-dependent resources
+   *          managed by @ref Engine. Updating a scene without node transform changes only requires culling and copying.
+   *          Parallel updates divide node transforms, lights, and bounding boxes between thread pool tasks.
    * @param camera_uniform_buffer The camera properties uniform buffer for the current frame.
-   * @param lights_uniform_buffer The world-space lights uniform buffer for the current frame.
+   * @param lights_uniform_buffer The world-space lights uniform buffer for the current frame which must be large enough
+   *                              to store a @ref WorldLightsHeader followed by @ref Scene::max_light_count lights.
+   * @param instance_transforms_buffer The storage buffer for visible mesh instance transforms in the current frame.
+   * @param draw_commands_buffer The indirect buffer for visible mesh primitive draw commands in the current frame.
    */
-  void Update(HostVisibleBuffer& camera_uniform_buffer, HostVisibleBuffer& lights_uniform_buffer);
+  void Update(HostVisibleBuffer& camera_uniform_buffer,
+              HostVisibleBuffer& lights_uniform_buffer,
+              HostVisibleBuffer& instance_transforms_buffer,
+              HostVisibleBuffer& draw_commands_buffer);
 
   /**
    * @brief Records draw commands to render models in the scene.
-   * @details This function binds compatible graphics pipelines and descriptor sets, traverses the scene graph, and
-   *          and records draw commands to render each model in the scene.
+   * @details This function binds compatible graphics pipelines and descriptor sets and records draw commands for each
+   *          model draw batch containing visible primitives in the current frame.
    * @param command_buffer The command buffer for recording draw commands.
    * @param global_descriptor_set The global descriptor set to bind for the current frame.
+   * @param draw_commands_buffer The indirect buffer updated by @ref Scene::Update for the current frame.
+   * @param gpu_profiler The GPU profiler for timing draw commands for each model or @c nullptr to disable profiling.
    * @warning The caller is responsible for submitting @p command_buffer to a Vulkan queue to begin execution.
    */
-  void Render(vk::CommandBuffer command_buffer, vk::DescriptorSet global_descriptor_set) const;
+  void Render(vk::CommandBuffer command_buffer,
+              vk::DescriptorSet global_descriptor_set,
+              vk::Buffer draw_commands_buffer,
+              GpuProfiler* gpu_profiler = nullptr) const;
+
+  /**
+   * @brief Records draw commands to render models in the scene into secondary command buffers on a thread pool.
+   * @details This function divides visible draw commands into contiguous ranges of similar size and records each range
+   *          into a separate secondary command buffer in a separate thread pool task. Each secondary command buffer
+   *          binds its own graphics pipeline and descriptor sets because bindings are not inherited from the primary
+   *          command buffer. Scenes with few visible draw commands use fewer command buffers to avoid the overhead of
+   *          recording and executing command buffers with little work.
+   * @param command_buffers The secondary command buffers for recording draw commands. Each command buffer must be
+   *                        allocated from a different command pool because command pools are externally synchronized.
+   * @param inheritance_info The render pass state inherited from the primary command buffer that executes
+   *                         @p command_buffers.
+   * @param global_descriptor_set The global descriptor set to bind for the current frame.
+   * @param draw_commands_buffer The indirect buffer updated by @ref Scene::Update for the current frame.
+   * @param thread_pool The thread pool for recording command buffers concurrently.
+   * @param gpu_profiler The GPU profiler for timing draw commands for each model or @c nullptr to disable profiling.
+   * @return The subset of @p command_buffers containing recorded draw commands which is empty if no primitives are
+   *         visible in the current frame.
+   * @warning The caller is responsible for executing the returned command buffers in the render pass subpass specified
+   *          by @p inheritance_info and for resetting them before they are recorded again.
+   */
+  [[nodiscard]] std::span<const vk::CommandBuffer> Render(std::span<const vk::CommandBuffer> command_buffers,
+                                                          const vk::CommandBufferInheritanceInfo& inheritance_info,
+                                                          vk::DescriptorSet global_descriptor_set,
+                                                          vk::Buffer draw_commands_buffer,
+                                                          ThreadPool& thread_pool,
+                                                          GpuProfiler* gpu_profiler = nullptr) const;
 
 private:
+  struct MeshInstance {
+    const Mesh* mesh = nullptr;
+    std::uint32_t node_index = 0;
+  };
+
+  struct LightInstance {
+    const Model::Light* light = nullptr;
+    std::uint32_t node_index = 0;
+  };
+
+  struct DrawRange {
+    std::uint32_t first_draw = 0;
+    std::uint32_t draw_count = 0;
+  };
+
+  struct VisibleDrawBatch {
+    ModelId model_id = 0;
+    const GeometryArena* geometry_arena = nullptr;
+    const Model::DrawBatch* draw_batch = nullptr;
+    DrawRange draw_range;
+  };
+
+  // a model with world-space data for its instances which is built once when the model is created and never depends on
+  // other models in the scene which allows models to be created on a background thread and inserted in constant time
+  struct SceneModel {
+    SceneModel(ModelId model_id, std::unique_ptr<Model> owned_model);
+    void Update(ThreadPool* thread_pool);
+
+    ModelId id = 0;
+    std::unique_ptr<Model> model;  // heap-allocated to keep node hierarchy addresses stable when models are moved
+    std::vector<LightInstance> light_instances;
+    std::vector<WorldLight> world_lights;  // indexed by light instance
+    std::vector<MeshInstance> mesh_instances;
+    BoundingBoxes world_bounding_boxes;  // indexed by mesh instance
+    BoundingVolumeHierarchy bounding_volume_hierarchy;
+    std::vector<std::uint64_t> visibility_mask;
+    std::vector<std::vector<vk::DrawIndexedIndirectCommand>> draw_batch_commands;  // indexed by model draw batch
+    std::uint32_t max_draw_count = 0;
+  };
+
+  struct UploadingModel {
+    SceneModel scene_model;
+    StagingModel staging_model;  // staging buffers must outlive copy commands
+    CommandPool command_pool;
+    std::uint64_t upload_semaphore_value = 0;  // assigned when copy commands are submitted
+    bool removed = false;                      // removed models are discarded once their upload completes
+  };
+
+  struct RetiredModel {
+    std::unique_ptr<Model> model;
+    std::uint64_t frame_index = 0;  // the last frame that may have rendered the model
+  };
+
+  struct UploadContext {
+    const vma::Allocator& allocator;
+    const vk::PhysicalDeviceFeatures& physical_device_features;
+    ThreadPool& thread_pool;
+    std::uint32_t transfer_queue_family_index = 0;
+    std::vector<std::uint32_t> queue_family_indices;
+    vk::DescriptorSetLayout material_descriptor_set_layout;
+    std::optional<float> sampler_anisotropy;
+  };
+
+  struct LoadRequest {
+    ModelId model_id = 0;
+    std::function<gltf::Asset()> load_gltf_asset;
+    Log* log = nullptr;
+  };
+
+  // state shared with the streaming thread which is heap-allocated to remain valid when the scene is moved
+  struct StreamingState {
+    UploadContext upload_context;
+    std::mutex mutex;
+    std::condition_variable_any load_request_condition;
+    std::deque<LoadRequest> load_requests;
+    std::optional<ModelId> loading_model_id;  // reset to discard the model currently being loaded
+    std::vector<UploadingModel> recorded_models;
+    std::jthread thread;  // declared last to stop and join the thread before the state it references is destroyed
+  };
+
+  static UploadingModel CreateUploadingModel(const UploadContext& upload_context,
+                                             ModelId model_id,
+                                             const gltf::Asset& gltf_asset,
+                                             const StagingTextureFutures& staging_textures,
+                                             Log& log);
+
+  static void StreamModels(std::stop_token stop_token, StreamingState& streaming_state);
+
+  void SubmitUpload(UploadingModel& uploading_model);
+  void Insert(SceneModel&& scene_model);
+  void UpdateModels();
+
+  void RecordDrawCommands(vk::CommandBuffer command_buffer,
+                          vk::DescriptorSet global_descriptor_set,
+                          vk::Buffer draw_commands_buffer,
+                          std::uint32_t first_draw,
+                          std::uint32_t last_draw,
+                          GpuProfiler* gpu_profiler) const;
+
   Camera camera_;
-  std::uint32_t light_count_;
-  std::vector<Model> models_;
+  std::uint32_t max_light_count_;
+  std::uint32_t max_render_frames_;
   vk::UniqueDescriptorSetLayout material_descriptor_set_layout_;  // TODO: avoid fixed material descriptor set layout
   GraphicsPipeline graphics_pipeline_;
+  bool multi_draw_indirect_;
+  ThreadPool* update_thread_pool_;  // a null value indicates the scene is updated serially
+  const Queue* transfer_queue_;
+  vk::UniqueSemaphore upload_semaphore_;
+  std::uint64_t submitted_upload_semaphore_value_ = 0;
+  std::uint64_t upload_semaphore_value_ = 0;  // the most recent value observed by the host
+  std::uint64_t frame_index_ = 0;
+  ModelId next_model_id_ = 0;
+  std::vector<SceneModel> models_;
+  std::vector<UploadingModel> uploading_models_;  // sorted by upload semaphore value
+  std::vector<RetiredModel> retired_models_;
+  std::uint32_t light_count_ = 0;
+  std::uint32_t max_instance_count_ = 0;
+  std::uint32_t max_draw_count_ = 0;
+  std::size_t draw_batch_count_ = 0;
+  std::vector<WorldLight> world_lights_;
+  std::vector<glm::mat4> instance_transforms_;
+  std::vector<vk::DrawIndexedIndirectCommand> draw_commands_;
+  std::vector<VisibleDrawBatch> visible_draw_batches_;  // sorted by first draw command
+  std::unique_ptr<StreamingState> streaming_state_;  // declared last to join the streaming thread first
 };
 
 }  // namespace vktf
@@ -174,74 +527,99 @@ Camera CreateCamera(const vk::Extent2D viewport_extent) {
 
 using WorldLight = Scene::WorldLight;
 
-std::uint32_t GetLightCount(const std::span<const gltf::Asset> gltf_assets) {
-  return std::ranges::fold_left(gltf_assets, 0u, [](const auto& light_count, const auto& gltf_asset) {
-    return light_count + static_cast<std::uint32_t>(gltf_asset.lights.size());
-  });
-}
-
-void EmplaceWorldLight(const Model::Node& node, std::vector<WorldLight>& world_lights) {
-  const auto& light = node.light;
-  if (light == nullptr) return;
-
+WorldLight GetWorldLight(const Model::Light& light, const glm::mat4& world_transform) {
   static constexpr auto kAlphaPadding = 1.0f;
-  const glm::vec4 light_color{light->color, kAlphaPadding};
+  const glm::vec4 light_color{light.color, kAlphaPadding};
 
-  switch (const auto& world_transform = node.global_transform; light->type) {
+  switch (light.type) {
     using enum Model::Light::Type;
     case kDirectional: {
       const auto& light_direction = world_transform[2];  // node orientation +z-axis
-      world_lights.emplace_back(glm::normalize(light_direction), light_color);
-      break;
+      return WorldLight{.position = glm::normalize(light_direction), .color = light_color};
     }
     case kPoint: {
       const auto& light_position = world_transform[3];  // node world-space position
-      world_lights.emplace_back(light_position, light_color);
-      break;
+      return WorldLight{.position = light_position, .color = light_color};
     }
     default:
       std::unreachable();
   }
 }
 
+// =====================================================================================================================
+// Updates
+// =====================================================================================================================
+
+template <std::invocable<std::size_t, std::size_t> Fn>
+void ForEachRange(ThreadPool* const thread_pool, const std::size_t count, Fn&& fn) {
+  // small ranges are processed serially because the cost of scheduling a task exceeds the cost of processing them
+  static constexpr auto kMinTaskSize = 1'024uz;
+  if (thread_pool == nullptr || count <= kMinTaskSize) {
+    std::forward<Fn>(fn)(0uz, count);
+    return;
+  }
+
+  const auto thread_count = thread_pool->thread_count();
+  const auto task_size = std::max(kMinTaskSize, (count + thread_count - 1) / thread_count);
+  std::vector<std::future<void>> futures;
+  for (auto first_index = 0uz; first_index < count; first_index += task_size) {
+    futures.push_back(thread_pool->Submit([&fn, first_index, last_index = std::min(first_index + task_size, count)] {
+      fn(first_index, last_index);
+    }));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+}
+
+// =====================================================================================================================
+// Draw Commands
+// =====================================================================================================================
+
+bool IsVisible(const std::span<const std::uint64_t> visibility_mask, const std::size_t mesh_instance_index) {
+  static constexpr auto kVisibilityMaskBits = 64uz;
+  const auto visibility_bits = visibility_mask[mesh_instance_index / kVisibilityMaskBits];
+  return ((visibility_bits >> (mesh_instance_index % kVisibilityMaskBits)) & 1u) != 0;
+}
+
+void EmplaceDrawCommands(const Mesh& mesh,
+                         const glm::mat4& world_transform,
+                         std::vector<glm::mat4>& instance_transforms,
+                         const std::span<std::vector<vk::DrawIndexedIndirectCommand>> draw_batch_commands) {
+  // the instance index selects the mesh instance transform in the vertex shader using gl_InstanceIndex
+  const auto instance_index = static_cast<std::uint32_t>(instance_transforms.size());
+  instance_transforms.push_back(world_transform);
+
+  for (const auto& primitive : mesh.primitives()) {
+    const auto draw_batch_index = primitive.draw_batch_index();
+    assert(draw_batch_index < draw_batch_commands.size());  // guaranteed by model construction
+    draw_batch_commands[draw_batch_index].push_back(primitive.GetDrawCommand(instance_index));
+  }
+}
+
 // =====================================================================================================================
 // Models
 // =====================================================================================================================
 
-using StagingModelPair = std::pair<const gltf::Asset*, StagingModel>;
+using Severity = Log::Severity;
 
-std::vector<StagingModelPair> CreateStagingModels(const vma::Allocator& allocator,
-                                                  const std::span<const gltf::Asset> gltf_assets,
-                                                  const vk::PhysicalDeviceFeatures& physical_device_features,
-                                                  Log& log) {
+std::vector<StagingTextureFutures> CreateStagingTextureFutures(
+    const vma::Allocator& allocator,
+    const std::span<const gltf::Asset> gltf_assets,
+    const vk::PhysicalDeviceFeatures& physical_device_features,
+    ThreadPool& thread_pool,
+    Log& log) {
   return gltf_assets  //
-         | std::views::transform([&allocator, &physical_device_features, &log](const auto& gltf_asset) {
-             return std::pair{
-                 &gltf_asset,
-                 StagingModel{allocator,
-                              StagingModel::CreateInfo{.gltf_asset = gltf_asset,
-                                                       .physical_device_features = physical_device_features,
-                                                       .log = log}}};
+         | std::views::transform([&allocator, &physical_device_features, &thread_pool, &log](const auto& gltf_asset) {
+             return CreateStagingTexturesAsync(allocator, gltf_asset, physical_device_features, thread_pool, log);
            })
          | std::ranges::to<std::vector>();
 }
 
-std::vector<Model> CreateModels(const vma::Allocator& allocator,
-                                const vk::CommandBuffer command_buffer,
-                                const std::vector<StagingModelPair>& staging_models,
-                                const vk::DescriptorSetLayout material_descriptor_set_layout,
-                                const std::optional<float> sampler_anisotropy) {
-  return staging_models  //
-         | std::views::transform([=, &allocator](const auto& key_value_pair) {
-             const auto& [gltf_asset, staging_model] = key_value_pair;
-             return Model{allocator,
-                          command_buffer,
-                          Model::CreateInfo{.gltf_asset = *gltf_asset,
-                                            .staging_model = staging_model,
-                                            .material_descriptor_set_layout = material_descriptor_set_layout,
-                                            .sampler_anisotropy = sampler_anisotropy}};
-           })
-         | std::ranges::to<std::vector>();
+vk::UniqueSemaphore CreateTimelineSemaphore(const vk::Device device) {
+  static constexpr vk::SemaphoreTypeCreateInfo kSemaphoreTypeCreateInfo{.semaphoreType = vk::SemaphoreType::eTimeline,
+                                                                        .initialValue = 0};
+  return device.createSemaphoreUnique(vk::SemaphoreCreateInfo{.pNext = &kSemaphoreTypeCreateInfo});
 }
 
 vk::UniqueDescriptorSetLayout CreateMaterialDescriptorSetLayout(const vk::Device device) {
@@ -264,7 +642,8 @@ vk::UniqueDescriptorSetLayout CreateMaterialDescriptorSetLayout(const vk::Device
 
 Scene::Scene(const vma::Allocator& allocator, const CreateInfo& create_info)
     : camera_{CreateCamera(create_info.viewport_extent)},
-      light_count_{GetLightCount(create_info.gltf_assets)},
+      max_light_count_{create_info.max_light_count},
+      max_render_frames_{create_info.max_render_frames},
       material_descriptor_set_layout_{CreateMaterialDescriptorSetLayout(allocator.device())},
       graphics_pipeline_{
           allocator.device(),
@@ -273,71 +652,566 @@ Scene::Scene(const vma::Allocator& allocator, const CreateInfo& create_info)
                                        .viewport_extent = create_info.viewport_extent,
                                        .msaa_sample_count = create_info.msaa_sample_count,
                                        .render_pass = create_info.render_pass,
-                                       .light_count = light_count_,
-                                       .log = create_info.log}} {
-  const auto& device = allocator.device();
+                                       .max_light_count = max_light_count_,
+                                       .pipeline_cache = create_info.pipeline_cache,
+                                       .spirv_cache = create_info.spirv_cache,
+                                       .thread_pool = create_info.thread_pool,
+                                       .log = create_info.log}},
+      multi_draw_indirect_{create_info.multi_draw_indirect},
+      update_thread_pool_{create_info.parallel_update ? &create_info.thread_pool : nullptr},
+      transfer_queue_{&create_info.transfer_queue},
+      upload_semaphore_{CreateTimelineSemaphore(allocator.device())} {
   const auto& [gltf_assets,
                transfer_queue,
+               queue_family_indices,
                physical_device_features,
+               thread_pool,
+               streaming_thread_pool,
                sampler_anisotropy,
+               multi_draw_indirect,
+               parallel_update,
+               max_light_count,
+               max_render_frames,
                viewport_extent,
                msaa_sample_count,
                render_pass,
                global_descriptor_set_layout,
+               pipeline_cache,
+               spirv_cache,
                log] = create_info;
 
-  static constexpr auto kCommandBufferCount = 1;
-  const CommandPool copy_command_pool{
-      device,
+  assert(max_light_count > 0);  // the fragment shader lights array must contain at least one element
+  assert(max_render_frames > 0);
+  world_lights_.reserve(max_light_count);
+
+  streaming_state_ = std::make_unique<StreamingState>(
+      UploadContext{.allocator = allocator,
+                    .physical_device_features = physical_device_features,
+                    .thread_pool = streaming_thread_pool,
+                    .transfer_queue_family_index = transfer_queue.queue_family_index(),
+                    .queue_family_indices = queue_family_indices | std::ranges::to<std::vector>(),
+                    .material_descriptor_set_layout = *material_descriptor_set_layout_,
+                    .sampler_anisotropy = sampler_anisotropy});
+
+  if (gltf_assets.empty()) return;
+
+  // staging textures for all assets are created up front so texture loading for later assets overlaps with staging and
+  // uploading earlier assets whose textures are ready
+  const auto staging_texture_futures =
+      CreateStagingTextureFutures(allocator, gltf_assets, physical_device_features, streaming_thread_pool, log);
+
+  uploading_models_.reserve(gltf_assets.size());
+  for (const auto& [gltf_asset, staging_textures] : std::views::zip(gltf_assets, staging_texture_futures)) {
+    // each model is submitted in a separate batch as soon as it is recorded to overlap copies with staging other models
+    auto& uploading_model = uploading_models_.emplace_back(
+        CreateUploadingModel(streaming_state_->upload_context, next_model_id_++, gltf_asset, staging_textures, log));
+    SubmitUpload(uploading_model);
+  }
+}
+
+Scene::SceneModel::SceneModel(const ModelId model_id, std::unique_ptr<Model> owned_model)
+    : id{model_id}, model{std::move(owned_model)}, draw_batch_commands(model->draw_batches().size()) {
+  const auto& global_transforms = model->node_hierarchy().global_transforms();
+
+  for (const auto& [node_index, node] : std::views::enumerate(model->nodes())) {
+    const auto node_index_u32 = static_cast<std::uint32_t>(node_index);
+    const auto& global_transform = global_transforms[node_index_u32];
+
+    if (const auto* const light = node.light; light != nullptr) {
+      light_instances.emplace_back(light, node_index_u32);
+      world_lights.push_back(GetWorldLight(*light, global_transform));
+    }
+    if (const auto* const mesh = node.mesh; mesh != nullptr) {
+      mesh_instances.emplace_back(mesh, node_index_u32);
+      world_bounding_boxes.Add(Transform(mesh->bounding_box(), global_transform));
+      max_draw_count += static_cast<std::uint32_t>(mesh->primitives().size());
+    }
+  }
+
+  // the hierarchy topology is built once from initial node transforms and refit when node transforms change
+  bounding_volume_hierarchy = BoundingVolumeHierarchy{world_bounding_boxes};
+
+  static constexpr auto kVisibilityMaskBits = 64uz;
+  visibility_mask.resize((mesh_instances.size() + kVisibilityMaskBits - 1) / kVisibilityMaskBits);
+}
+
+void Scene::SceneModel::Update(ThreadPool* const thread_pool) {
+  // world-space lights and bounding boxes are only recalculated for nodes whose global transform changed
+  const auto& node_hierarchy = model->node_hierarchy();
+  const auto& global_transforms = node_hierarchy.global_transforms();
+
+  ForEachRange(thread_pool,
+               light_instances.size(),
+               [this, &node_hierarchy, &global_transforms](const auto first_index, const auto last_index) {
+                 for (auto light_instance_index = first_index; light_instance_index < last_index;
+                      ++light_instance_index) {
+                   const auto& [light, node_index] = light_instances[light_instance_index];
+                   if (node_hierarchy.updated(node_index)) {
+                     world_lights[light_instance_index] = GetWorldLight(*light, global_transforms[node_index]);
+                   }
+                 }
+               });
+
+  ForEachRange(thread_pool,
+               mesh_instances.size(),
+               [this, &node_hierarchy, &global_transforms](const auto first_index, const auto last_index) {
+                 for (auto mesh_instance_index = first_index; mesh_instance_index < last_index;
+                      ++mesh_instance_index) {
+                   const auto& [mesh, node_index] = mesh_instances[mesh_instance_index];
+                   if (node_hierarchy.updated(node_index)) {
+                     world_bounding_boxes.Set(mesh_instance_index,
+                                              Transform(mesh->bounding_box(), global_transforms[node_index]));
+                   }
+                 }
+               });
+
+  bounding_volume_hierarchy.Refit(world_bounding_boxes);
+}
+
+Scene::UploadingModel Scene::CreateUploadingModel(const UploadContext& upload_context,
+                                                  const ModelId model_id,
+                                                  const gltf::Asset& gltf_asset,
+                                                  const StagingTextureFutures& staging_textures,
+                                                  Log& log) {
+  const auto& allocator = upload_context.allocator;
+
+  StagingModel staging_model{
+      allocator,
+      StagingModel::CreateInfo{.gltf_asset = gltf_asset, .staging_textures = staging_textures, .log = log}};
+
+  // each model records copy commands into its own command pool which allows models to be recorded on the streaming
+  // thread and submitted and released independently by the thread that renders the scene
+  CommandPool command_pool{
+      allocator.device(),
       CommandPool::CreateInfo{.command_pool_create_flags = vk::CommandPoolCreateFlagBits::eTransient,
-                              .queue_family_index = transfer_queue.queue_family_index(),
-                              .command_buffer_count = kCommandBufferCount}};
+                              .queue_family_index = upload_context.transfer_queue_family_index,
+                              .command_buffer_count = 1}};
 
-  const auto command_buffer = copy_command_pool.command_buffers().front();
+  const auto command_buffer = command_pool.command_buffers().front();
   command_buffer.begin(vk::CommandBufferBeginInfo{.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+  auto model = std::make_unique<Model>(allocator,
+                                       command_buffer,
+                                       Model::CreateInfo{.gltf_asset = gltf_asset,
+                                                         .staging_model = staging_model,
+                                                         .material_descriptor_set_layout =
+                                                             upload_context.material_descriptor_set_layout,
+                                                         .sampler_anisotropy = upload_context.sampler_anisotropy,
+                                                         .queue_family_indices = upload_context.queue_family_indices});
+  command_buffer.end();
 
-  const auto staging_models = CreateStagingModels(allocator, gltf_assets, physical_device_features, log);
-  models_ =
-      CreateModels(allocator, command_buffer, staging_models, *material_descriptor_set_layout_, sampler_anisotropy);
+  return UploadingModel{.scene_model = SceneModel{model_id, std::move(model)},
+                        .staging_model = std::move(staging_model),
+                        .command_pool = std::move(command_pool)};
+}
 
-  command_buffer.end();
+void Scene::StreamModels(const std::stop_token stop_token, StreamingState& streaming_state) {
+  auto& [upload_context, mutex, load_request_condition, load_requests, loading_model_id, recorded_models, _] =
+      streaming_state;
+
+  for (;;) {
+    LoadRequest load_request;
+    {
+      std::unique_lock lock{mutex};
+      if (!load_request_condition.wait(lock, stop_token, [&load_requests] { return !load_requests.empty(); })) {
+        return;  // stop requested
+      }
+      load_request = std::move(load_requests.front());
+      load_requests.pop_front();
+      loading_model_id = load_request.model_id;
+    }
 
-  const auto copy_fence = device.createFenceUnique(vk::FenceCreateInfo{});
-  transfer_queue->submit(vk::SubmitInfo{.commandBufferCount = kCommandBufferCount, .pCommandBuffers = &command_buffer},
-                         *copy_fence);
+    const auto& [model_id, load_gltf_asset, log] = load_request;
+    std::optional<UploadingModel> uploading_model;
 
-  static constexpr auto kMaxTimeout = std::numeric_limits<std::uint64_t>::max();
-  const auto result = device.waitForFences(*copy_fence, vk::True, kMaxTimeout);
-  vk::detail::resultCheck(result, "Copy fence failed to enter a signaled state");
+    // assets are loaded on this thread rather than the thread pool because loading waits for thread pool tasks which
+    // could otherwise occupy every worker thread and deadlock
+    try {
+      const auto gltf_asset = load_gltf_asset();
+      // declared after the glTF asset to wait for staging texture tasks that reference it before it's destroyed
+      const auto staging_textures = CreateStagingTexturesAsync(upload_context.allocator,
+                                                               gltf_asset,
+                                                               upload_context.physical_device_features,
+                                                               upload_context.thread_pool,
+                                                               *log);
+      uploading_model.emplace(CreateUploadingModel(upload_context, model_id, gltf_asset, staging_textures, *log));
+    } catch (const std::exception& exception) {
+      (*log)(Severity::kError).Print("Failed to load model {}: {}", model_id, exception.what());
+    }
+
+    const std::lock_guard lock{mutex};
+    if (uploading_model.has_value() && loading_model_id == model_id) {
+      recorded_models.push_back(std::move(*uploading_model));
+    }
+    loading_model_id = std::nullopt;
+  }
 }
 
-void Scene::Update(HostVisibleBuffer& camera_uniform_buffer, HostVisibleBuffer& lights_uniform_buffer) {
-  std::vector<WorldLight> world_lights;
-  world_lights.reserve(light_count_);  // TODO: avoid per-frame allocation
+Model* Scene::FindModel(const ModelId model_id) noexcept {
+  const auto iterator = std::ranges::find(models_, model_id, &SceneModel::id);
+  return iterator == models_.end() ? nullptr : iterator->model.get();
+}
+
+const Model* Scene::FindModel(const ModelId model_id) const noexcept {
+  const auto iterator = std::ranges::find(models_, model_id, &SceneModel::id);
+  return iterator == models_.end() ? nullptr : iterator->model.get();
+}
 
-  for (const auto node_visitor = [&world_lights](const auto& node) { EmplaceWorldLight(node, world_lights); };
-       auto& model : models_) {
-    model.Update(node_visitor);
+Scene::ModelId Scene::AddAsync(std::function<gltf::Asset()> load_gltf_asset, Log& log) {
+  const auto model_id = next_model_id_++;
+  auto& streaming_state = *streaming_state_;
+  {
+    const std::lock_guard lock{streaming_state.mutex};
+    streaming_state.load_requests.push_back(
+        LoadRequest{.model_id = model_id, .load_gltf_asset = std::move(load_gltf_asset), .log = &log});
+  }
+  streaming_state.load_request_condition.notify_one();
+
+  // the streaming thread is only started when needed to avoid an idle thread for scenes that are never streamed
+  if (!streaming_state.thread.joinable()) {
+    streaming_state.thread = std::jthread{StreamModels, std::ref(streaming_state)};
+  }
+
+  return model_id;
+}
+
+bool Scene::Remove(const ModelId model_id) {
+  if (const auto iterator = std::ranges::find(models_, model_id, &SceneModel::id); iterator != models_.end()) {
+    light_count_ -= static_cast<std::uint32_t>(iterator->world_lights.size());
+    max_instance_count_ -= static_cast<std::uint32_t>(iterator->mesh_instances.size());
+    max_draw_count_ -= iterator->max_draw_count;
+    draw_batch_count_ -= iterator->draw_batch_commands.size();
+
+    // frames in flight may still reference model resources which are only destroyed once those frames complete
+    retired_models_.push_back(RetiredModel{.model = std::move(iterator->model), .frame_index = frame_index_});
+    models_.erase(iterator);
+    return true;
+  }
+
+  const auto get_model_id = [](const auto& uploading_model) { return uploading_model.scene_model.id; };
+  if (const auto iterator = std::ranges::find(uploading_models_, model_id, get_model_id);
+      iterator != uploading_models_.end()) {
+    // copy commands may still be executing so the model is discarded once its upload completes
+    return !std::exchange(iterator->removed, true);
+  }
+
+  auto& streaming_state = *streaming_state_;
+  const std::lock_guard lock{streaming_state.mutex};
+
+  if (std::erase_if(streaming_state.load_requests,
+                    [model_id](const auto& load_request) { return load_request.model_id == model_id; })
+      > 0) {
+    return true;
+  }
+  if (std::erase_if(streaming_state.recorded_models,
+                    [model_id, &get_model_id](const auto& recorded_model) {
+                      return get_model_id(recorded_model) == model_id;
+                    })
+      > 0) {
+    return true;  // recorded copy commands are discarded without being submitted
+  }
+  if (streaming_state.loading_model_id == model_id) {
+    streaming_state.loading_model_id = std::nullopt;  // the streaming thread discards the model once it's recorded
+    return true;
+  }
+  return false;
+}
+
+void Scene::UpdateResidentModels() {
+  const ProfileZone profile_zone{"Scene::UpdateResidentModels"};
+  ++frame_index_;
+
+  // recorded copy commands are submitted by this thread because queue submissions are externally synchronized and the
+  // transfer queue may be the same queue used to render the scene
+  if (streaming_state_->thread.joinable()) {
+    std::vector<UploadingModel> recorded_models;
+    {
+      const std::lock_guard lock{streaming_state_->mutex};
+      recorded_models.swap(streaming_state_->recorded_models);
+    }
+    for (auto& recorded_model : recorded_models) {
+      SubmitUpload(uploading_models_.emplace_back(std::move(recorded_model)));
+    }
+  }
+
+  if (!uploading_models_.empty()) {
+    // models become resident as soon as their uploads complete which allows rendering to begin while uploads continue
+    const auto device = upload_semaphore_.getOwner();
+    upload_semaphore_value_ = device.getSemaphoreCounterValue(*upload_semaphore_);
+
+    const auto uploaded_models_end = std::ranges::find_if(uploading_models_, [this](const auto& uploading_model) {
+      return uploading_model.upload_semaphore_value > upload_semaphore_value_;
+    });
+    for (auto& uploaded_model : std::ranges::subrange(uploading_models_.begin(), uploaded_models_end)) {
+      if (!uploaded_model.removed) {
+        Insert(std::move(uploaded_model.scene_model));
+      }
+    }
+    uploading_models_.erase(uploading_models_.begin(), uploaded_models_end);  // release staging resources
+  }
+
+  // the frame fence for the current frame guarantees every frame that began before the previous max_render_frames
+  // frames has completed
+  std::erase_if(retired_models_, [this](const auto& retired_model) {
+    return frame_index_ - retired_model.frame_index >= max_render_frames_;
+  });
+}
+
+void Scene::SubmitUpload(UploadingModel& uploading_model) {
+  const auto command_buffer = uploading_model.command_pool.command_buffers().front();
+  const auto upload_semaphore = *upload_semaphore_;
+
+  // a signal operation waits for all prior submissions to the same queue so the semaphore value is always the number
+  // of uploads that completed which allows the host to poll upload progress without waiting
+  const auto upload_semaphore_value = ++submitted_upload_semaphore_value_;
+  uploading_model.upload_semaphore_value = upload_semaphore_value;
+
+  const vk::TimelineSemaphoreSubmitInfo timeline_semaphore_submit_info{.signalSemaphoreValueCount = 1,
+                                                                       .pSignalSemaphoreValues =
+                                                                           &upload_semaphore_value};
+  (*transfer_queue_)->submit(vk::SubmitInfo{.pNext = &timeline_semaphore_submit_info,
+                                            .commandBufferCount = 1,
+                                            .pCommandBuffers = &command_buffer,
+                                            .signalSemaphoreCount = 1,
+                                            .pSignalSemaphores = &upload_semaphore});
+}
+
+void Scene::Insert(SceneModel&& scene_model) {
+  light_count_ += static_cast<std::uint32_t>(scene_model.world_lights.size());
+  max_instance_count_ += static_cast<std::uint32_t>(scene_model.mesh_instances.size());
+  max_draw_count_ += scene_model.max_draw_count;
+  draw_batch_count_ += scene_model.draw_batch_commands.size();
+  models_.push_back(std::move(scene_model));
+
+  // per-frame draw data is reserved when models are inserted to avoid allocations when updating the scene
+  instance_transforms_.reserve(max_instance_count_);
+  draw_commands_.reserve(max_draw_count_);
+  visible_draw_batches_.reserve(draw_batch_count_);
+}
+
+void Scene::UpdateModels() {
+  if (update_thread_pool_ == nullptr) {
+    for (auto& scene_model : models_) {
+      if (scene_model.model->Update()) {
+        scene_model.Update(nullptr);
+      }
+    }
+    return;
+  }
+
+  // update tasks for all models are submitted before waiting to allow large models to be updated concurrently
+  std::vector<SceneModel*> updated_models;
+  std::vector<std::future<void>> update_futures;
+  for (auto& scene_model : models_) {
+    auto model_update_futures = scene_model.model->UpdateAsync(*update_thread_pool_);
+    if (model_update_futures.empty()) continue;
+    updated_models.push_back(&scene_model);
+    std::ranges::move(model_update_futures, std::back_inserter(update_futures));
+  }
+  for (auto& update_future : update_futures) {
+    update_future.get();
+  }
+  for (auto* const scene_model : updated_models) {
+    scene_model->Update(update_thread_pool_);
+  }
+}
+
+void Scene::Update(HostVisibleBuffer& camera_uniform_buffer,
+                   HostVisibleBuffer& lights_uniform_buffer,
+                   HostVisibleBuffer& instance_transforms_buffer,
+                   HostVisibleBuffer& draw_commands_buffer) {
+  const ProfileZone profile_zone{"Scene::Update"};
+  UpdateModels();
+
+  // whole subtrees of mesh instances are culled with a single test when entirely inside or outside the view frustum
+  const ViewFrustum view_frustum{camera_.projection_transform() * camera_.view_transform()};
+  instance_transforms_.clear();
+
+  for (auto& scene_model : models_) {
+    auto& visibility_mask = scene_model.visibility_mask;
+    scene_model.bounding_volume_hierarchy.Cull(view_frustum, visibility_mask);
+
+    const auto& global_transforms = scene_model.model->node_hierarchy().global_transforms();
+    for (const auto& [mesh_instance_index, mesh_instance] : std::views::enumerate(scene_model.mesh_instances)) {
+      if (!IsVisible(visibility_mask, static_cast<std::size_t>(mesh_instance_index))) continue;
+      const auto& [mesh, node_index] = mesh_instance;
+      EmplaceDrawCommands(*mesh, global_transforms[node_index], instance_transforms_, scene_model.draw_batch_commands);
+    }
+  }
+
+  // draw commands are stored contiguously by draw batch to allow each batch to be rendered with a single draw call
+  draw_commands_.clear();
+  visible_draw_batches_.clear();
+  world_lights_.clear();
+
+  for (auto& scene_model : models_) {
+    const auto& model = *scene_model.model;
+    for (auto&& [draw_batch, draw_commands] : std::views::zip(model.draw_batches(), scene_model.draw_batch_commands)) {
+      if (draw_commands.empty()) continue;  // skip draw batches without visible primitives
+      visible_draw_batches_.push_back(
+          VisibleDrawBatch{.model_id = scene_model.id,
+                           .geometry_arena = &model.geometry_arena(),
+                           .draw_batch = &draw_batch,
+                           .draw_range = DrawRange{.first_draw = static_cast<std::uint32_t>(draw_commands_.size()),
+                                                   .draw_count = static_cast<std::uint32_t>(draw_commands.size())}});
+      draw_commands_.insert(draw_commands_.end(), draw_commands.begin(), draw_commands.end());
+      draw_commands.clear();
+    }
+
+    // lights beyond the fixed shader capacity are ignored which only affects models inserted after it's reached
+    const auto light_count = std::min(scene_model.world_lights.size(), max_light_count_ - world_lights_.size());
+    const auto world_lights = std::span{scene_model.world_lights}.first(light_count);
+    world_lights_.insert(world_lights_.end(), world_lights.begin(), world_lights.end());
   }
 
   camera_uniform_buffer.Copy<CameraProperties>(
       CameraProperties{.view_projection_transform = camera_.projection_transform() * camera_.view_transform(),
                        .world_position = camera_.position()});
 
-  assert(light_count_ == world_lights.size());  // ensure all scene lights are accounted for
-  lights_uniform_buffer.Copy<WorldLight>(world_lights);
+  lights_uniform_buffer.Copy<WorldLightsHeader>(
+      WorldLightsHeader{.light_count = static_cast<std::uint32_t>(world_lights_.size())});
+  lights_uniform_buffer.Copy<WorldLight>(world_lights_, sizeof(WorldLightsHeader));
+  instance_transforms_buffer.Copy<glm::mat4>(instance_transforms_);
+  draw_commands_buffer.Copy<vk::DrawIndexedIndirectCommand>(draw_commands_);
+}
+
+void Scene::Render(const vk::CommandBuffer command_buffer,
+                   const vk::DescriptorSet global_descriptor_set,
+                   const vk::Buffer draw_commands_buffer,
+                   GpuProfiler* const gpu_profiler) const {
+  const ProfileZone profile_zone{"Scene::Render"};
+  RecordDrawCommands(command_buffer, global_descriptor_set, draw_commands_buffer, 0, draw_count(), gpu_profiler);
 }
 
-void Scene::Render(const vk::CommandBuffer command_buffer, const vk::DescriptorSet global_descriptor_set) const {
+std::span<const vk::CommandBuffer> Scene::Render(const std::span<const vk::CommandBuffer> command_buffers,
+                                                 const vk::CommandBufferInheritanceInfo& inheritance_info,
+                                                 const vk::DescriptorSet global_descriptor_set,
+                                                 const vk::Buffer draw_commands_buffer,
+                                                 ThreadPool& thread_pool,
+                                                 GpuProfiler* const gpu_profiler) const {
+  const ProfileZone profile_zone{"Scene::Render"};
+  // draw commands are divided evenly regardless of draw batch boundaries which balances recording work between command
+  // buffers when a few draw batches contain most visible primitives
+  static constexpr auto kMinCommandBufferDrawCount = 256u;
+  const auto visible_draw_count = draw_count();
+  const auto command_buffer_count =
+      std::min(command_buffers.size(),
+               static_cast<std::size_t>((visible_draw_count + kMinCommandBufferDrawCount - 1)
+                                        / kMinCommandBufferDrawCount));
+  if (command_buffer_count == 0) return {};
+
+  const auto recorded_command_buffers = command_buffers.first(command_buffer_count);
+  const auto command_buffer_draw_count =
+      static_cast<std::uint32_t>((visible_draw_count + command_buffer_count - 1) / command_buffer_count);
+
+  std::vector<std::future<void>> record_futures;
+  record_futures.reserve(command_buffer_count);
+
+  for (auto first_draw = 0u; const auto command_buffer : recorded_command_buffers) {
+    const auto last_draw = std::min(first_draw + command_buffer_draw_count, visible_draw_count);
+    record_futures.push_back(thread_pool.Submit(
+        [this,
+         command_buffer,
+         &inheritance_info,
+         global_descriptor_set,
+         draw_commands_buffer,
+         first_draw,
+         last_draw,
+         gpu_profiler] {
+          using enum vk::CommandBufferUsageFlagBits;
+          command_buffer.begin(
+              vk::CommandBufferBeginInfo{.flags = eRenderPassContinue | eOneTimeSubmit,
+                                         .pInheritanceInfo = &inheritance_info});
+          RecordDrawCommands(command_buffer,
+                             global_descriptor_set,
+                             draw_commands_buffer,
+                             first_draw,
+                             last_draw,
+                             gpu_profiler);
+          command_buffer.end();
+        }));
+    first_draw = last_draw;
+  }
+
+  for (auto& record_future : record_futures) {
+    record_future.get();
+  }
+
+  return recorded_command_buffers;
+}
+
+void Scene::RecordDrawCommands(const vk::CommandBuffer command_buffer,
+                               const vk::DescriptorSet global_descriptor_set,
+                               const vk::Buffer draw_commands_buffer,
+                               const std::uint32_t first_draw,
+                               const std::uint32_t last_draw,
+                               GpuProfiler* const gpu_profiler) const {
+  const ProfileZone profile_zone{"Scene::RecordDrawCommands"};
   using enum vk::PipelineBindPoint;
   command_buffer.bindPipeline(eGraphics, *graphics_pipeline_);
 
   const auto graphics_pipeline_layout = graphics_pipeline_.layout();
   command_buffer.bindDescriptorSets(eGraphics, graphics_pipeline_layout, 0, global_descriptor_set, nullptr);
 
-  for (const ViewFrustum view_frustum{camera_.projection_transform() * camera_.view_transform()};
-       const auto& model : models_) {
-    model.Render(command_buffer, graphics_pipeline_layout, view_frustum);
+  // find the first visible draw batch containing first_draw which may be partially recorded by another command buffer
+  auto visible_draw_batch =
+      std::ranges::upper_bound(visible_draw_batches_, first_draw, std::ranges::less{}, [](const auto& visible_batch) {
+        return visible_batch.draw_range.first_draw;
+      });
+  if (visible_draw_batch != visible_draw_batches_.begin()) --visible_draw_batch;
+
+  const GeometryArena* bound_geometry_arena = nullptr;
+  std::optional<vk::IndexType> bound_index_type;
+
+  // visible draw batches are contiguous for each model which allows draw commands to be timed per model without
+  // splitting draw batches where models divided between command buffers are timed in each and summed by the profiler
+  std::optional<ModelId> profiled_model_id;
+  std::optional<GpuProfileZone> model_gpu_profile_zone;
+
+  for (; visible_draw_batch != visible_draw_batches_.end(); ++visible_draw_batch) {
+    const auto& [model_id, geometry_arena, draw_batch, draw_range] = *visible_draw_batch;
+    const auto batch_first_draw = std::max(first_draw, draw_range.first_draw);
+    const auto batch_last_draw = std::min(last_draw, draw_range.first_draw + draw_range.draw_count);
+    if (batch_first_draw >= batch_last_draw) break;
+
+    if (gpu_profiler != nullptr && profiled_model_id != model_id) {
+      model_gpu_profile_zone.reset();  // end the zone for the previous model before beginning the next one
+      model_gpu_profile_zone.emplace(gpu_profiler, command_buffer, "Model", model_id);
+      profiled_model_id = model_id;
+    }
+
+    if (bound_geometry_arena != geometry_arena) {
+      geometry_arena->BindVertexBuffer(command_buffer);  // all model primitives share a single vertex buffer
+      bound_geometry_arena = geometry_arena;
+      bound_index_type = std::nullopt;
+    }
+
+    command_buffer.bindDescriptorSets(eGraphics,
+                                      graphics_pipeline_layout,
+                                      1,
+                                      draw_batch->material_descriptor_set,
+                                      nullptr);
+
+    if (bound_index_type != draw_batch->index_type) {
+      geometry_arena->BindIndexBuffer(command_buffer, draw_batch->index_type);
+      bound_index_type = draw_batch->index_type;
+    }
+
+    const auto batch_draw_count = batch_last_draw - batch_first_draw;
+    if (multi_draw_indirect_) {
+      static constexpr auto kDrawCommandSize = static_cast<std::uint32_t>(sizeof(vk::DrawIndexedIndirectCommand));
+      command_buffer.drawIndexedIndirect(draw_commands_buffer,
+                                         static_cast<vk::DeviceSize>(batch_first_draw) * kDrawCommandSize,
+                                         batch_draw_count,
+                                         kDrawCommandSize);
+    } else {
+      for (const auto& draw_command : std::span{draw_commands_}.subspan(batch_first_draw, batch_draw_count)) {
+        command_buffer.drawIndexed(draw_command.indexCount,
+                                   draw_command.instanceCount,
+                                   draw_command.firstIndex,
+                                   draw_command.vertexOffset,
+                                   draw_command.firstInstance);
+      }
+    }
   }
 }
 
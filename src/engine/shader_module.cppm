@@ -1,13 +1,18 @@
 module;
 
+#include <cstddef>
 #include <exception>
 #include <filesystem>
 #include <format>
 #include <fstream>
 #include <ios>
+#include <ranges>
+#include <span>
 #include <spanstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <glslang/Include/glslang_c_interface.h>
 #include <vulkan/vulkan.hpp>
@@ -16,6 +21,7 @@ export module shader_module;
 
 import glslang_compiler;
 import log;
+import thread_pool;
 
 namespace vktf {
 
@@ -35,6 +41,18 @@ public:
     /** @brief The stage the shader module will be used for. */
     vk::ShaderStageFlagBits shader_stage{};
 
+    /**
+     * @brief The preprocessor macros to define in the form @c NAME or @c NAME=VALUE when compiling GLSL shaders.
+     * @note This is ignored for SPIR-V binaries.
+     */
+    std::span<const std::string> defines;
+
+    /**
+     * @brief The SPIR-V cache for GLSL shaders compiled at runtime.
+     * @note A value of @c nullptr indicates GLSL shaders should always be compiled.
+     */
+    glslang::SpirvCache* spirv_cache = nullptr;
+
     /** @brief The log for writing messages when creating a shader module. */
     Log& log;
   };
@@ -48,6 +66,13 @@ public:
    */
   ShaderModule(vk::Device device, const CreateInfo& create_info);
 
+  /**
+   * @brief Creates a @ref ShaderModule from a SPIR-V binary.
+   * @param device The device for creating the shader module.
+   * @param spirv_binary The SPIR-V binary for the shader module.
+   */
+  ShaderModule(vk::Device device, std::span<const SpirvWord> spirv_binary);
+
   /** @brief Gets the underlying Vulkan shader module handle. */
   [[nodiscard]] vk::ShaderModule operator*() const noexcept { return *shader_module_; }
 
@@ -55,6 +80,22 @@ private:
   vk::UniqueShaderModule shader_module_;
 };
 
+/**
+ * @brief Creates multiple shader modules.
+ * @details GLSL shaders are compiled concurrently with @ref glslang::Compile which allows shader permutations to be
+ *          created in roughly the time it takes to compile the slowest shader.
+ * @param device The device for creating shader modules.
+ * @param create_infos The parameters for creating each shader module.
+ * @param thread_pool The thread pool for compiling GLSL shaders concurrently.
+ * @return The shader module for each element in @p create_infos in the same order.
+ * @throws std::runtime_error Thrown if any shader file is not a valid SPIR-V binary or GLSL shader.
+ * @warning This function waits on thread pool tasks and must not be called from a worker thread in @p thread_pool.
+ */
+export [[nodiscard]] std::vector<ShaderModule> CreateShaderModules(
+    vk::Device device,
+    std::span<const ShaderModule::CreateInfo> create_infos,
+    ThreadPool& thread_pool);
+
 }  // namespace vktf
 
 module :private;
@@ -136,27 +177,49 @@ glslang_stage_t GetGlslangStage(const vk::ShaderStageFlagBits shader_stage) {
   }
 }
 
-std::vector<SpirvWord> GetSpirvBinary(const std::filesystem::path& shader_filepath,
-                                      const vk::ShaderStageFlagBits shader_stage,
-                                      Log& log) {
-  try {
-    if (shader_filepath.extension() == ".spv") return ReadSpirvFile(shader_filepath);
-
-    const auto glsl_shader = ReadGlslFile(shader_filepath);
-    const auto glslang_stage = GetGlslangStage(shader_stage);
-    return glslang::Compile(glsl_shader, glslang_stage, log);
+std::vector<std::vector<SpirvWord>> GetSpirvBinaries(const std::span<const ShaderModule::CreateInfo> create_infos,
+                                                     ThreadPool* const thread_pool) {
+  std::vector<std::vector<SpirvWord>> spirv_binaries(create_infos.size());
+  std::vector<std::string> glsl_shaders(create_infos.size());  // referenced by compile infos until compilation ends
+  std::vector<glslang::CompileInfo> compile_infos;
+  std::vector<std::size_t> glsl_shader_indices;
+
+  // shader files are read up front which allows all GLSL shaders to be compiled in a single batch
+  for (const auto& [index, create_info] : std::views::enumerate(create_infos)) {
+    const auto& [shader_filepath, shader_stage, defines, spirv_cache, log] = create_info;
+    const auto shader_index = static_cast<std::size_t>(index);
+    try {
+      if (shader_filepath.extension() == ".spv") {
+        spirv_binaries[shader_index] = ReadSpirvFile(shader_filepath);
+        continue;
+      }
+      glsl_shaders[shader_index] = ReadGlslFile(shader_filepath);
+    } catch (const std::ios::failure&) {
+      std::throw_with_nested(std::runtime_error{std::format("Failed to read {}", shader_filepath.string())});
+    }
+    compile_infos.push_back(glslang::CompileInfo{.glsl_shader = glsl_shaders[shader_index],
+                                                 .glslang_stage = GetGlslangStage(shader_stage),
+                                                 .defines = defines,
+                                                 .spirv_cache = spirv_cache,
+                                                 .log = log});
+    glsl_shader_indices.push_back(shader_index);
+  }
 
-  } catch (const std::ios::failure&) {
-    std::throw_with_nested(std::runtime_error{std::format("Failed to read {}", shader_filepath.string())});
+  // a single shader module is created without a thread pool in which case shaders are compiled on the calling thread
+  auto glsl_spirv_binaries =
+      thread_pool != nullptr
+          ? glslang::Compile(compile_infos, *thread_pool)
+          : compile_infos  //
+                | std::views::transform([](const auto& compile_info) { return glslang::Compile(compile_info); })
+                | std::ranges::to<std::vector>();
+  for (auto&& [shader_index, spirv_binary] : std::views::zip(glsl_shader_indices, glsl_spirv_binaries)) {
+    spirv_binaries[shader_index] = std::move(spirv_binary);
   }
-}
 
-vk::UniqueShaderModule CreateShaderModule(const vk::Device device,
-                                          const std::filesystem::path& shader_filepath,
-                                          const vk::ShaderStageFlagBits shader_stage,
-                                          Log& log) {
-  const auto spirv_binary = GetSpirvBinary(shader_filepath, shader_stage, log);
+  return spirv_binaries;
+}
 
+vk::UniqueShaderModule CreateShaderModule(const vk::Device device, const std::span<const SpirvWord> spirv_binary) {
   return device.createShaderModuleUnique(
       vk::ShaderModuleCreateInfo{.codeSize = spirv_binary.size() * kSpirvWordSize, .pCode = spirv_binary.data()});
 }
@@ -164,7 +227,17 @@ vk::UniqueShaderModule CreateShaderModule(const vk::Device device,
 }  // namespace
 
 ShaderModule::ShaderModule(const vk::Device device, const CreateInfo& create_info)
-    : shader_module_{
-          CreateShaderModule(device, create_info.shader_filepath, create_info.shader_stage, create_info.log)} {}
+    : ShaderModule{device, GetSpirvBinaries(std::span{&create_info, 1}, nullptr).front()} {}
+
+ShaderModule::ShaderModule(const vk::Device device, const std::span<const SpirvWord> spirv_binary)
+    : shader_module_{CreateShaderModule(device, spirv_binary)} {}
+
+std::vector<ShaderModule> CreateShaderModules(const vk::Device device,
+                                              const std::span<const ShaderModule::CreateInfo> create_infos,
+                                              ThreadPool& thread_pool) {
+  return GetSpirvBinaries(create_infos, &thread_pool)  //
+         | std::views::transform([device](const auto& spirv_binary) { return ShaderModule{device, spirv_binary}; })
+         | std::ranges::to<std::vector>();
+}
 
 }  // namespace vktf
@@ -152,7 +152,7 @@ Swapchain::Swapchain(const vk::Device device, const CreateInfo& create_info) {
       .presentMode = GetSwapchainPresentMode(physical_device, surface),
       .clipped = vk::True};
 
-  const auto& [graphics_queue_family, present_queue_family] = queue_families;
+  const auto& [graphics_queue_family, present_queue_family, _] = queue_families;
   const std::array queue_family_indices{graphics_queue_family.index, present_queue_family.index};
 
   if (graphics_queue_family.index != present_queue_family.index) {
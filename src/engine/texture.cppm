@@ -1,6 +1,7 @@
 module;
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 #include <ktx.h>
@@ -62,6 +63,9 @@ public:
 
     /** @brief The sampler defining how to filter the underlying texture image. */
     vk::Sampler sampler;
+
+    /** @brief @copybrief Image::CreateInfo::queue_family_indices */
+    std::span<const std::uint32_t> queue_family_indices;
   };
 
   /**
@@ -94,7 +98,8 @@ namespace {
 
 Image CreateDeviceLocalImage(const vma::Allocator& allocator,
                              const vk::CommandBuffer command_buffer,
-                             const StagingTexture& staging_texture) {
+                             const StagingTexture& staging_texture,
+                             const std::span<const std::uint32_t> queue_family_indices) {
   Image device_local_image{
       allocator,
       Image::CreateInfo{.format = staging_texture.image_format(),
@@ -103,7 +108,8 @@ Image CreateDeviceLocalImage(const vma::Allocator& allocator,
                         .sample_count = vk::SampleCountFlagBits::e1,
                         .usage_flags = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst,
                         .aspect_mask = vk::ImageAspectFlagBits::eColor,
-                        .allocation_create_info = vma::kDeviceLocalAllocationCreateInfo}};
+                        .allocation_create_info = vma::kDeviceLocalAllocationCreateInfo,
+                        .queue_family_indices = queue_family_indices}};
   device_local_image.Copy(*staging_texture.buffer(), staging_texture.buffer_image_copies(), command_buffer);
   return device_local_image;
 }
@@ -117,7 +123,10 @@ StagingTexture::StagingTexture(const vma::Allocator& allocator, const ktxTexture
       image_extent_{ktx_texture2.baseWidth, ktx_texture2.baseHeight} {}
 
 Texture::Texture(const vma::Allocator& allocator, const vk::CommandBuffer command_buffer, const CreateInfo& create_info)
-    : image_{CreateDeviceLocalImage(allocator, command_buffer, create_info.staging_texture)},
+    : image_{CreateDeviceLocalImage(allocator,
+                                    command_buffer,
+                                    create_info.staging_texture,
+                                    create_info.queue_family_indices)},
       sampler_{create_info.sampler} {}
 
 }  // namespace vktf
@@ -0,0 +1,214 @@
+module;
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX  // prevents min and max macros from conflicting with std::max
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+export module thread_pool;
+
+namespace vktf {
+
+/**
+ * @brief A bounded pool of worker threads for executing independent tasks.
+ * @details Each worker thread owns a task queue. Tasks submitted from outside the pool are distributed across queues
+ *          in round-robin order whereas tasks submitted from a worker thread are added to that worker's own queue.
+ *          Workers execute tasks from their own queue in last-in, first-out order and steal tasks from the front of
+ *          other queues when their own queue is empty which prevents a single long-running task from delaying tasks
+ *          queued behind it.
+ * @code
+ * vktf::ThreadPool thread_pool;
+ * auto future = thread_pool.Submit([] { return 42; });
+ * assert(future.get() == 42);
+ * @endcode
+ */
+export class [[nodiscard]] ThreadPool {
+public:
+  /** @brief The scheduling priority of worker threads relative to other threads in the process. */
+  enum class Priority : std::uint8_t {
+    kNormal,
+    kLow  ///< Used for background work such as asset streaming that should not delay latency-sensitive threads.
+  };
+
+  /**
+   * @brief Creates a @ref ThreadPool.
+   * @param thread_count The number of worker threads. A value of zero uses the number of concurrent threads supported
+   *                     by the hardware.
+   * @param priority The scheduling priority of worker threads. Lowering the priority is best effort and is ignored on
+   *                 platforms that do not support it.
+   */
+  explicit ThreadPool(std::uint32_t thread_count = 0, Priority priority = Priority::kNormal);
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) noexcept = delete;
+
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) noexcept = delete;
+
+  /** @brief Executes all remaining tasks and joins worker threads. */
+  ~ThreadPool() noexcept = default;
+
+  /** @brief Gets the number of worker threads. */
+  [[nodiscard]] std::size_t thread_count() const noexcept { return workers_.size(); }
+
+  /**
+   * @brief Submits a task for asynchronous execution.
+   * @tparam Fn The callable function type for @p fn.
+   * @param fn The task to execute on a worker thread.
+   * @return A future containing the result of @p fn or the exception it threw.
+   * @warning Waiting on a future from a worker thread can deadlock if all workers are waiting.
+   */
+  template <typename Fn>
+    requires std::invocable<std::decay_t<Fn>&>
+  [[nodiscard]] std::future<std::invoke_result_t<std::decay_t<Fn>&>> Submit(Fn&& fn) {
+    using Result = std::invoke_result_t<std::decay_t<Fn>&>;
+    // packaged tasks are move-only and must be shared to satisfy the copy requirement of std::function
+    auto packaged_task = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+    auto future = packaged_task->get_future();
+    Push([packaged_task = std::move(packaged_task)] { (*packaged_task)(); });
+    return future;
+  }
+
+private:
+  using Task = std::function<void()>;
+
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void Push(Task task);
+  [[nodiscard]] std::optional<Task> TryPop(std::size_t queue_index);
+  void Work(const std::stop_token& stop_token, std::size_t queue_index, Priority priority);
+
+  std::vector<TaskQueue> task_queues_;
+  std::mutex mutex_;
+  std::condition_variable_any task_available_;
+  std::size_t pending_task_count_ = 0;  // guarded by mutex_
+  std::atomic<std::size_t> next_queue_index_ = 0;
+  std::vector<std::jthread> workers_;  // must be declared last to join workers before task queues are destroyed
+};
+
+}  // namespace vktf
+
+module :private;
+
+namespace vktf {
+
+namespace {
+
+// identifies the thread pool and task queue owned by the current worker thread to keep nested tasks local
+thread_local const void* current_thread_pool = nullptr;
+thread_local std::size_t current_queue_index = 0;
+
+std::size_t GetThreadCount(const std::uint32_t thread_count) {
+  return thread_count == 0 ? std::max(std::thread::hardware_concurrency(), 1u) : thread_count;
+}
+
+void SetCurrentThreadPriority(const ThreadPool::Priority priority) {
+  if (priority == ThreadPool::Priority::kNormal) return;
+#ifdef _WIN32
+  SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#elif defined(__linux__)
+  // linux schedules threads as individual tasks so the nice value of the calling thread is adjusted by its thread ID
+  static constexpr auto kLowPriorityNiceValue = 10;
+  setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()), kLowPriorityNiceValue);
+#endif
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(const std::uint32_t thread_count, const Priority priority)
+    : task_queues_(GetThreadCount(thread_count)) {
+  workers_.reserve(task_queues_.size());
+  for (auto queue_index = 0uz; queue_index < task_queues_.size(); ++queue_index) {
+    workers_.emplace_back([this, queue_index, priority](const std::stop_token& stop_token) {
+      Work(stop_token, queue_index, priority);
+    });
+  }
+}
+
+void ThreadPool::Push(Task task) {
+  const auto queue_index = current_thread_pool == this
+                               ? current_queue_index
+                               : next_queue_index_.fetch_add(1, std::memory_order_relaxed) % task_queues_.size();
+  {
+    // the pending task count is incremented before the task becomes visible to workers so it never underflows
+    const std::scoped_lock lock{mutex_};
+    ++pending_task_count_;
+    auto& [task_queue_mutex, tasks] = task_queues_[queue_index];
+    const std::scoped_lock task_queue_lock{task_queue_mutex};
+    tasks.push_back(std::move(task));
+  }
+  task_available_.notify_one();
+}
+
+std::optional<ThreadPool::Task> ThreadPool::TryPop(const std::size_t queue_index) {
+  const auto pop = [this](TaskQueue& task_queue, const bool steal) -> std::optional<Task> {
+    std::unique_lock task_queue_lock{task_queue.mutex};
+    if (task_queue.tasks.empty()) return std::nullopt;
+
+    // owners take the most recently queued task while thieves take the oldest task to reduce contention
+    Task task;
+    if (steal) {
+      task = std::move(task_queue.tasks.front());
+      task_queue.tasks.pop_front();
+    } else {
+      task = std::move(task_queue.tasks.back());
+      task_queue.tasks.pop_back();
+    }
+    task_queue_lock.unlock();
+
+    const std::scoped_lock lock{mutex_};
+    --pending_task_count_;
+    return task;
+  };
+
+  if (auto task = pop(task_queues_[queue_index], false)) return task;
+
+  for (auto offset = 1uz; offset < task_queues_.size(); ++offset) {
+    if (auto task = pop(task_queues_[(queue_index + offset) % task_queues_.size()], true)) return task;
+  }
+
+  return std::nullopt;
+}
+
+void ThreadPool::Work(const std::stop_token& stop_token, const std::size_t queue_index, const Priority priority) {
+  SetCurrentThreadPriority(priority);
+  current_thread_pool = this;
+  current_queue_index = queue_index;
+
+  for (;;) {
+    if (auto task = TryPop(queue_index)) {
+      (*task)();  // packaged tasks store exceptions in their associated future
+      continue;
+    }
+
+    // remaining tasks are drained before exiting when a stop is requested during destruction
+    std::unique_lock lock{mutex_};
+    if (!task_available_.wait(lock, stop_token, [this] { return pending_task_count_ > 0; })) return;
+  }
+}
+
+}  // namespace vktf
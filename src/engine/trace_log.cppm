@@ -0,0 +1,675 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <source_location>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+export module trace_log;
+
+import hash;
+import mapped_file;
+
+namespace vktf {
+
+enum class TraceArgumentType : std::uint8_t { kBool, kChar, kInt64, kUint64, kDouble, kString };
+
+/**
+ * @brief A binary log sink that records messages into a memory-mapped ring file.
+ * @details Instead of formatting text, each message is recorded as its severity, a source location ID, a timestamp,
+ *          and its raw format arguments. Records are appended to a fixed-size ring with a lock-free reservation which
+ *          reduces the cost of logging on hot paths to copying arguments into mapped memory. When the ring is full, the
+ *          oldest records are overwritten. Trace files are decoded back to text offline with @ref DecodeTrace.
+ */
+export class [[nodiscard]] TraceLog {
+public:
+  /** @brief The default size in bytes of the record ring. */
+  static constexpr std::size_t kDefaultRingSize = 64ull << 20u;
+
+  /** @brief The default size in bytes of the table that stores source locations and format strings. */
+  static constexpr std::size_t kDefaultSiteTableSize = 1ull << 20u;
+
+  /** @brief The maximum size in bytes of a string argument. Longer strings are truncated. */
+  static constexpr std::size_t kMaxStringSize = 4096;
+
+  /** @brief The parameters for creating a @ref TraceLog. */
+  struct CreateInfo {
+    /** @brief The filepath of the trace file to create or overwrite. */
+    std::filesystem::path trace_filepath;
+
+    /** @brief The size in bytes of the record ring. Must be a multiple of 8 and at least 64 KiB. */
+    std::size_t ring_size = kDefaultRingSize;
+
+    /** @brief The size in bytes of the table for source locations and format strings. Must be a multiple of 8. */
+    std::size_t site_table_size = kDefaultSiteTableSize;
+  };
+
+  /**
+   * @brief Creates a @ref TraceLog.
+   * @param create_info @copybrief TraceLog::CreateInfo
+   * @throws std::runtime_error Thrown if the ring size is invalid or the trace file could not be created.
+   */
+  explicit TraceLog(const CreateInfo& create_info);
+
+  TraceLog(const TraceLog&) = delete;
+  TraceLog(TraceLog&&) noexcept = delete;
+
+  TraceLog& operator=(const TraceLog&) = delete;
+  TraceLog& operator=(TraceLog&&) noexcept = delete;
+
+  /**
+   * @brief Destroys a @ref TraceLog.
+   * @details Source locations cached by each thread for this trace log are released the next time that thread records
+   *          a message to any trace log.
+   */
+  ~TraceLog() noexcept;
+
+  /**
+   * @brief Records a message.
+   * @details Arithmetic and string arguments are recorded as raw values. Other arguments are formatted to a string.
+   * @param severity The message severity which corresponds to the underlying value of @c Log::Severity.
+   * @param source_location The source code location indicating where the message originates from.
+   * @param format The format string used to decode the message.
+   * @param args The message format arguments.
+   */
+  template <typename... Args>
+  void Write(const std::uint8_t severity,
+             const std::source_location& source_location,
+             const std::string_view format,
+             const Args&... args) {
+    static_assert(sizeof...(Args) <= kMaxArgumentCount, "Too many trace log arguments");
+    const RecordBuffer record_buffer;
+    auto& record = *record_buffer;
+    BeginRecord(record, severity, source_location, format, sizeof...(Args));
+    (WriteArgument(record, args), ...);
+    EndRecord(record);
+  }
+
+private:
+  static constexpr std::size_t kMaxArgumentCount = 16;
+
+  struct SiteKey {
+    const char* file_name = nullptr;
+    const char* format = nullptr;
+    std::uint32_t line = 0;
+
+    [[nodiscard]] bool operator==(const SiteKey&) const noexcept = default;
+  };
+
+  struct SiteKeyHash {
+    [[nodiscard]] std::size_t operator()(const SiteKey& site_key) const noexcept;
+  };
+
+  using SiteIds = std::unordered_map<SiteKey, std::uint32_t, SiteKeyHash>;
+
+  // a per-thread record buffer that is reentrant for arguments whose formatters record messages while being written
+  class [[nodiscard]] RecordBuffer {
+  public:
+    RecordBuffer();
+
+    RecordBuffer(const RecordBuffer&) = delete;
+    RecordBuffer(RecordBuffer&&) noexcept = delete;
+
+    RecordBuffer& operator=(const RecordBuffer&) = delete;
+    RecordBuffer& operator=(RecordBuffer&&) noexcept = delete;
+
+    ~RecordBuffer() noexcept;
+
+    [[nodiscard]] std::vector<std::byte>& operator*() const noexcept { return *record_; }
+
+  private:
+    std::vector<std::byte>* record_ = nullptr;
+  };
+
+  template <typename T>
+  static void WriteArgument(std::vector<std::byte>& record, const T& argument) {
+    if constexpr (std::same_as<T, bool>) {
+      WriteValue(record, TraceArgumentType::kBool, argument);
+    } else if constexpr (std::same_as<T, char>) {
+      WriteValue(record, TraceArgumentType::kChar, argument);
+    } else if constexpr (std::signed_integral<T>) {
+      WriteValue(record, TraceArgumentType::kInt64, static_cast<std::int64_t>(argument));
+    } else if constexpr (std::unsigned_integral<T>) {
+      WriteValue(record, TraceArgumentType::kUint64, static_cast<std::uint64_t>(argument));
+    } else if constexpr (std::floating_point<T>) {
+      WriteValue(record, TraceArgumentType::kDouble, static_cast<double>(argument));
+    } else if constexpr (std::convertible_to<const T&, std::string_view>) {
+      WriteString(record, std::string_view{argument});
+    } else {
+      WriteString(record, std::format("{}", argument));
+    }
+  }
+
+  template <typename T>
+  static void WriteValue(std::vector<std::byte>& record, const TraceArgumentType argument_type, const T value) {
+    record.push_back(static_cast<std::byte>(argument_type));
+    const auto value_bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+    record.insert(record.end(), value_bytes.begin(), value_bytes.end());
+  }
+
+  static void WriteString(std::vector<std::byte>& record, std::string_view value);
+
+  void BeginRecord(std::vector<std::byte>& record,
+                   std::uint8_t severity,
+                   const std::source_location& source_location,
+                   std::string_view format,
+                   std::size_t argument_count);
+  void EndRecord(std::vector<std::byte>& record);
+
+  [[nodiscard]] std::uint32_t GetSiteId(const std::source_location& source_location, std::string_view format);
+
+  WritableMappedFile trace_file_;
+  std::uint64_t id_;
+  std::chrono::steady_clock::time_point start_time_;
+  std::mutex site_mutex_;
+  SiteIds site_ids_;
+};
+
+/**
+ * @brief Decodes a trace file recorded by @ref TraceLog to text.
+ * @details Each message is written on a separate line with its elapsed time in seconds since the trace began, its
+ *          severity, and its source location. Messages are written from oldest to newest and records which were not
+ *          completely written (e.g., because the process terminated while logging) are skipped.
+ * @param trace_data The contents of the trace file.
+ * @param ostream The output stream to write decoded messages to.
+ * @return The number of decoded messages.
+ * @throws std::runtime_error Thrown if @p trace_data is not a valid trace file.
+ */
+export std::size_t DecodeTrace(std::span<const std::byte> trace_data, std::ostream& ostream);
+
+}  // namespace vktf
+
+module :private;
+
+namespace vktf {
+
+namespace {
+
+constexpr std::uint64_t kTraceMagic = 0x4543415254465456;  // "VTFTRACE" in little-endian byte order
+constexpr std::uint32_t kTraceVersion = 1;
+constexpr std::uint32_t kPaddingSiteId = 0xFFFFFFFF;
+constexpr std::uint32_t kUnknownSiteId = 0xFFFFFFFE;
+constexpr std::size_t kMinRingSize = 64ull << 10u;
+constexpr std::size_t kRecordAlignment = 8;
+constexpr std::array<std::string_view, 3> kSeverityNames{"INFO", "WARNING", "ERROR"};
+
+// fields updated while tracing are accessed with atomic references because the header is shared with mapped memory
+struct TraceHeader {
+  std::uint64_t magic = kTraceMagic;
+  std::uint32_t version = kTraceVersion;
+  std::uint32_t site_count = 0;
+  std::uint64_t site_table_size = 0;
+  std::uint64_t site_table_used_size = 0;
+  std::uint64_t ring_size = 0;
+  std::uint64_t write_offset = 0;  // the total number of bytes reserved in the ring since tracing began
+  std::int64_t start_time_ns = 0;  // the system time when tracing began in nanoseconds since the Unix epoch
+  std::uint64_t reserved = 0;
+};
+
+static_assert(sizeof(TraceHeader) == 64);
+
+struct RecordHeader {
+  std::uint64_t end_offset = 0;  // written last to indicate the record is complete and to identify its ring position
+  std::int64_t timestamp_ns = 0;
+  std::uint32_t size = 0;
+  std::uint32_t site_id = 0;
+  std::uint8_t severity = 0;
+  std::uint8_t argument_count = 0;
+  std::array<std::uint8_t, 6> padding{};
+};
+
+static_assert(sizeof(RecordHeader) == 32);
+
+struct SiteHeader {
+  std::uint32_t line = 0;
+  std::uint32_t file_name_size = 0;
+  std::uint32_t format_size = 0;
+};
+
+struct Site {
+  std::string_view file_name;
+  std::string_view format;
+  std::uint32_t line = 0;
+};
+
+using Argument = std::variant<bool, char, std::int64_t, std::uint64_t, double, std::string_view>;
+
+template <typename T>
+T Read(const std::span<const std::byte> data, const std::size_t offset) {
+  if (offset + sizeof(T) > data.size()) throw std::runtime_error{"Unexpected end of trace data"};
+  T value{};
+  std::memcpy(&value, data.data() + offset, sizeof(T));
+  return value;
+}
+
+// ===================================================================================================================
+// Encoding
+// ===================================================================================================================
+
+TraceHeader& GetTraceHeader(const std::span<std::byte> trace_data) {
+  return *reinterpret_cast<TraceHeader*>(trace_data.data());  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+std::span<std::byte> GetSiteTable(const std::span<std::byte> trace_data, const TraceHeader& trace_header) {
+  return trace_data.subspan(sizeof(TraceHeader), trace_header.site_table_size);
+}
+
+std::span<std::byte> GetRing(const std::span<std::byte> trace_data, const TraceHeader& trace_header) {
+  return trace_data.subspan(sizeof(TraceHeader) + trace_header.site_table_size, trace_header.ring_size);
+}
+
+// tracks trace logs that have not been destroyed which allows threads to prune sites cached for destroyed trace logs
+struct TraceLogRegistry {
+  std::mutex mutex;
+  std::uint64_t next_id = 0;              // guarded by mutex
+  std::unordered_set<std::uint64_t> ids;  // guarded by mutex
+  std::atomic<std::uint64_t> destroyed_count = 0;
+};
+
+TraceLogRegistry& GetTraceLogRegistry() {
+  static TraceLogRegistry trace_log_registry;
+  return trace_log_registry;
+}
+
+std::uint64_t RegisterTraceLog() {
+  auto& trace_log_registry = GetTraceLogRegistry();
+  const std::scoped_lock lock{trace_log_registry.mutex};
+  trace_log_registry.ids.insert(trace_log_registry.next_id);
+  return trace_log_registry.next_id++;
+}
+
+// each nesting level of a thread reuses its own record buffer which keeps records intact when formatting an argument
+// records another message and a deque keeps references to outer record buffers valid as nested buffers are added
+thread_local std::deque<std::vector<std::byte>> thread_records;
+thread_local std::size_t thread_record_depth = 0;
+
+std::size_t GetTraceFileSize(const TraceLog::CreateInfo& create_info) {
+  if (create_info.ring_size < kMinRingSize || create_info.ring_size % kRecordAlignment != 0) {
+    throw std::runtime_error{std::format("Invalid trace log ring size {}", create_info.ring_size)};
+  }
+  if (create_info.site_table_size % kRecordAlignment != 0) {
+    throw std::runtime_error{std::format("Invalid trace log site table size {}", create_info.site_table_size)};
+  }
+  return sizeof(TraceHeader) + create_info.site_table_size + create_info.ring_size;
+}
+
+// records are published by writing their end offset last which allows the decoder to detect incomplete records
+void PublishRecord(const std::span<std::byte> ring,
+                   const std::uint64_t offset,
+                   const std::span<const std::byte> record,
+                   const std::uint64_t end_offset) {
+  auto* const record_data = ring.data() + offset % ring.size();
+  std::memcpy(record_data + sizeof(RecordHeader::end_offset),
+              record.data() + sizeof(RecordHeader::end_offset),
+              record.size() - sizeof(RecordHeader::end_offset));
+  std::atomic_ref{*reinterpret_cast<std::uint64_t*>(record_data)}.store(end_offset, std::memory_order_release);
+}
+
+// ===================================================================================================================
+// Decoding
+// ===================================================================================================================
+
+std::vector<Site> ReadSites(const std::span<const std::byte> site_table, const std::uint32_t site_count) {
+  std::vector<Site> sites;
+  sites.reserve(site_count);
+
+  for (std::size_t offset = 0; sites.size() < site_count;) {
+    const auto site_header = Read<SiteHeader>(site_table, offset);
+    offset += sizeof(SiteHeader);
+    if (offset + site_header.file_name_size + site_header.format_size > site_table.size()) {
+      throw std::runtime_error{"Unexpected end of trace site table"};
+    }
+
+    const auto* const site_data = reinterpret_cast<const char*>(site_table.data() + offset);
+    sites.push_back(Site{.file_name = std::string_view{site_data, site_header.file_name_size},
+                         .format = std::string_view{site_data + site_header.file_name_size, site_header.format_size},
+                         .line = site_header.line});
+    offset += site_header.file_name_size + site_header.format_size;
+  }
+
+  return sites;
+}
+
+std::vector<Argument> ReadArguments(const std::span<const std::byte> record_data, const std::size_t argument_count) {
+  std::vector<Argument> arguments;
+  arguments.reserve(argument_count);
+
+  for (auto offset = sizeof(RecordHeader); arguments.size() < argument_count;) {
+    const auto argument_type = Read<TraceArgumentType>(record_data, offset++);
+    switch (argument_type) {
+      using enum TraceArgumentType;
+      case kBool:
+        arguments.emplace_back(Read<bool>(record_data, offset));
+        offset += sizeof(bool);
+        break;
+      case kChar:
+        arguments.emplace_back(Read<char>(record_data, offset));
+        offset += sizeof(char);
+        break;
+      case kInt64:
+        arguments.emplace_back(Read<std::int64_t>(record_data, offset));
+        offset += sizeof(std::int64_t);
+        break;
+      case kUint64:
+        arguments.emplace_back(Read<std::uint64_t>(record_data, offset));
+        offset += sizeof(std::uint64_t);
+        break;
+      case kDouble:
+        arguments.emplace_back(Read<double>(record_data, offset));
+        offset += sizeof(double);
+        break;
+      case kString: {
+        const auto size = Read<std::uint32_t>(record_data, offset);
+        offset += sizeof(std::uint32_t);
+        if (offset + size > record_data.size()) throw std::runtime_error{"Unexpected end of trace record"};
+        arguments.emplace_back(std::string_view{reinterpret_cast<const char*>(record_data.data() + offset), size});
+        offset += size;
+        break;
+      }
+      default:
+        throw std::runtime_error{
+            std::format("Unsupported trace argument type {}", std::to_underlying(argument_type))};
+    }
+  }
+
+  return arguments;
+}
+
+void FormatArgument(std::string& message, const std::string_view format_spec, const Argument& argument) {
+  std::visit(
+      [&message, format_spec](const auto& value) {
+        try {
+          const auto format = std::format("{{:{}}}", format_spec);
+          std::vformat_to(std::back_inserter(message), format, std::make_format_args(value));
+        } catch (const std::format_error&) {
+          std::format_to(std::back_inserter(message), "{}", value);  // ignore format specs which no longer apply
+        }
+      },
+      argument);
+}
+
+// formats a message at runtime since std::vformat requires a fixed number of arguments
+std::string FormatMessage(const std::string_view format, const std::span<const Argument> arguments) {
+  std::string message;
+  std::size_t next_argument_index = 0;
+
+  for (std::size_t index = 0; index < format.size(); ++index) {
+    const auto character = format[index];
+    if ((character == '{' || character == '}') && index + 1 < format.size() && format[index + 1] == character) {
+      message.push_back(character);  // escaped brace
+      ++index;
+      continue;
+    }
+    if (character != '{') {
+      message.push_back(character);
+      continue;
+    }
+
+    const auto field_end = format.find('}', index);
+    if (field_end == std::string_view::npos) break;
+
+    const auto field = format.substr(index + 1, field_end - index - 1);
+    const auto format_spec_begin = field.find(':');
+    const auto argument_id = field.substr(0, format_spec_begin);
+    const auto format_spec = format_spec_begin == std::string_view::npos ? std::string_view{}
+                                                                         : field.substr(format_spec_begin + 1);
+
+    auto argument_index = next_argument_index++;
+    if (!argument_id.empty()) {
+      std::from_chars(argument_id.data(), argument_id.data() + argument_id.size(), argument_index);
+    }
+
+    if (argument_index < arguments.size()) {
+      FormatArgument(message, format_spec, arguments[argument_index]);
+    } else {
+      message += "{?}";
+    }
+    index = field_end;
+  }
+
+  return message;
+}
+
+std::optional<RecordHeader> ReadRecordHeader(const std::span<const std::byte> ring, const std::uint64_t offset) {
+  const auto position = offset % ring.size();
+  if (ring.size() - position < sizeof(RecordHeader)) return std::nullopt;
+
+  const auto record_header = Read<RecordHeader>(ring, position);
+  if (record_header.size < sizeof(RecordHeader)
+      || record_header.size % kRecordAlignment != 0
+      || record_header.size > ring.size() - position
+      || record_header.end_offset != offset + record_header.size) {
+    return std::nullopt;
+  }
+  return record_header;
+}
+
+}  // namespace
+
+std::size_t TraceLog::SiteKeyHash::operator()(const SiteKey& site_key) const noexcept {
+  const std::array site_key_values{reinterpret_cast<std::uintptr_t>(site_key.file_name),
+                                   reinterpret_cast<std::uintptr_t>(site_key.format),
+                                   static_cast<std::uintptr_t>(site_key.line)};
+  return static_cast<std::size_t>(Hash(std::as_bytes(std::span{site_key_values})));
+}
+
+TraceLog::TraceLog(const CreateInfo& create_info)
+    : trace_file_{create_info.trace_filepath, GetTraceFileSize(create_info)},
+      id_{RegisterTraceLog()},
+      start_time_{std::chrono::steady_clock::now()} {
+  const auto start_time = std::chrono::system_clock::now().time_since_epoch();
+  GetTraceHeader(trace_file_.data()) = TraceHeader{
+      .site_table_size = create_info.site_table_size,
+      .ring_size = create_info.ring_size,
+      .start_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(start_time).count()};
+}
+
+TraceLog::~TraceLog() noexcept {
+  auto& trace_log_registry = GetTraceLogRegistry();
+  const std::scoped_lock lock{trace_log_registry.mutex};
+  trace_log_registry.ids.erase(id_);
+  trace_log_registry.destroyed_count.fetch_add(1, std::memory_order_release);
+}
+
+TraceLog::RecordBuffer::RecordBuffer() {
+  if (thread_record_depth == thread_records.size()) thread_records.emplace_back();
+  record_ = &thread_records[thread_record_depth++];
+}
+
+TraceLog::RecordBuffer::~RecordBuffer() noexcept { --thread_record_depth; }
+
+void TraceLog::WriteString(std::vector<std::byte>& record, const std::string_view value) {
+  const auto size = static_cast<std::uint32_t>(std::min(value.size(), kMaxStringSize));
+  const auto size_bytes = std::bit_cast<std::array<std::byte, sizeof(size)>>(size);
+  const auto value_bytes = std::as_bytes(std::span{value.data(), size});
+
+  record.push_back(static_cast<std::byte>(TraceArgumentType::kString));
+  record.insert(record.end(), size_bytes.begin(), size_bytes.end());
+  record.insert(record.end(), value_bytes.begin(), value_bytes.end());
+}
+
+void TraceLog::BeginRecord(std::vector<std::byte>& record,
+                           const std::uint8_t severity,
+                           const std::source_location& source_location,
+                           const std::string_view format,
+                           const std::size_t argument_count) {
+  record.clear();  // record buffers are reused to avoid allocating a new buffer for every message
+
+  const RecordHeader record_header{
+      .timestamp_ns = (std::chrono::steady_clock::now() - start_time_) / std::chrono::nanoseconds{1},
+      .site_id = GetSiteId(source_location, format),
+      .severity = severity,
+      .argument_count = static_cast<std::uint8_t>(argument_count)};
+  const auto record_header_bytes = std::bit_cast<std::array<std::byte, sizeof(RecordHeader)>>(record_header);
+  record.insert(record.end(), record_header_bytes.begin(), record_header_bytes.end());
+}
+
+void TraceLog::EndRecord(std::vector<std::byte>& record) {
+  record.resize((record.size() + kRecordAlignment - 1) / kRecordAlignment * kRecordAlignment);
+  const auto record_size = static_cast<std::uint32_t>(record.size());
+
+  auto& trace_header = GetTraceHeader(trace_file_.data());
+  const auto ring = GetRing(trace_file_.data(), trace_header);
+  if (record_size > ring.size() / 2) return;  // discard records that would overwrite most of the ring
+
+  // reserve space for the record and pad to the end of the ring if the record would otherwise wrap around
+  std::atomic_ref write_offset{trace_header.write_offset};
+  auto offset = write_offset.load(std::memory_order_relaxed);
+  std::uint64_t padding_size = 0;
+  do {
+    const auto remaining_size = ring.size() - offset % ring.size();
+    padding_size = remaining_size < record_size ? remaining_size : 0;
+  } while (!write_offset.compare_exchange_weak(offset,
+                                               offset + padding_size + record_size,
+                                               std::memory_order_relaxed,
+                                               std::memory_order_relaxed));
+
+  if (padding_size >= sizeof(RecordHeader)) {
+    const RecordHeader padding_header{.size = static_cast<std::uint32_t>(padding_size), .site_id = kPaddingSiteId};
+    const auto padding_header_bytes = std::bit_cast<std::array<std::byte, sizeof(RecordHeader)>>(padding_header);
+    PublishRecord(ring, offset, padding_header_bytes, offset + padding_size);
+  }
+
+  offset += padding_size;
+  std::memcpy(record.data() + offsetof(RecordHeader, size), &record_size, sizeof(record_size));
+  PublishRecord(ring, offset, record, offset + record_size);
+}
+
+std::uint32_t TraceLog::GetSiteId(const std::source_location& source_location, const std::string_view format) {
+  const SiteKey site_key{.file_name = source_location.file_name(),
+                         .format = format.data(),
+                         .line = source_location.line()};
+
+  // sites are cached per thread to avoid acquiring a lock after the first message from each source location
+  thread_local std::unordered_map<std::uint64_t, SiteIds> site_ids;
+  thread_local std::uint64_t destroyed_trace_log_count = 0;
+
+  // sites cached for destroyed trace logs are pruned by the thread that owns them since thread-local caches are not
+  // accessible when a trace log is destroyed
+  if (auto& trace_log_registry = GetTraceLogRegistry();
+      trace_log_registry.destroyed_count.load(std::memory_order_acquire) != destroyed_trace_log_count) {
+    const std::scoped_lock registry_lock{trace_log_registry.mutex};
+    destroyed_trace_log_count = trace_log_registry.destroyed_count.load(std::memory_order_relaxed);
+    std::erase_if(site_ids, [&ids = trace_log_registry.ids](const auto& entry) { return !ids.contains(entry.first); });
+  }
+
+  auto& thread_site_ids = site_ids[id_];
+  if (const auto iterator = thread_site_ids.find(site_key); iterator != thread_site_ids.end()) {
+    return iterator->second;
+  }
+
+  std::scoped_lock site_lock{site_mutex_};
+  if (const auto iterator = site_ids_.find(site_key); iterator != site_ids_.end()) {
+    return thread_site_ids[site_key] = iterator->second;
+  }
+
+  auto& trace_header = GetTraceHeader(trace_file_.data());
+  const auto site_table = GetSiteTable(trace_file_.data(), trace_header);
+  const auto file_name = std::filesystem::path{site_key.file_name}.filename().string();
+  const SiteHeader site_header{.line = site_key.line,
+                               .file_name_size = static_cast<std::uint32_t>(file_name.size()),
+                               .format_size = static_cast<std::uint32_t>(format.size())};
+
+  auto site_id = kUnknownSiteId;
+  if (const auto site_size = sizeof(SiteHeader) + file_name.size() + format.size();
+      trace_header.site_table_used_size + site_size <= site_table.size()) {
+    auto* site_data = site_table.data() + trace_header.site_table_used_size;
+    std::memcpy(site_data, &site_header, sizeof(SiteHeader));
+    std::memcpy(site_data += sizeof(SiteHeader), file_name.data(), file_name.size());
+    std::memcpy(site_data + file_name.size(), format.data(), format.size());
+    trace_header.site_table_used_size += site_size;
+
+    std::atomic_ref site_count{trace_header.site_count};
+    site_id = site_count.load(std::memory_order_relaxed);
+    site_count.store(site_id + 1, std::memory_order_release);
+  }
+
+  site_ids_.emplace(site_key, site_id);
+  return thread_site_ids[site_key] = site_id;
+}
+
+std::size_t DecodeTrace(const std::span<const std::byte> trace_data, std::ostream& ostream) {
+  const auto trace_header = Read<TraceHeader>(trace_data, 0);
+  if (trace_header.magic != kTraceMagic) throw std::runtime_error{"Invalid trace file"};
+  if (trace_header.version != kTraceVersion) {
+    throw std::runtime_error{std::format("Unsupported trace file version {}", trace_header.version)};
+  }
+  if (sizeof(TraceHeader) + trace_header.site_table_size + trace_header.ring_size > trace_data.size()
+      || trace_header.ring_size < kMinRingSize) {
+    throw std::runtime_error{"Unexpected end of trace data"};
+  }
+
+  const auto sites = ReadSites(trace_data.subspan(sizeof(TraceHeader), trace_header.site_table_size),
+                               trace_header.site_count);
+  const auto ring = trace_data.subspan(sizeof(TraceHeader) + trace_header.site_table_size, trace_header.ring_size);
+
+  // once the ring wraps around, the oldest record is found by scanning for the first record that is not overwritten
+  const auto end_offset = trace_header.write_offset;
+  auto offset = end_offset > ring.size() ? end_offset - ring.size() : 0;
+  std::size_t message_count = 0;
+
+  while (offset < end_offset) {
+    if (const auto remaining_size = ring.size() - offset % ring.size(); remaining_size < sizeof(RecordHeader)) {
+      offset += remaining_size;  // records are never split across the end of the ring
+      continue;
+    }
+
+    const auto record_header = ReadRecordHeader(ring, offset);
+    if (!record_header.has_value()) {
+      offset += kRecordAlignment;  // skip incomplete records
+      continue;
+    }
+
+    const auto record_data = ring.subspan(offset % ring.size(), record_header->size);
+    offset += record_header->size;
+    if (record_header->site_id == kPaddingSiteId) continue;
+
+    const auto timestamp = std::chrono::duration<double>{std::chrono::nanoseconds{record_header->timestamp_ns}};
+    const auto severity_name = record_header->severity < kSeverityNames.size() ? kSeverityNames[record_header->severity]
+                                                                               : std::string_view{"UNKNOWN"};
+    const auto arguments = ReadArguments(record_data, record_header->argument_count);
+
+    if (record_header->site_id < sites.size()) {
+      const auto& [file_name, format, line] = sites[record_header->site_id];
+      ostream << std::format("[{:.6f}] [{}] [{}:{}] {}\n",
+                             timestamp.count(),
+                             severity_name,
+                             file_name,
+                             line,
+                             FormatMessage(format, arguments));
+    } else {
+      ostream << std::format("[{:.6f}] [{}] [unknown] {} arguments\n",
+                             timestamp.count(),
+                             severity_name,
+                             arguments.size());
+    }
+    ++message_count;
+  }
+
+  return message_count;
+}
+
+}  // namespace vktf
@@ -2,6 +2,17 @@ module;
 
 #include <algorithm>
 #include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -32,6 +43,40 @@ public:
    */
   [[nodiscard]] bool Intersects(const BoundingBox& world_bounding_box) const;
 
+  /**
+   * @brief Tests if a bounding box is entirely contained within the view frustum.
+   * @param world_bounding_box The world-space bounding box to test for containment within the view frustum.
+   * @return @c true if every point in the bounding box is inside the view frustum, otherwise @c false.
+   */
+  [[nodiscard]] bool Contains(const BoundingBox& world_bounding_box) const;
+
+  /**
+   * @brief Tests if multiple bounding boxes intersect with the view frustum.
+   * @details Bounding boxes are tested in batches of 16, 8, or 4 using AVX-512, AVX, or SSE instructions depending on
+   *          the instruction set supported by the CPU at runtime. Remaining bounding boxes are tested individually.
+   * @param world_bounding_boxes The world-space bounding boxes to test for intersection with the view frustum.
+   * @param visibility_mask The bitmask to write intersection results to where bit <tt>i % 64</tt> of element
+   *                        <tt>i / 64</tt> is set if bounding box @c i intersects with the view frustum.
+   * @warning The caller is responsible for ensuring @p visibility_mask contains at least one element for every 64
+   *          bounding boxes.
+   */
+  void Intersects(const BoundingBoxes& world_bounding_boxes, std::span<std::uint64_t> visibility_mask) const;
+
+  /**
+   * @brief Tests if a contiguous range of bounding boxes intersect with the view frustum.
+   * @details Bounding boxes are tested in batches using the same instruction set as the overload that tests all
+   *          bounding boxes which allows callers to test subsets such as bounding volume hierarchy leaves.
+   * @param world_bounding_boxes The world-space bounding boxes containing the range to test.
+   * @param first_index The index of the first bounding box in the range.
+   * @param count The number of bounding boxes in the range.
+   * @return A bitmask where bit @c i is set if bounding box <tt>first_index + i</tt> intersects with the view frustum.
+   * @warning The caller is responsible for ensuring @p count is at most 64 and the range is within
+   *          @p world_bounding_boxes.
+   */
+  [[nodiscard]] std::uint64_t Intersects(const BoundingBoxes& world_bounding_boxes,
+                                         std::size_t first_index,
+                                         std::size_t count) const;
+
 private:
   std::array<glm::vec4, 6> planes_;
 };
@@ -59,6 +104,220 @@ std::array<glm::vec4, 6> GetPlanes(const glm::mat4& view_projection_transform) {
                     Normalize(view_projection_transform[3] - view_projection_transform[2])};  // far plane
 }
 
+// the positive vertex for each plane only depends on the plane normal which allows selecting bounding box component
+// arrays once per plane rather than selecting components for each bounding box
+struct CullingPlane {
+  glm::vec4 plane{0.0f};
+  std::array<const float*, 3> positive_vertex{};
+};
+
+using CullingPlanes = std::array<CullingPlane, 6>;
+
+CullingPlanes GetCullingPlanes(const std::array<glm::vec4, 6>& planes, const BoundingBoxes& bounding_boxes) {
+  CullingPlanes culling_planes;
+  std::ranges::transform(planes, culling_planes.begin(), [&bounding_boxes](const auto& plane) {
+    return CullingPlane{
+        .plane = plane,
+        .positive_vertex = {plane.x >= 0.0f ? bounding_boxes.max_x().data() : bounding_boxes.min_x().data(),
+                            plane.y >= 0.0f ? bounding_boxes.max_y().data() : bounding_boxes.min_y().data(),
+                            plane.z >= 0.0f ? bounding_boxes.max_z().data() : bounding_boxes.min_z().data()}};
+  });
+  return culling_planes;
+}
+
+bool IntersectsBoundingBox(const CullingPlanes& culling_planes, const std::size_t index) {
+  return std::ranges::all_of(culling_planes, [index](const auto& culling_plane) {
+    const auto& [plane, positive_vertex] = culling_plane;
+    const auto& [x, y, z] = positive_vertex;
+    return plane.x * x[index] + plane.y * y[index] + plane.z * z[index] + plane.w >= 0.0f;
+  });
+}
+
+constexpr std::size_t kVisibilityMaskBits = 64;
+
+// tests a range of at most 64 bounding boxes and returns a mask where bit i is set if bounding box first_index + i
+// intersects with the view frustum
+using IntersectsRangeFn = std::uint64_t (*)(const CullingPlanes&, std::size_t first_index, std::size_t count);
+
+std::uint64_t IntersectsRangeScalar(const CullingPlanes& culling_planes,
+                                    const std::size_t first_index,
+                                    const std::size_t count) {
+  assert(count <= kVisibilityMaskBits);
+  std::uint64_t mask = 0;
+  for (auto offset = 0uz; offset < count; ++offset) {
+    if (IntersectsBoundingBox(culling_planes, first_index + offset)) {
+      mask |= std::uint64_t{1} << offset;
+    }
+  }
+  return mask;
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+// vector instructions beyond the SSE2 baseline for x86-64 are enabled per function and selected at runtime which allows
+// default builds to use the widest instruction set supported by the CPU
+#if defined(__GNUC__) || defined(__clang__)
+#define VKTF_TARGET(instruction_set) __attribute__((target(instruction_set)))  // NOLINT(cppcoreguidelines-macro-usage)
+#else
+#define VKTF_TARGET(instruction_set)  // MSVC permits intrinsics for any instruction set without enabling it
+#endif
+
+// bounding boxes after the last complete batch in a range are tested individually
+std::uint64_t IntersectsRemaining(const CullingPlanes& culling_planes,
+                                  const std::size_t first_index,
+                                  const std::size_t offset,
+                                  const std::size_t count) {
+  if (offset == count) return 0;  // shifting by the width of the mask is undefined
+  return IntersectsRangeScalar(culling_planes, first_index + offset, count - offset) << offset;
+}
+
+VKTF_TARGET("avx512f")
+std::uint64_t IntersectsBatchAvx512(const CullingPlanes& culling_planes, const std::size_t index) {
+  __mmask16 mask = 0xFFFF;
+  for (const auto& [plane, positive_vertex] : culling_planes) {
+    const auto& [x, y, z] = positive_vertex;
+    auto distance = _mm512_fmadd_ps(_mm512_set1_ps(plane.x), _mm512_loadu_ps(x + index), _mm512_set1_ps(plane.w));
+    distance = _mm512_fmadd_ps(_mm512_set1_ps(plane.y), _mm512_loadu_ps(y + index), distance);
+    distance = _mm512_fmadd_ps(_mm512_set1_ps(plane.z), _mm512_loadu_ps(z + index), distance);
+    mask &= _mm512_cmp_ps_mask(distance, _mm512_setzero_ps(), _CMP_GE_OQ);
+  }
+  return mask;
+}
+
+VKTF_TARGET("avx512f")
+std::uint64_t IntersectsRangeAvx512(const CullingPlanes& culling_planes,
+                                    const std::size_t first_index,
+                                    const std::size_t count) {
+  static constexpr std::size_t kBatchSize = 16;
+  static_assert(kVisibilityMaskBits % kBatchSize == 0, "Batches must not span multiple visibility mask elements");
+  assert(count <= kVisibilityMaskBits);
+
+  std::uint64_t mask = 0;
+  auto offset = 0uz;
+  for (; offset + kBatchSize <= count; offset += kBatchSize) {
+    mask |= IntersectsBatchAvx512(culling_planes, first_index + offset) << offset;
+  }
+  return mask | IntersectsRemaining(culling_planes, first_index, offset, count);
+}
+
+VKTF_TARGET("avx")
+std::uint64_t IntersectsBatchAvx(const CullingPlanes& culling_planes, const std::size_t index) {
+  auto mask = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+  for (const auto& [plane, positive_vertex] : culling_planes) {
+    const auto& [x, y, z] = positive_vertex;
+    auto distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), _mm256_loadu_ps(x + index)),
+                                  _mm256_set1_ps(plane.w));
+    distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.y), _mm256_loadu_ps(y + index)), distance);
+    distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.z), _mm256_loadu_ps(z + index)), distance);
+    mask = _mm256_and_ps(mask, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+  }
+  return static_cast<std::uint64_t>(_mm256_movemask_ps(mask));
+}
+
+VKTF_TARGET("avx")
+std::uint64_t IntersectsRangeAvx(const CullingPlanes& culling_planes,
+                                 const std::size_t first_index,
+                                 const std::size_t count) {
+  static constexpr std::size_t kBatchSize = 8;
+  static_assert(kVisibilityMaskBits % kBatchSize == 0, "Batches must not span multiple visibility mask elements");
+  assert(count <= kVisibilityMaskBits);
+
+  std::uint64_t mask = 0;
+  auto offset = 0uz;
+  for (; offset + kBatchSize <= count; offset += kBatchSize) {
+    mask |= IntersectsBatchAvx(culling_planes, first_index + offset) << offset;
+  }
+  return mask | IntersectsRemaining(culling_planes, first_index, offset, count);
+}
+
+std::uint64_t IntersectsBatchSse(const CullingPlanes& culling_planes, const std::size_t index) {
+  auto mask = _mm_castsi128_ps(_mm_set1_epi32(-1));
+  for (const auto& [plane, positive_vertex] : culling_planes) {
+    const auto& [x, y, z] = positive_vertex;
+    auto distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), _mm_loadu_ps(x + index)), _mm_set1_ps(plane.w));
+    distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.y), _mm_loadu_ps(y + index)), distance);
+    distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), _mm_loadu_ps(z + index)), distance);
+    mask = _mm_and_ps(mask, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+  }
+  return static_cast<std::uint64_t>(_mm_movemask_ps(mask));
+}
+
+std::uint64_t IntersectsRangeSse(const CullingPlanes& culling_planes,
+                                 const std::size_t first_index,
+                                 const std::size_t count) {
+  static constexpr std::size_t kBatchSize = 4;
+  static_assert(kVisibilityMaskBits % kBatchSize == 0, "Batches must not span multiple visibility mask elements");
+  assert(count <= kVisibilityMaskBits);
+
+  std::uint64_t mask = 0;
+  auto offset = 0uz;
+  for (; offset + kBatchSize <= count; offset += kBatchSize) {
+    mask |= IntersectsBatchSse(culling_planes, first_index + offset) << offset;
+  }
+  return mask | IntersectsRemaining(culling_planes, first_index, offset, count);
+}
+
+#ifdef _MSC_VER
+
+// the operating system must also save extended register state on context switches before vector registers are used
+VKTF_TARGET("xsave")
+bool IsXsaveEnabled(const unsigned long long xcr0_mask) {
+  std::array<int, 4> cpu_info{};
+  __cpuid(cpu_info.data(), 1);
+  static constexpr auto kOsxsaveBit = 1 << 27;
+  return (cpu_info[2] & kOsxsaveBit) != 0 && (_xgetbv(0) & xcr0_mask) == xcr0_mask;
+}
+
+bool IsAvxSupported() {
+  std::array<int, 4> cpu_info{};
+  __cpuid(cpu_info.data(), 1);
+  static constexpr auto kAvxBit = 1 << 28;
+  static constexpr auto kAvxXcr0Mask = 0x6ull;  // XMM and YMM state
+  return (cpu_info[2] & kAvxBit) != 0 && IsXsaveEnabled(kAvxXcr0Mask);
+}
+
+bool IsAvx512Supported() {
+  std::array<int, 4> cpu_info{};
+  __cpuidex(cpu_info.data(), 7, 0);
+  static constexpr auto kAvx512fBit = 1 << 16;
+  static constexpr auto kAvx512Xcr0Mask = 0xE6ull;  // XMM, YMM, opmask, and ZMM state
+  return (cpu_info[1] & kAvx512fBit) != 0 && IsXsaveEnabled(kAvx512Xcr0Mask);
+}
+
+#else
+
+// the compiler runtime also verifies the operating system saves extended register state on context switches
+bool IsAvxSupported() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx");
+}
+
+bool IsAvx512Supported() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx512f");
+}
+
+#endif
+
+#undef VKTF_TARGET
+
+IntersectsRangeFn SelectIntersectsRange() {
+  if (IsAvx512Supported()) return IntersectsRangeAvx512;
+  if (IsAvxSupported()) return IntersectsRangeAvx;
+  return IntersectsRangeSse;  // guaranteed by the x86-64 baseline
+}
+
+#else
+
+IntersectsRangeFn SelectIntersectsRange() { return IntersectsRangeScalar; }
+
+#endif
+
+IntersectsRangeFn GetIntersectsRange() {
+  static const auto intersects_range = SelectIntersectsRange();  // CPU features are only queried once
+  return intersects_range;
+}
+
 }  // namespace
 
 ViewFrustum::ViewFrustum(const glm::mat4& view_projection_transform)
@@ -76,4 +335,37 @@ bool ViewFrustum::Intersects(const BoundingBox& world_bounding_box) const {
   });
 }
 
+bool ViewFrustum::Contains(const BoundingBox& world_bounding_box) const {
+  return std::ranges::all_of(planes_, [&world_bounding_box](const auto& plane) {
+    const glm::vec3 normal{plane.x, plane.y, plane.z};
+    const glm::vec4 negative_vertex{normal.x >= 0.0f ? world_bounding_box.min.x : world_bounding_box.max.x,
+                                    normal.y >= 0.0f ? world_bounding_box.min.y : world_bounding_box.max.y,
+                                    normal.z >= 0.0f ? world_bounding_box.min.z : world_bounding_box.max.z,
+                                    1.0f};
+    return glm::dot(plane, negative_vertex) >= 0.0f;
+  });
+}
+
+void ViewFrustum::Intersects(const BoundingBoxes& world_bounding_boxes,
+                             const std::span<std::uint64_t> visibility_mask) const {
+  const auto bounding_box_count = world_bounding_boxes.size();
+  assert(visibility_mask.size() * kVisibilityMaskBits >= bounding_box_count);
+  std::ranges::fill(visibility_mask, 0);
+
+  const auto culling_planes = GetCullingPlanes(planes_, world_bounding_boxes);
+  const auto intersects_range = GetIntersectsRange();
+
+  for (auto index = 0uz; index < bounding_box_count; index += kVisibilityMaskBits) {
+    visibility_mask[index / kVisibilityMaskBits] =
+        intersects_range(culling_planes, index, std::min(kVisibilityMaskBits, bounding_box_count - index));
+  }
+}
+
+std::uint64_t ViewFrustum::Intersects(const BoundingBoxes& world_bounding_boxes,
+                                      const std::size_t first_index,
+                                      const std::size_t count) const {
+  assert(count <= kVisibilityMaskBits && first_index + count <= world_bounding_boxes.size());
+  return GetIntersectsRange()(GetCullingPlanes(planes_, world_bounding_boxes), first_index, count);
+}
+
 }  // namespace vktf
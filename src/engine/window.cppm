@@ -137,7 +137,7 @@ private:
     glfwSetErrorCallback([](const int error_code, const char* const description) {
       using Severity = Log::Severity;
       auto& log = Log::Default();
-      log(Severity::kError) << std::format("GLFW error {}: {}", error_code, description);
+      log(Severity::kError).Print("GLFW error {}: {}", error_code, description);
     });
 #endif
     if (glfwInit() == GLFW_FALSE) throw std::runtime_error{"GLFW initialization failed"};
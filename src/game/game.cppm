@@ -1,7 +1,9 @@
 module;
 
 #include <array>
+#include <exception>
 #include <filesystem>
+#include <initializer_list>
 #include <optional>
 
 #include <GLFW/glfw3.h>
@@ -12,6 +14,8 @@ export module game;
 import delta_time;
 import camera;
 import engine;
+import log;
+import profiler;
 import scene;
 import window;
 
@@ -21,7 +25,9 @@ namespace game {
  * @brief Starts the application.
  * @details This application is a narrowly scoped Vulkan glTF Renderer (VkTF) for assets that support the PBR metallic-
  *          roughness workflow. It implements simple camera controls using mouse movement to orient the viewer and WASD
- *          keys to move through the scene. Press ESC to exit the application.
+ *          keys to move through the scene. CPU profiling begins on startup and pressing P alternates between writing
+ *          the captured profile to a Chrome trace file with average GPU timings and beginning a new capture. Press ESC
+ *          to exit the application.
  * @note This file is primarily intended to demonstrate how to use core Engine APIs to load and render a scene composed
  *       of multiple glTF files.
  */
@@ -33,6 +39,30 @@ module :private;
 
 namespace {
 
+void ToggleProfiler(const vktf::Engine& engine) {
+  auto& profiler = vktf::Profiler::Default();
+  if (!profiler.is_recording()) {
+    profiler.Start();
+    return;
+  }
+
+  profiler.Stop();
+  static const std::filesystem::path kProfileFilepath = "temp/vktf/profile.json";
+  auto& log = vktf::Log::Default();
+  try {
+    profiler.WriteChromeTrace(kProfileFilepath);
+    log(vktf::Log::Severity::kInfo).Print("Wrote CPU profile to {}", kProfileFilepath.string());
+  } catch (const std::exception& exception) {
+    log(vktf::Log::Severity::kError).Print("Failed to write CPU profile: {}", exception.what());
+  }
+
+  // GPU timings are continuously averaged over recent frames and reported alongside each CPU profile
+  for (const auto& [name, id, average_milliseconds, frame_count] : engine.gpu_profiler().GetAverageTimings()) {
+    log(vktf::Log::Severity::kInfo)
+        .Print("GPU {}#{}: {:.3f} ms averaged over {} frames", name, id, average_milliseconds, frame_count);
+  }
+}
+
 vktf::Window CreateWindow() {
   static constexpr auto* kProjectTitle = "VkTF";
   vktf::Window window{kProjectTitle};
@@ -78,12 +108,16 @@ void HandleMouseEvents(const vktf::Window& window, vktf::Camera& camera) {
 }
 
 vktf::Scene LoadScene(vktf::Engine& engine) {
-  const std::array asset_filepaths{std::filesystem::path{"assets/Main.1_Sponza/NewSponza_Main_glTF_002.gltf"},
-                                   std::filesystem::path{"assets/PKG_A_Curtains/NewSponza_Curtains_glTF.gltf"},
-                                   std::filesystem::path{"assets/PKG_B_Ivy/NewSponza_IvyGrowth_glTF.gltf"}};
-
+  const std::array asset_filepaths{std::filesystem::path{"assets/Main.1_Sponza/NewSponza_Main_glTF_002.gltf"}};
   auto scene = engine.Load(asset_filepaths);
   assert(scene.has_value());  // default assets are guaranteed to be valid glTF files
+
+  // additional assets are streamed into the scene so the application can begin rendering as soon as possible
+  for (const auto& asset_filepath : {std::filesystem::path{"assets/PKG_A_Curtains/NewSponza_Curtains_glTF.gltf"},
+                                     std::filesystem::path{"assets/PKG_B_Ivy/NewSponza_IvyGrowth_glTF.gltf"}}) {
+    engine.LoadAsync(*scene, asset_filepath);
+  }
+
   return std::move(*scene);
 }
 
@@ -92,9 +126,16 @@ vktf::Scene LoadScene(vktf::Engine& engine) {
 namespace game {
 
 void Start() {
-  const auto window = CreateWindow();
+  vktf::Profiler::Default().Start();  // capture asset loading which occurs before the first frame
+  auto window = CreateWindow();
   vktf::Engine engine{window};
 
+  window.AddKeyEventListener([&engine](const auto key, const auto action) {
+    if (key == GLFW_KEY_P && action == GLFW_PRESS) {
+      ToggleProfiler(engine);
+    }
+  });
+
   engine.Run(window, [&window, &engine, scene = LoadScene(engine)](const auto delta_time) mutable {
     auto& camera = scene.camera();
     HandleKeyEvents(window, camera, delta_time);
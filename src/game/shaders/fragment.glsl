@@ -12,7 +12,7 @@ const uint kMetallicRoughnessSamplerIndex = 1;
 const uint kNormalSamplerIndex = 2;
 const uint kMaterialSamplerCount = 3;
 
-layout (constant_id = 0) const uint kLightCount = 1;
+layout (constant_id = 0) const uint kMaxLightCount = 1;
 
 layout(set = 0, binding = 0) uniform CameraProperties {
   mat4 view_projection_transform;
@@ -20,7 +20,8 @@ layout(set = 0, binding = 0) uniform CameraProperties {
 } camera_properties;
 
 layout(set = 0, binding = 1) uniform WorldLights {
-  WorldLight data[kLightCount];
+  uint count;  // the number of active lights which never exceeds kMaxLightCount
+  WorldLight data[kMaxLightCount];
 } world_lights;
 
 layout(set = 1, binding = 0) uniform MaterialProperties {
@@ -134,7 +135,7 @@ void main() {
   const vec2 metallic_roughness = GetMetallicRoughness();
   vec3 radiance_out = vec3(0.0);
 
-  for (int i = 0; i < kLightCount; ++i) {
+  for (uint i = 0; i < world_lights.count; ++i) {
     const WorldLight world_light = world_lights.data[i];
     float light_attenuation = 0.0;
     const vec3 light_direction = GetLightDirection(world_light, light_attenuation);
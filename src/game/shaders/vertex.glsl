@@ -1,14 +1,15 @@
 #version 460
 
-layout(push_constant) uniform PushConstants {
-  mat4 model_transform;
-} push_constants;
-
 layout(set = 0, binding = 0) uniform CameraProperties {
   mat4 view_projection_transform;
   vec3 world_position;
 } camera_properties;
 
+// model transforms are indexed by the first instance of each draw command to support multi-draw indirect rendering
+layout(set = 0, binding = 2) readonly buffer ModelTransforms {
+  mat4 data[];
+} model_transforms;
+
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec3 normal;
 layout(location = 2) in vec4 tangent;  // w-component indicates the signed handedness of the tangent basis
@@ -22,7 +23,7 @@ layout(location = 0) out Fragment {
 } fragment;
 
 void main() {
-  const mat4 model_transform = push_constants.model_transform;
+  const mat4 model_transform = model_transforms.data[gl_InstanceIndex];
   const mat3 model_rotation = mat3(model_transform);
   const vec4 world_position = model_transform * vec4(position, 1.0);
 
@@ -0,0 +1,31 @@
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <print>
+#include <span>
+#include <string_view>
+
+import mapped_file;
+import trace_log;
+
+// decodes a binary trace file recorded by vktf::TraceLog and writes its messages to standard output
+int main(const int argc, const char* const argv[]) {
+  const std::span arguments{argv, static_cast<std::size_t>(argc)};
+  if (arguments.size() != 2) {
+    std::println(std::cerr, "Usage: {} <trace-filepath>", std::filesystem::path{arguments[0]}.filename().string());
+    return EXIT_FAILURE;
+  }
+
+  try {
+    std::ios_base::sync_with_stdio(false);  // avoid synchronizing with stdio because only standard C++ streams are used
+    const vktf::MappedFile trace_file{arguments[1]};
+    const auto message_count = vktf::DecodeTrace(trace_file.data(), std::cout);
+    std::println(std::cerr, "Decoded {} messages from {}", message_count, std::string_view{arguments[1]});
+  } catch (const std::exception& exception) {
+    std::println(std::cerr, "{}", exception.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
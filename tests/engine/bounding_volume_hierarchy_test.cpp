@@ -0,0 +1,100 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+import bounding_box;
+import bounding_volume_hierarchy;
+import view_frustum;
+
+namespace {
+
+constexpr auto kVisibilityMaskBits = 64uz;
+
+vktf::ViewFrustum CreateViewFrustum() {
+  const auto projection_transform = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+  const auto view_transform = glm::lookAt(glm::vec3{0.0f}, glm::vec3{0.0f, 0.0f, -1.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+  return vktf::ViewFrustum{projection_transform * view_transform};
+}
+
+vktf::BoundingBoxes CreateRandomBoundingBoxes(const std::size_t bounding_box_count, const glm::vec3& offset) {
+  std::mt19937 random_engine{42};  // use a fixed seed for reproducible test results
+  std::uniform_real_distribution position_distribution{-150.0f, 150.0f};
+  std::uniform_real_distribution extent_distribution{0.0f, 10.0f};
+
+  vktf::BoundingBoxes bounding_boxes;
+  bounding_boxes.Reserve(bounding_box_count);
+
+  for (auto index = 0uz; index < bounding_box_count; ++index) {
+    const auto min = offset + glm::vec3{position_distribution(random_engine),
+                                        position_distribution(random_engine),
+                                        position_distribution(random_engine)};
+    const glm::vec3 extent{extent_distribution(random_engine),
+                           extent_distribution(random_engine),
+                           extent_distribution(random_engine)};
+    bounding_boxes.Add(vktf::BoundingBox{.min = min, .max = min + extent});
+  }
+
+  return bounding_boxes;
+}
+
+std::vector<std::uint64_t> CreateVisibilityMask(const std::size_t bounding_box_count) {
+  // initialize bits to verify the visibility mask is overwritten rather than accumulated
+  return std::vector<std::uint64_t>((bounding_box_count + kVisibilityMaskBits - 1) / kVisibilityMaskBits,
+                                    ~std::uint64_t{0});
+}
+
+bool IsVisible(const std::vector<std::uint64_t>& visibility_mask, const std::size_t index) {
+  return ((visibility_mask[index / kVisibilityMaskBits] >> (index % kVisibilityMaskBits)) & 1u) != 0;
+}
+
+void ExpectCullMatchesIntersects(const vktf::BoundingVolumeHierarchy& bounding_volume_hierarchy,
+                                 const vktf::BoundingBoxes& bounding_boxes) {
+  const auto view_frustum = CreateViewFrustum();
+  auto visibility_mask = CreateVisibilityMask(bounding_boxes.size());
+  bounding_volume_hierarchy.Cull(view_frustum, visibility_mask);
+
+  for (auto index = 0uz; index < bounding_boxes.size(); ++index) {
+    EXPECT_EQ(IsVisible(visibility_mask, index), view_frustum.Intersects(bounding_boxes[index]))
+        << "Bounding box " << index;
+  }
+}
+
+TEST(BoundingVolumeHierarchyTest, CreatesEmptyHierarchy) {
+  const vktf::BoundingVolumeHierarchy bounding_volume_hierarchy{vktf::BoundingBoxes{}};
+  EXPECT_EQ(bounding_volume_hierarchy.size(), 0uz);
+  ExpectCullMatchesIntersects(bounding_volume_hierarchy, vktf::BoundingBoxes{});
+}
+
+TEST(BoundingVolumeHierarchyTest, CreatesHierarchyContainingEachBoundingBox) {
+  const auto bounding_boxes = CreateRandomBoundingBoxes(1'000, glm::vec3{0.0f});
+  const vktf::BoundingVolumeHierarchy bounding_volume_hierarchy{bounding_boxes};
+  EXPECT_EQ(bounding_volume_hierarchy.size(), bounding_boxes.size());
+}
+
+class BoundingVolumeHierarchyCullTest : public testing::TestWithParam<std::size_t> {};
+
+INSTANTIATE_TEST_SUITE_P(BoundingVolumeHierarchyCullTest,
+                         BoundingVolumeHierarchyCullTest,
+                         testing::Values(1uz, 4uz, 5uz, 16uz, 17uz, 64uz, 65uz, 1'000uz, 10'000uz));
+
+TEST_P(BoundingVolumeHierarchyCullTest, CullMatchesIndividualIntersects) {
+  const auto bounding_boxes = CreateRandomBoundingBoxes(GetParam(), glm::vec3{0.0f});
+  const vktf::BoundingVolumeHierarchy bounding_volume_hierarchy{bounding_boxes};
+  ExpectCullMatchesIntersects(bounding_volume_hierarchy, bounding_boxes);
+}
+
+TEST_P(BoundingVolumeHierarchyCullTest, CullMatchesIndividualIntersectsAfterRefit) {
+  const auto bounding_boxes = CreateRandomBoundingBoxes(GetParam(), glm::vec3{0.0f});
+  vktf::BoundingVolumeHierarchy bounding_volume_hierarchy{bounding_boxes};
+
+  const auto moved_bounding_boxes = CreateRandomBoundingBoxes(GetParam(), glm::vec3{20.0f, -10.0f, 30.0f});
+  bounding_volume_hierarchy.Refit(moved_bounding_boxes);
+  ExpectCullMatchesIntersects(bounding_volume_hierarchy, moved_bounding_boxes);
+}
+
+}  // namespace
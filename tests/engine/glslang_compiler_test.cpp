@@ -0,0 +1,138 @@
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <ranges>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <glslang/Include/glslang_c_interface.h>
+#include <gtest/gtest.h>
+
+import glslang_compiler;
+import log;
+import thread_pool;
+
+namespace {
+
+class SpirvCacheTest : public ::testing::Test {
+protected:
+  void SetUp() override { std::filesystem::remove_all(cache_directory_); }
+  void TearDown() override { std::filesystem::remove_all(cache_directory_); }
+
+  [[nodiscard]] std::vector<vktf::SpirvWord> Compile(const std::vector<std::string>& defines = {}) {
+    return vktf::glslang::Compile(vktf::glslang::CompileInfo{.glsl_shader = kGlslShader,
+                                                             .glslang_stage = GLSLANG_STAGE_VERTEX,
+                                                             .defines = defines,
+                                                             .spirv_cache = &spirv_cache_,
+                                                             .log = log_});
+  }
+
+  // overwrites every cached SPIR-V binary with contents that do not begin with the SPIR-V magic number
+  void CorruptCacheFiles() const {
+    for (const auto& directory_entry : std::filesystem::directory_iterator{cache_directory_}) {
+      std::ofstream{directory_entry.path(), std::ios::binary | std::ios::trunc} << "not a SPIR-V binary";
+    }
+  }
+
+  [[nodiscard]] std::size_t GetCacheFileCount() const {
+    const std::filesystem::directory_iterator directory_iterator{cache_directory_};
+    return static_cast<std::size_t>(std::distance(begin(directory_iterator), end(directory_iterator)));
+  }
+
+  std::filesystem::path cache_directory_ = std::filesystem::temp_directory_path() / "vktf_spirv_cache_test";
+  vktf::glslang::SpirvCache spirv_cache_{cache_directory_};
+
+  static inline const std::string kGlslShader = R"(#version 460
+#ifdef POSITION_SCALE
+const float kPositionScale = POSITION_SCALE;
+#else
+const float kPositionScale = 1.0;
+#endif
+void main() { gl_Position = vec4(kPositionScale); })";
+
+  std::ostringstream info_ostream_, warning_ostream_, error_ostream_;
+  vktf::Log log_{info_ostream_, warning_ostream_, error_ostream_};
+};
+
+using CompileTest = SpirvCacheTest;
+
+TEST_F(SpirvCacheTest, CompilesShadersNotFoundInTheCache) {
+  const auto spirv_binary = Compile();
+
+  EXPECT_FALSE(spirv_binary.empty());
+  EXPECT_EQ(spirv_cache_.hit_count(), 0u);
+  EXPECT_EQ(spirv_cache_.miss_count(), 1u);
+  EXPECT_EQ(GetCacheFileCount(), 1uz);
+}
+
+TEST_F(SpirvCacheTest, LoadsPreviouslyCompiledShadersFromTheCache) {
+  const auto compiled_spirv_binary = Compile();
+  const auto cached_spirv_binary = Compile();
+
+  EXPECT_EQ(compiled_spirv_binary, cached_spirv_binary);
+  EXPECT_EQ(spirv_cache_.hit_count(), 1u);
+  EXPECT_EQ(spirv_cache_.miss_count(), 1u);
+}
+
+TEST_F(SpirvCacheTest, CachesShaderPermutationsSeparately) {
+  const auto spirv_binary = Compile();
+  const auto scaled_spirv_binary = Compile({"POSITION_SCALE=2.0"});
+
+  EXPECT_NE(spirv_binary, scaled_spirv_binary);
+  EXPECT_EQ(spirv_cache_.hit_count(), 0u);
+  EXPECT_EQ(spirv_cache_.miss_count(), 2u);
+  EXPECT_EQ(GetCacheFileCount(), 2uz);
+
+  EXPECT_EQ(scaled_spirv_binary, Compile({"POSITION_SCALE=2.0"}));
+  EXPECT_EQ(spirv_cache_.hit_count(), 1u);
+}
+
+TEST_F(SpirvCacheTest, RecompilesShadersWithCorruptCacheEntries) {
+  const auto compiled_spirv_binary = Compile();
+  CorruptCacheFiles();
+
+  EXPECT_EQ(compiled_spirv_binary, Compile());
+  EXPECT_EQ(spirv_cache_.hit_count(), 0u);
+  EXPECT_EQ(spirv_cache_.miss_count(), 2u);
+
+  // the corrupt entry is replaced by the recompiled SPIR-V binary
+  EXPECT_EQ(compiled_spirv_binary, Compile());
+  EXPECT_EQ(spirv_cache_.hit_count(), 1u);
+}
+
+TEST_F(CompileTest, ReturnsBatchResultsInTheSameOrderAsCompileInfos) {
+  const std::vector<std::vector<std::string>> defines{{"POSITION_SCALE=2.0"}, {}, {"POSITION_SCALE=3.0"}};
+  const auto compile_infos = defines  //
+                             | std::views::transform([this](const auto& shader_defines) {
+                                 return vktf::glslang::CompileInfo{.glsl_shader = kGlslShader,
+                                                                   .glslang_stage = GLSLANG_STAGE_VERTEX,
+                                                                   .defines = shader_defines,
+                                                                   .log = log_};
+                               })
+                             | std::ranges::to<std::vector>();
+  vktf::ThreadPool thread_pool{2};
+
+  const auto spirv_binaries = vktf::glslang::Compile(compile_infos, thread_pool);
+
+  ASSERT_EQ(spirv_binaries.size(), compile_infos.size());
+  for (const auto& [spirv_binary, compile_info] : std::views::zip(spirv_binaries, compile_infos)) {
+    EXPECT_EQ(spirv_binary, vktf::glslang::Compile(compile_info));
+  }
+}
+
+TEST_F(CompileTest, PropagatesBatchCompilationFailures) {
+  static const std::string kInvalidGlslShader = "#version 460\nvoid main() { undeclared_variable = 1.0; }";
+  const std::array compile_infos{
+      vktf::glslang::CompileInfo{.glsl_shader = kGlslShader, .glslang_stage = GLSLANG_STAGE_VERTEX, .log = log_},
+      vktf::glslang::CompileInfo{.glsl_shader = kInvalidGlslShader, .glslang_stage = GLSLANG_STAGE_VERTEX, .log = log_},
+      vktf::glslang::CompileInfo{.glsl_shader = kGlslShader, .glslang_stage = GLSLANG_STAGE_VERTEX, .log = log_}};
+  vktf::ThreadPool thread_pool{2};
+
+  EXPECT_THROW(std::ignore = vktf::glslang::Compile(compile_infos, thread_pool), std::runtime_error);
+}
+
+}  // namespace
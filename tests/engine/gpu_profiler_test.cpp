@@ -0,0 +1,178 @@
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <optional>
+
+#include <gtest/gtest.h>
+
+#if VULKAN_HPP_DISPATCH_LOADER_DYNAMIC == 1
+#include <vulkan/vulkan.hpp>
+VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
+#endif
+
+import command_pool;
+import device;
+import gpu_profiler;
+import instance;
+import queue;
+
+namespace {
+
+// tests run on any Vulkan implementation that supports timestamps including software rasterizers such as lavapipe
+class GpuProfilerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    try {
+      static constexpr vk::ApplicationInfo kApplicationInfo{.apiVersion = vk::ApiVersion13};
+      instance_.emplace(vktf::Instance::CreateInfo{.application_info = kApplicationInfo});
+    } catch (const std::exception& exception) {
+      GTEST_SKIP() << "Vulkan is not available: " << exception.what();
+    }
+
+    const auto queue_family = FindTimestampQueueFamily();
+    if (!queue_family.has_value()) {
+      GTEST_SKIP() << "No Vulkan 1.2 physical device supports timestamps on a graphics queue";
+    }
+
+    device_.emplace(physical_device_,
+                    vktf::Device::CreateInfo{.queue_families = vktf::QueueFamilies{.graphics_family = *queue_family,
+                                                                                   .present_family = *queue_family,
+                                                                                   .transfer_family = *queue_family},
+                                             .enabled_features = vk::PhysicalDeviceFeatures{}});
+    queue_.emplace(**device_, vktf::Queue::CreateInfo{.queue_family = *queue_family, .queue_index = 0});
+    command_pool_.emplace(
+        **device_,
+        vktf::CommandPool::CreateInfo{.command_pool_create_flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+                                      .queue_family_index = queue_family->index,
+                                      .command_buffer_count = 1});
+  }
+
+  [[nodiscard]] vktf::GpuProfiler CreateGpuProfiler(const std::uint32_t max_frame_zone_count = 256,
+                                                    const std::uint32_t average_frame_count = 64) const {
+    return vktf::GpuProfiler{**device_,
+                             vktf::GpuProfiler::CreateInfo{.physical_device = physical_device_,
+                                                           .queue_family_index = queue_->queue_family_index(),
+                                                           .max_render_frames = 1,
+                                                           .max_frame_zone_count = max_frame_zone_count,
+                                                           .average_frame_count = average_frame_count}};
+  }
+
+  // zones are read back when the next frame begins so each frame waits for execution to complete before returning
+  void RenderFrame(vktf::GpuProfiler& gpu_profiler,
+                   const std::function<void(vk::CommandBuffer)>& record_zones = [](vk::CommandBuffer) {}) const {
+    const auto command_buffer = command_pool_->command_buffers().front();
+    command_buffer.begin(vk::CommandBufferBeginInfo{.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+    gpu_profiler.BeginFrame(command_buffer, 0);
+    record_zones(command_buffer);
+    command_buffer.end();
+
+    (*queue_)->submit(vk::SubmitInfo{.commandBufferCount = 1, .pCommandBuffers = &command_buffer});
+    (*queue_)->waitIdle();
+  }
+
+private:
+  std::optional<vktf::QueueFamily> FindTimestampQueueFamily() {
+    for (const auto physical_device : (**instance_).enumeratePhysicalDevices()) {
+      if (physical_device.getProperties().apiVersion < vk::ApiVersion12) continue;  // required for timeline semaphores
+
+      for (std::uint32_t index = 0; const auto& queue_family_properties : physical_device.getQueueFamilyProperties()) {
+        if (queue_family_properties.queueFlags & vk::QueueFlagBits::eGraphics
+            && queue_family_properties.timestampValidBits > 0) {
+          physical_device_ = physical_device;
+          return vktf::QueueFamily{.index = index, .queue_count = queue_family_properties.queueCount};
+        }
+        ++index;
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::optional<vktf::Instance> instance_;
+  vk::PhysicalDevice physical_device_;
+  std::optional<vktf::Device> device_;
+  std::optional<vktf::Queue> queue_;
+  std::optional<vktf::CommandPool> command_pool_;
+};
+
+TEST_F(GpuProfilerTest, RecordsAverageTimingsOfCompletedFrames) {
+  static constexpr auto kFrameCount = 4u;
+  auto gpu_profiler = CreateGpuProfiler();
+  ASSERT_TRUE(gpu_profiler.is_supported());
+
+  for (auto frame_index = 0u; frame_index < kFrameCount; ++frame_index) {
+    RenderFrame(gpu_profiler, [&gpu_profiler](const vk::CommandBuffer command_buffer) {
+      const vktf::GpuProfileZone outer_gpu_profile_zone{&gpu_profiler, command_buffer, "Outer"};
+      const vktf::GpuProfileZone inner_gpu_profile_zone{&gpu_profiler, command_buffer, "Inner"};
+    });
+  }
+  // the most recent frame is read back when the next frame begins
+  ASSERT_EQ(gpu_profiler.GetAverageTimings().size(), 2uz);
+  EXPECT_EQ(gpu_profiler.GetAverageTimings().front().frame_count, kFrameCount - 1);
+
+  RenderFrame(gpu_profiler);
+  const auto zone_timings = gpu_profiler.GetAverageTimings();
+
+  ASSERT_EQ(zone_timings.size(), 2uz);
+  EXPECT_EQ(zone_timings[0].name, "Inner");
+  EXPECT_EQ(zone_timings[1].name, "Outer");
+  for (const auto& zone_timing : zone_timings) {
+    EXPECT_EQ(zone_timing.frame_count, kFrameCount);
+    EXPECT_GE(zone_timing.average_milliseconds, 0.0);
+  }
+}
+
+TEST_F(GpuProfilerTest, SumsZonesRecordedMultipleTimesInTheSameFrame) {
+  static constexpr auto kFrameCount = 3u;
+  static constexpr std::uint64_t kModelId = 7;
+  auto gpu_profiler = CreateGpuProfiler();
+
+  for (auto frame_index = 0u; frame_index < kFrameCount; ++frame_index) {
+    RenderFrame(gpu_profiler, [&gpu_profiler](const vk::CommandBuffer command_buffer) {
+      for (auto command_buffer_index = 0; command_buffer_index < 2; ++command_buffer_index) {
+        const vktf::GpuProfileZone gpu_profile_zone{&gpu_profiler, command_buffer, "Model", kModelId};
+      }
+    });
+  }
+  RenderFrame(gpu_profiler);
+  const auto zone_timings = gpu_profiler.GetAverageTimings();
+
+  ASSERT_EQ(zone_timings.size(), 1uz);
+  EXPECT_EQ(zone_timings[0].name, "Model");
+  EXPECT_EQ(zone_timings[0].id, kModelId);
+  EXPECT_EQ(zone_timings[0].frame_count, kFrameCount);
+}
+
+TEST_F(GpuProfilerTest, AveragesTimingsOverTheMostRecentFrames) {
+  static constexpr auto kAverageFrameCount = 2u;
+  auto gpu_profiler = CreateGpuProfiler(256, kAverageFrameCount);
+
+  for (auto frame_index = 0u; frame_index < 2 * kAverageFrameCount + 1; ++frame_index) {
+    RenderFrame(gpu_profiler, [&gpu_profiler](const vk::CommandBuffer command_buffer) {
+      const vktf::GpuProfileZone gpu_profile_zone{&gpu_profiler, command_buffer, "Zone"};
+    });
+  }
+  RenderFrame(gpu_profiler);
+  const auto zone_timings = gpu_profiler.GetAverageTimings();
+
+  ASSERT_EQ(zone_timings.size(), 1uz);
+  EXPECT_EQ(zone_timings[0].frame_count, kAverageFrameCount);
+}
+
+TEST_F(GpuProfilerTest, IgnoresZonesBeyondTheMaximumFrameZoneCount) {
+  auto gpu_profiler = CreateGpuProfiler(1);
+
+  RenderFrame(gpu_profiler, [&gpu_profiler](const vk::CommandBuffer command_buffer) {
+    const auto first_zone_index = gpu_profiler.BeginZone(command_buffer, "First");
+    const auto second_zone_index = gpu_profiler.BeginZone(command_buffer, "Second");
+    ASSERT_TRUE(first_zone_index.has_value());
+    EXPECT_FALSE(second_zone_index.has_value());
+    gpu_profiler.EndZone(command_buffer, *first_zone_index);
+  });
+  RenderFrame(gpu_profiler);
+  const auto zone_timings = gpu_profiler.GetAverageTimings();
+
+  ASSERT_EQ(zone_timings.size(), 1uz);
+  EXPECT_EQ(zone_timings[0].name, "First");
+}
+
+}  // namespace
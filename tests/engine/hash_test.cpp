@@ -0,0 +1,50 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+import hash;
+
+namespace {
+
+std::uint64_t Hash(const std::string_view value, const std::uint64_t seed = vktf::kFnv1aOffsetBasis) {
+  return vktf::Hash(std::as_bytes(std::span{value}), seed);
+}
+
+TEST(HashTest, EmptyBytesHashToTheSeed) {
+  EXPECT_EQ(vktf::kFnv1aOffsetBasis, Hash(""));
+  EXPECT_EQ(std::uint64_t{42}, Hash("", 42));
+}
+
+TEST(HashTest, MatchesFnv1aReferenceValues) {
+  EXPECT_EQ(0xaf63dc4c8601ec8c, Hash("a"));
+  EXPECT_EQ(0x85944171f73967e8, Hash("foobar"));
+}
+
+TEST(HashTest, CanBeComputedIncrementally) {
+  EXPECT_EQ(Hash("foobar"), Hash("bar", Hash("foo")));
+}
+
+TEST(HashTest, DependsOnByteOrder) {
+  EXPECT_NE(Hash("ab"), Hash("ba"));
+}
+
+TEST(HashTest, HashesFileContents) {
+  const auto filepath = std::filesystem::temp_directory_path() / "vktf_hash_test.bin";
+  std::ofstream{filepath, std::ios::binary} << "foobar";
+
+  EXPECT_EQ(Hash("foobar"), vktf::HashFile(filepath));
+  std::filesystem::remove(filepath);
+}
+
+TEST(HashTest, HashingAMissingFileThrows) {
+  EXPECT_THROW(std::ignore = vktf::HashFile(std::filesystem::temp_directory_path() / "vktf_missing_file.bin"),
+               std::runtime_error);
+}
+
+}  // namespace
@@ -1,7 +1,15 @@
+#include <algorithm>
+#include <cstddef>
 #include <filesystem>
+#include <format>
+#include <ranges>
 #include <source_location>
 #include <sstream>
+#include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -9,6 +17,22 @@ import log;
 
 namespace {
 
+// a formattable type that counts how many times it has been formatted
+struct FormatCounter {
+  int* format_count = nullptr;
+};
+
+}  // namespace
+
+template <>
+struct std::formatter<FormatCounter> : std::formatter<int> {
+  auto format(const FormatCounter& format_counter, std::format_context& format_context) const {
+    return std::formatter<int>::format(++*format_counter.format_count, format_context);
+  }
+};
+
+namespace {
+
 class LogTest : public ::testing::Test {
 protected:
   using Severity = vktf::Log::Severity;
@@ -117,4 +141,133 @@ TEST_F(LogTest, PrintsToCorrectOutputStreamWithErrorSeverity) {
   EXPECT_EQ(expected_message, actual_message);
 }
 
+TEST_F(LogTest, StartsWithCompileTimeMinSeverity) {
+  EXPECT_EQ(vktf::Log::kMinSeverity, log_.min_severity());
+}
+
+TEST_F(LogTest, IsEnabledOnlyForSeveritiesAtLeastMinSeverity) {
+  log_.SetMinSeverity(Severity::kWarning);
+
+  EXPECT_FALSE(log_.IsEnabled(Severity::kInfo));
+  EXPECT_EQ(vktf::Log::kMinSeverity <= Severity::kWarning, log_.IsEnabled(Severity::kWarning));
+  EXPECT_EQ(vktf::Log::kMinSeverity <= Severity::kError, log_.IsEnabled(Severity::kError));
+}
+
+TEST_F(LogTest, DiscardsMessagesBelowMinSeverity) {
+  log_.SetMinSeverity(Severity::kError);
+  log_(Severity::kInfo, source_location_) << "INFO";
+  log_(Severity::kWarning, source_location_).Print("{}", "WARNING");
+
+  EXPECT_EQ(0, info_ostream_.tellp());
+  EXPECT_EQ(0, warning_ostream_.tellp());
+}
+
+TEST_F(LogTest, SkipsFormattingMessagesBelowMinSeverity) {
+  auto format_count = 0;
+  log_.SetMinSeverity(Severity::kError);
+  log_(Severity::kInfo, source_location_).Print("{}", FormatCounter{.format_count = &format_count});
+
+  EXPECT_EQ(0, format_count);
+  EXPECT_EQ(0, info_ostream_.tellp());
+}
+
+TEST_F(LogTest, FormatsMessagesAtLeastMinSeverity) {
+  auto format_count = 0;
+  log_.SetMinSeverity(Severity::kError);
+  log_(Severity::kError, source_location_).Print("{}", FormatCounter{.format_count = &format_count});
+
+  EXPECT_EQ(vktf::Log::kMinSeverity <= Severity::kError ? 1 : 0, format_count);
+}
+
+TEST_F(LogTest, AsynchronousLogWritesMessagesInOrderOnDestruction) {
+  static constexpr auto kMessageCount = 1'000;
+  std::string expected_info_messages;
+  std::string expected_error_messages;
+  {
+    vktf::Log log{info_ostream_, warning_ostream_, error_ostream_, vktf::Log::Mode::kAsynchronous};
+    for (auto index = 0; index < kMessageCount; ++index) {
+      const auto message = std::to_string(index);
+      if (index % 2 == 0) {
+        log(Severity::kInfo, source_location_) << message;
+        expected_info_messages += GetLogFormat(message);
+      } else {
+        log(Severity::kError, source_location_).Print("{}", message);
+        expected_error_messages += GetLogFormat(message);
+      }
+    }
+  }
+
+  EXPECT_EQ(expected_info_messages, info_ostream_.str());
+  EXPECT_EQ(0, warning_ostream_.tellp());
+  EXPECT_EQ(expected_error_messages, error_ostream_.str());
+}
+
+TEST_F(LogTest, AsynchronousLogWritesNestedMessagesOnSeparateLines) {
+  static constexpr std::string_view kOuterMessage = "OUTER";
+  static constexpr std::string_view kInnerMessage = "INNER";
+  {
+    vktf::Log log{info_ostream_, warning_ostream_, error_ostream_, vktf::Log::Mode::kAsynchronous};
+    const auto get_inner_message = [&log, this] {
+      log(Severity::kInfo, source_location_) << kInnerMessage;
+      return kOuterMessage;
+    };
+    log(Severity::kInfo, source_location_) << get_inner_message();
+  }
+
+  const auto expected_messages = GetLogFormat(kInnerMessage) + GetLogFormat(kOuterMessage);
+  EXPECT_EQ(expected_messages, info_ostream_.str());
+}
+
+TEST_F(LogTest, AsynchronousLogDoesNotRetainMessagesInRecycledRecords) {
+  static constexpr auto kMessageCount = 1'000;
+  std::string expected_messages;
+  {
+    vktf::Log log{info_ostream_, warning_ostream_, error_ostream_, vktf::Log::Mode::kAsynchronous};
+    for (auto index = 0; index < kMessageCount; ++index) {
+      // alternating message lengths ensures a shorter message never contains text from a longer recycled message
+      const auto message = index % 2 == 0 ? std::string(static_cast<std::size_t>(index), 'x') : std::to_string(index);
+      log(Severity::kInfo, source_location_) << message;
+      expected_messages += GetLogFormat(message);
+      if (index % 100 == 0) std::this_thread::yield();  // allow the writer thread to recycle written records
+    }
+  }
+
+  EXPECT_EQ(expected_messages, info_ostream_.str());
+}
+
+TEST_F(LogTest, AsynchronousLogWritesAllMessagesFromConcurrentThreads) {
+  static constexpr auto kThreadCount = 8;
+  static constexpr auto kMessageCount = 1'000;
+  {
+    vktf::Log log{info_ostream_, warning_ostream_, error_ostream_, vktf::Log::Mode::kAsynchronous};
+    std::vector<std::jthread> threads;
+    for (auto thread_index = 0; thread_index < kThreadCount; ++thread_index) {
+      threads.emplace_back([&log, this, thread_index] {
+        for (auto index = 0; index < kMessageCount; ++index) {
+          log(Severity::kInfo, source_location_).Print("{}:{}", thread_index, index);
+        }
+      });
+    }
+  }
+
+  std::vector<std::string> expected_lines;
+  for (auto thread_index = 0; thread_index < kThreadCount; ++thread_index) {
+    for (auto index = 0; index < kMessageCount; ++index) {
+      auto expected_line = GetLogFormat(std::format("{}:{}", thread_index, index));
+      expected_line.pop_back();  // remove the trailing newline which is not included in split lines
+      expected_lines.push_back(std::move(expected_line));
+    }
+  }
+
+  auto actual_lines = info_ostream_.str()
+                      | std::views::split('\n')
+                      | std::views::filter([](const auto& line) { return !line.empty(); })
+                      | std::views::transform([](const auto& line) { return std::string{line.begin(), line.end()}; })
+                      | std::ranges::to<std::vector>();
+
+  std::ranges::sort(expected_lines);
+  std::ranges::sort(actual_lines);
+  EXPECT_EQ(expected_lines, actual_lines);
+}
+
 }  // namespace
@@ -0,0 +1,200 @@
+#include <cstdint>
+#include <format>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+import node_hierarchy;
+import thread_pool;
+
+namespace {
+
+constexpr auto kEpsilon = 1.0e-5f;
+constexpr glm::mat4 kIdentity{1.0f};
+
+void ExpectNearEqual(const glm::mat4& lhs, const glm::mat4& rhs) {
+  for (auto i = 0; i < 4; ++i) {
+    for (auto j = 0; j < 4; ++j) {
+      EXPECT_NEAR(lhs[i][j], rhs[i][j], kEpsilon) << std::format("Matrix elements at ({},{}) are not equal", i, j);
+    }
+  }
+}
+
+glm::mat4 Translate(const glm::vec3& translation) { return glm::translate(kIdentity, translation); }
+
+glm::mat4 RotateY(const float angle_degrees) {
+  return glm::rotate(kIdentity, glm::radians(angle_degrees), glm::vec3{0.0f, 1.0f, 0.0f});
+}
+
+TEST(NodeHierarchyTest, AddsNodesInOrder) {
+  vktf::NodeHierarchy node_hierarchy;
+  const auto root_index = node_hierarchy.Add(kIdentity);
+  const auto child_index = node_hierarchy.Add(kIdentity, root_index);
+
+  EXPECT_EQ(root_index, 0u);
+  EXPECT_EQ(child_index, 1u);
+  EXPECT_EQ(node_hierarchy.size(), 2uz);
+  EXPECT_EQ(node_hierarchy.parent_indices()[root_index], vktf::NodeHierarchy::kNoParent);
+  EXPECT_EQ(node_hierarchy.parent_indices()[child_index], root_index);
+}
+
+TEST(NodeHierarchyTest, UpdatesRootNodeGlobalTransformWithRootTransform) {
+  vktf::NodeHierarchy node_hierarchy;
+  const auto local_transform = Translate(glm::vec3{1.0f, 2.0f, 3.0f});
+  const auto root_transform = RotateY(90.0f);
+  const auto root_index = node_hierarchy.Add(local_transform);
+
+  node_hierarchy.SetRootTransform(root_transform);
+  node_hierarchy.Update();
+
+  ExpectNearEqual(node_hierarchy.global_transforms()[root_index], root_transform * local_transform);
+}
+
+TEST(NodeHierarchyTest, UpdatesDescendantGlobalTransformsFromParentGlobalTransforms) {
+  vktf::NodeHierarchy node_hierarchy;
+  const auto root_transform = Translate(glm::vec3{1.0f, 0.0f, 0.0f});
+  const auto child_transform = RotateY(45.0f);
+  const auto offset_transform = Translate(glm::vec3{0.0f, 0.0f, 2.0f});
+
+  const auto root_index = node_hierarchy.Add(root_transform);
+  const auto child_index = node_hierarchy.Add(child_transform, root_index);
+  const auto sibling_index = node_hierarchy.Add(offset_transform, root_index);
+  const auto grandchild_index = node_hierarchy.Add(offset_transform, child_index);
+
+  node_hierarchy.Update();
+
+  const auto& global_transforms = node_hierarchy.global_transforms();
+  ExpectNearEqual(global_transforms[root_index], root_transform);
+  ExpectNearEqual(global_transforms[child_index], root_transform * child_transform);
+  ExpectNearEqual(global_transforms[sibling_index], root_transform * offset_transform);
+  ExpectNearEqual(global_transforms[grandchild_index], root_transform * child_transform * offset_transform);
+}
+
+TEST(NodeHierarchyTest, UpdatesMultipleRootNodesIndependently) {
+  vktf::NodeHierarchy node_hierarchy;
+  const auto first_root_transform = Translate(glm::vec3{1.0f, 0.0f, 0.0f});
+  const auto second_root_transform = Translate(glm::vec3{0.0f, 1.0f, 0.0f});
+  const auto first_root_index = node_hierarchy.Add(first_root_transform);
+  const auto second_root_index = node_hierarchy.Add(second_root_transform);
+
+  node_hierarchy.Update();
+
+  ExpectNearEqual(node_hierarchy.global_transforms()[first_root_index], first_root_transform);
+  ExpectNearEqual(node_hierarchy.global_transforms()[second_root_index], second_root_transform);
+}
+
+TEST(NodeHierarchyTest, DoesNotUpdateStaticHierarchy) {
+  vktf::NodeHierarchy node_hierarchy;
+  const auto root_index = node_hierarchy.Add(kIdentity);
+
+  EXPECT_TRUE(node_hierarchy.Update());
+  EXPECT_TRUE(node_hierarchy.updated(root_index));
+
+  EXPECT_FALSE(node_hierarchy.Update());
+  EXPECT_FALSE(node_hierarchy.updated(root_index));
+}
+
+TEST(NodeHierarchyTest, UpdatesOnlyTheSubtreeOfANodeWithANewLocalTransform) {
+  vktf::NodeHierarchy node_hierarchy;
+  const auto root_index = node_hierarchy.Add(kIdentity);
+  const auto child_index = node_hierarchy.Add(kIdentity, root_index);
+  const auto grandchild_index = node_hierarchy.Add(kIdentity, child_index);
+  const auto sibling_index = node_hierarchy.Add(kIdentity, root_index);
+  node_hierarchy.Update();
+
+  const auto child_transform = Translate(glm::vec3{0.0f, 3.0f, 0.0f});
+  node_hierarchy.SetLocalTransform(child_index, child_transform);
+
+  EXPECT_TRUE(node_hierarchy.Update());
+  EXPECT_FALSE(node_hierarchy.updated(root_index));
+  EXPECT_TRUE(node_hierarchy.updated(child_index));
+  EXPECT_TRUE(node_hierarchy.updated(grandchild_index));
+  EXPECT_FALSE(node_hierarchy.updated(sibling_index));
+
+  const auto& global_transforms = node_hierarchy.global_transforms();
+  ExpectNearEqual(node_hierarchy.local_transforms()[child_index], child_transform);
+  ExpectNearEqual(global_transforms[child_index], child_transform);
+  ExpectNearEqual(global_transforms[grandchild_index], child_transform);
+  ExpectNearEqual(global_transforms[sibling_index], kIdentity);
+}
+
+TEST(NodeHierarchyTest, UpdatesAllNodesWhenTheRootTransformChanges) {
+  vktf::NodeHierarchy node_hierarchy;
+  const auto root_index = node_hierarchy.Add(kIdentity);
+  const auto child_index = node_hierarchy.Add(kIdentity, root_index);
+  node_hierarchy.Update();
+
+  const auto root_transform = Translate(glm::vec3{0.0f, 0.0f, -1.0f});
+  node_hierarchy.SetRootTransform(root_transform);
+
+  EXPECT_TRUE(node_hierarchy.Update());
+  EXPECT_TRUE(node_hierarchy.updated(root_index));
+  EXPECT_TRUE(node_hierarchy.updated(child_index));
+  ExpectNearEqual(node_hierarchy.global_transforms()[child_index], root_transform);
+}
+
+TEST(NodeHierarchyTest, StartsASegmentAtEachRootSubtreeAddedInDepthFirstPreOrder) {
+  vktf::NodeHierarchy node_hierarchy;
+  const auto first_root_index = node_hierarchy.Add(kIdentity);
+  node_hierarchy.Add(kIdentity, first_root_index);
+  const auto second_root_index = node_hierarchy.Add(kIdentity);
+  node_hierarchy.Add(kIdentity, second_root_index);
+
+  EXPECT_EQ(node_hierarchy.segment_offsets(), (std::vector{first_root_index, second_root_index}));
+}
+
+TEST(NodeHierarchyTest, MergesSegmentsWhenAChildIsAddedToAnEarlierSegment) {
+  vktf::NodeHierarchy node_hierarchy;
+  const auto first_root_index = node_hierarchy.Add(kIdentity);
+  node_hierarchy.Add(kIdentity);
+  node_hierarchy.Add(kIdentity, first_root_index);
+
+  EXPECT_EQ(node_hierarchy.segment_offsets(), std::vector{first_root_index});
+}
+
+TEST(NodeHierarchyTest, UpdatesAsynchronouslyWithTheSameResultsAsASerialUpdate) {
+  static constexpr auto kNodeCount = 100'000u;
+  std::mt19937 random_engine{42};  // use a fixed seed for reproducible test results
+  std::uniform_real_distribution translation_distribution{-1.0f, 1.0f};
+  vktf::NodeHierarchy serial_node_hierarchy;
+  vktf::NodeHierarchy parallel_node_hierarchy;
+
+  // add many small subtrees in depth-first pre-order to produce multiple segments
+  for (auto node_index = 0u; node_index < kNodeCount; ++node_index) {
+    const auto parent_index = node_index % 8 == 0 ? vktf::NodeHierarchy::kNoParent : node_index - 1;
+    const auto local_transform = Translate(glm::vec3{translation_distribution(random_engine)});
+    serial_node_hierarchy.Add(local_transform, parent_index);
+    parallel_node_hierarchy.Add(local_transform, parent_index);
+  }
+
+  vktf::ThreadPool thread_pool{4};
+  for (const auto node_index : {kNodeCount / 2, 0u}) {
+    const auto local_transform = Translate(glm::vec3{translation_distribution(random_engine)});
+    serial_node_hierarchy.SetLocalTransform(node_index, local_transform);
+    parallel_node_hierarchy.SetLocalTransform(node_index, local_transform);
+
+    const auto is_updated = serial_node_hierarchy.Update();
+    auto update_futures = parallel_node_hierarchy.UpdateAsync(thread_pool);
+    EXPECT_EQ(is_updated, !update_futures.empty());
+    for (auto& update_future : update_futures) {
+      update_future.get();
+    }
+
+    for (auto index = 0u; index < kNodeCount; ++index) {
+      ASSERT_EQ(serial_node_hierarchy.updated(index), parallel_node_hierarchy.updated(index));
+      ASSERT_EQ(serial_node_hierarchy.global_transforms()[index], parallel_node_hierarchy.global_transforms()[index]);
+    }
+  }
+
+  EXPECT_TRUE(parallel_node_hierarchy.UpdateAsync(thread_pool).empty());
+}
+
+TEST(NodeHierarchyDeathTest, AssertsWhenParentIsAddedAfterChild) {
+  vktf::NodeHierarchy node_hierarchy;
+  EXPECT_DEBUG_DEATH(node_hierarchy.Add(kIdentity, 1), "");
+}
+
+}  // namespace
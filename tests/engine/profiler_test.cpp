@@ -0,0 +1,123 @@
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+import profiler;
+
+namespace {
+
+std::size_t CountOccurrences(const std::string& text, const std::string& pattern) {
+  std::size_t count = 0;
+  for (auto position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+std::string GetChromeTrace(const vktf::Profiler& profiler) {
+  std::ostringstream trace_ostream;
+  profiler.WriteChromeTrace(trace_ostream);
+  return trace_ostream.str();
+}
+
+TEST(ProfilerTest, DoesNotRecordZonesWhenStopped) {
+  vktf::Profiler profiler;
+  {
+    const vktf::ProfileZone profile_zone{"Zone", profiler};
+  }
+
+  EXPECT_FALSE(profiler.is_recording());
+  EXPECT_EQ(GetChromeTrace(profiler).find(R"("name":"Zone")"), std::string::npos);
+}
+
+TEST(ProfilerTest, RecordsNestedZones) {
+  vktf::Profiler profiler;
+  profiler.Start();
+  {
+    const vktf::ProfileZone outer_profile_zone{"Outer", profiler};
+    const vktf::ProfileZone inner_profile_zone{"Inner", profiler};
+  }
+  profiler.Stop();
+
+  // zones are recorded when they end so inner zones precede the zones that contain them
+  const auto chrome_trace = GetChromeTrace(profiler);
+  const auto inner_position = chrome_trace.find(R"("name":"Inner")");
+  const auto outer_position = chrome_trace.find(R"("name":"Outer")");
+  ASSERT_NE(inner_position, std::string::npos);
+  ASSERT_NE(outer_position, std::string::npos);
+  EXPECT_LT(inner_position, outer_position);
+  EXPECT_EQ(CountOccurrences(chrome_trace, R"("ph":"X")"), 2uz);
+}
+
+TEST(ProfilerTest, DiscardsZonesFromPreviousCaptures) {
+  vktf::Profiler profiler;
+  profiler.Start();
+  {
+    const vktf::ProfileZone profile_zone{"First", profiler};
+  }
+  profiler.Stop();
+
+  profiler.Start();
+  {
+    const vktf::ProfileZone profile_zone{"Second", profiler};
+  }
+  profiler.Stop();
+
+  const auto chrome_trace = GetChromeTrace(profiler);
+  EXPECT_EQ(chrome_trace.find(R"("name":"First")"), std::string::npos);
+  EXPECT_NE(chrome_trace.find(R"("name":"Second")"), std::string::npos);
+}
+
+TEST(ProfilerTest, DropsZonesWhenTheThreadBufferIsFull) {
+  static constexpr std::size_t kThreadEventCapacity = 4;
+  vktf::Profiler profiler{kThreadEventCapacity};
+  profiler.Start();
+  for (std::size_t index = 0; index < kThreadEventCapacity + 2; ++index) {
+    const vktf::ProfileZone profile_zone{"Zone", profiler};
+  }
+  profiler.Stop();
+
+  EXPECT_EQ(profiler.dropped_event_count(), 2uz);
+  EXPECT_EQ(CountOccurrences(GetChromeTrace(profiler), R"("ph":"X")"), kThreadEventCapacity);
+}
+
+TEST(ProfilerTest, RecordsZonesFromConcurrentThreads) {
+  static constexpr auto kThreadCount = 4uz;
+  static constexpr auto kZoneCount = 100uz;
+
+  vktf::Profiler profiler;
+  profiler.Start();
+  {
+    std::vector<std::jthread> threads;
+    for (std::size_t thread_index = 0; thread_index < kThreadCount; ++thread_index) {
+      threads.emplace_back([&profiler] {
+        for (std::size_t index = 0; index < kZoneCount; ++index) {
+          const vktf::ProfileZone profile_zone{"Zone", profiler};
+        }
+      });
+    }
+  }
+  profiler.Stop();
+
+  const auto chrome_trace = GetChromeTrace(profiler);
+  EXPECT_EQ(profiler.dropped_event_count(), 0uz);
+  EXPECT_EQ(CountOccurrences(chrome_trace, R"("name":"thread_name")"), kThreadCount);
+  EXPECT_EQ(CountOccurrences(chrome_trace, R"("ph":"X")"), kThreadCount * kZoneCount);
+}
+
+TEST(ProfilerTest, EscapesZoneNames) {
+  vktf::Profiler profiler;
+  profiler.Start();
+  {
+    const vktf::ProfileZone profile_zone{"\"Quoted\"\\", profiler};
+  }
+  profiler.Stop();
+
+  EXPECT_NE(GetChromeTrace(profiler).find(R"("name":"\"Quoted\"\\")"), std::string::npos);
+}
+
+}  // namespace
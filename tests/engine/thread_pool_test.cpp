@@ -0,0 +1,98 @@
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <latch>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+import thread_pool;
+
+namespace {
+
+TEST(ThreadPoolTest, CreatesTheRequestedNumberOfThreads) {
+  const vktf::ThreadPool thread_pool{3};
+  EXPECT_EQ(thread_pool.thread_count(), 3uz);
+}
+
+TEST(ThreadPoolTest, CreatesAtLeastOneThreadByDefault) {
+  const vktf::ThreadPool thread_pool;
+  EXPECT_GE(thread_pool.thread_count(), 1uz);
+}
+
+TEST(ThreadPoolTest, ReturnsTaskResults) {
+  vktf::ThreadPool thread_pool{4};
+  auto futures = std::views::iota(0, 100)
+                 | std::views::transform([&thread_pool](const auto value) {
+                     return thread_pool.Submit([value] { return value * value; });
+                   })
+                 | std::ranges::to<std::vector>();
+
+  for (auto&& [value, future] : std::views::enumerate(futures)) {
+    EXPECT_EQ(future.get(), value * value);
+  }
+}
+
+TEST(ThreadPoolTest, ExecutesTasksOnLowPriorityThreads) {
+  vktf::ThreadPool thread_pool{2, vktf::ThreadPool::Priority::kLow};
+  auto future = thread_pool.Submit([] { return 42; });
+  EXPECT_EQ(future.get(), 42);
+}
+
+TEST(ThreadPoolTest, PropagatesTaskExceptions) {
+  vktf::ThreadPool thread_pool{2};
+  auto future = thread_pool.Submit([] { throw std::runtime_error{"task failed"}; });
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, ExecutesTasksConcurrently) {
+  static constexpr auto kThreadCount = 4;
+  vktf::ThreadPool thread_pool{kThreadCount};
+  std::latch latch{kThreadCount};
+
+  // each task blocks until all tasks are running which deadlocks unless tasks are executed on separate threads
+  auto futures = std::views::iota(0, kThreadCount)
+                 | std::views::transform([&thread_pool, &latch](const auto /*index*/) {
+                     return thread_pool.Submit([&latch] { latch.arrive_and_wait(); });
+                   })
+                 | std::ranges::to<std::vector>();
+
+  for (auto& future : futures) {
+    EXPECT_EQ(future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+  }
+}
+
+TEST(ThreadPoolTest, StealsTasksQueuedBehindABlockedTask) {
+  vktf::ThreadPool thread_pool{2};
+  std::promise<void> release_promise;
+  auto blocked_future = thread_pool.Submit([release_future = release_promise.get_future()] { release_future.wait(); });
+
+  // tasks are distributed across both task queues which requires the idle worker to steal tasks from the blocked worker
+  auto futures = std::views::iota(0, 10)
+                 | std::views::transform([&thread_pool](const auto value) {
+                     return thread_pool.Submit([value] { return value; });
+                   })
+                 | std::ranges::to<std::vector>();
+
+  for (auto& future : futures) {
+    EXPECT_EQ(future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+  }
+
+  release_promise.set_value();
+  blocked_future.get();
+}
+
+TEST(ThreadPoolTest, ExecutesRemainingTasksOnDestruction) {
+  std::atomic_int task_count = 0;
+  {
+    vktf::ThreadPool thread_pool{2};
+    for (auto index = 0; index < 100; ++index) {
+      static_cast<void>(thread_pool.Submit([&task_count] { ++task_count; }));
+    }
+  }
+  EXPECT_EQ(task_count, 100);
+}
+
+}  // namespace
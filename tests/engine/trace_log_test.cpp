@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <ranges>
+#include <source_location>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+import log;
+import mapped_file;
+import trace_log;
+
+namespace {
+
+// a formattable type that records a message to a trace log while it is being formatted
+struct NestedMessage {
+  vktf::TraceLog* trace_log = nullptr;
+  std::source_location source_location;
+};
+
+}  // namespace
+
+template <>
+struct std::formatter<NestedMessage> : std::formatter<std::string_view> {
+  auto format(const NestedMessage& nested_message, std::format_context& format_context) const {
+    nested_message.trace_log->Write(0, nested_message.source_location, "{}", "inner");
+    return std::formatter<std::string_view>::format("outer", format_context);
+  }
+};
+
+namespace {
+
+class TraceLogTest : public ::testing::Test {
+protected:
+  static constexpr std::size_t kRingSize = 64ull << 10u;
+
+  ~TraceLogTest() override {
+    std::error_code error_code;
+    std::filesystem::remove(trace_filepath_, error_code);
+  }
+
+  [[nodiscard]] vktf::TraceLog::CreateInfo GetCreateInfo(const std::size_t ring_size = kRingSize) const {
+    return vktf::TraceLog::CreateInfo{.trace_filepath = trace_filepath_, .ring_size = ring_size};
+  }
+
+  [[nodiscard]] std::vector<std::string> Decode() const {
+    const vktf::MappedFile trace_file{trace_filepath_};
+    std::ostringstream trace_ostream;
+    vktf::DecodeTrace(trace_file.data(), trace_ostream);
+
+    return trace_ostream.str()
+           | std::views::split('\n')
+           | std::views::filter([](const auto& line) { return !line.empty(); })
+           | std::views::transform([](const auto& line) { return std::string{line.begin(), line.end()}; })
+           | std::ranges::to<std::vector>();
+  }
+
+  // decoded lines begin with a timestamp which is removed to compare the remainder of each line
+  [[nodiscard]] static std::string RemoveTimestamp(const std::string_view line) {
+    return std::string{line.substr(line.find(' ') + 1)};
+  }
+
+  [[nodiscard]] std::string GetLineFormat(const std::string_view severity, const std::string_view message) const {
+    return std::format("[{}] [{}:{}] {}",
+                       severity,
+                       std::filesystem::path{source_location_.file_name()}.filename().string(),
+                       source_location_.line(),
+                       message);
+  }
+
+  std::source_location source_location_ = std::source_location::current();
+  std::filesystem::path trace_filepath_ =
+      std::filesystem::temp_directory_path()
+      / std::format("vktf_{}.trace", ::testing::UnitTest::GetInstance()->current_test_info()->name());
+};
+
+TEST_F(TraceLogTest, DecodesRawArguments) {
+  {
+    vktf::TraceLog trace_log{GetCreateInfo()};
+    trace_log.Write(0, source_location_, "{} {} {} {:.2f} {} {}", 42u, -7, true, 3.14159, 'c', "text");
+  }
+
+  const auto lines = Decode();
+  ASSERT_EQ(lines.size(), 1uz);
+  EXPECT_EQ(RemoveTimestamp(lines[0]), GetLineFormat("INFO", "42 -7 true 3.14 c text"));
+}
+
+TEST_F(TraceLogTest, DecodesSeverities) {
+  {
+    vktf::TraceLog trace_log{GetCreateInfo()};
+    trace_log.Write(0, source_location_, "A");
+    trace_log.Write(1, source_location_, "B");
+    trace_log.Write(2, source_location_, "C");
+  }
+
+  const auto lines = Decode();
+  ASSERT_EQ(lines.size(), 3uz);
+  EXPECT_EQ(RemoveTimestamp(lines[0]), GetLineFormat("INFO", "A"));
+  EXPECT_EQ(RemoveTimestamp(lines[1]), GetLineFormat("WARNING", "B"));
+  EXPECT_EQ(RemoveTimestamp(lines[2]), GetLineFormat("ERROR", "C"));
+}
+
+TEST_F(TraceLogTest, DecodesEscapedBracesAndPositionalArguments) {
+  {
+    vktf::TraceLog trace_log{GetCreateInfo()};
+    trace_log.Write(0, source_location_, "{{{1}, {0}}}", 1, 2);
+  }
+
+  const auto lines = Decode();
+  ASSERT_EQ(lines.size(), 1uz);
+  EXPECT_EQ(RemoveTimestamp(lines[0]), GetLineFormat("INFO", "{2, 1}"));
+}
+
+TEST_F(TraceLogTest, TruncatesLongStringArguments) {
+  const std::string long_string(vktf::TraceLog::kMaxStringSize + 1, 'a');
+  {
+    vktf::TraceLog trace_log{GetCreateInfo()};
+    trace_log.Write(0, source_location_, "{}", long_string);
+  }
+
+  const auto lines = Decode();
+  ASSERT_EQ(lines.size(), 1uz);
+  EXPECT_EQ(RemoveTimestamp(lines[0]), GetLineFormat("INFO", std::string(vktf::TraceLog::kMaxStringSize, 'a')));
+}
+
+TEST_F(TraceLogTest, OverwritesOldestMessagesWhenTheRingIsFull) {
+  static constexpr auto kMessageCount = 10'000;
+  {
+    vktf::TraceLog trace_log{GetCreateInfo()};
+    for (auto index = 0; index < kMessageCount; ++index) {
+      trace_log.Write(0, source_location_, "{}", index);
+    }
+  }
+
+  const auto lines = Decode();
+  ASSERT_FALSE(lines.empty());
+  ASSERT_LT(lines.size(), static_cast<std::size_t>(kMessageCount));
+
+  const auto first_index = kMessageCount - static_cast<int>(lines.size());
+  for (const auto& [index, line] : std::views::enumerate(lines)) {
+    EXPECT_EQ(RemoveTimestamp(line), GetLineFormat("INFO", std::to_string(first_index + index)));
+  }
+}
+
+TEST_F(TraceLogTest, DecodesAllMessagesFromConcurrentThreads) {
+  static constexpr auto kThreadCount = 8;
+  static constexpr auto kMessageCount = 1'000;
+  {
+    vktf::TraceLog trace_log{GetCreateInfo(1ull << 20u)};
+    std::vector<std::jthread> threads;
+    for (auto thread_index = 0; thread_index < kThreadCount; ++thread_index) {
+      threads.emplace_back([&trace_log, this, thread_index] {
+        for (auto index = 0; index < kMessageCount; ++index) {
+          trace_log.Write(0, source_location_, "{}:{}", thread_index, index);
+        }
+      });
+    }
+  }
+
+  std::vector<std::string> expected_lines;
+  for (auto thread_index = 0; thread_index < kThreadCount; ++thread_index) {
+    for (auto index = 0; index < kMessageCount; ++index) {
+      expected_lines.push_back(GetLineFormat("INFO", std::format("{}:{}", thread_index, index)));
+    }
+  }
+
+  auto actual_lines = Decode() | std::views::transform(RemoveTimestamp) | std::ranges::to<std::vector>();
+
+  std::ranges::sort(expected_lines);
+  std::ranges::sort(actual_lines);
+  EXPECT_EQ(expected_lines, actual_lines);
+}
+
+TEST_F(TraceLogTest, RecordsLogMessagesInsteadOfWritingToOutputStreams) {
+  std::ostringstream ostream;
+  {
+    vktf::TraceLog trace_log{GetCreateInfo()};
+    vktf::Log log{ostream, ostream, ostream};
+    log.SetTraceLog(&trace_log);
+    log(vktf::Log::Severity::kWarning, source_location_).Print("{} + {} = {}", 1, 2, 3);
+    log(vktf::Log::Severity::kError, source_location_) << "A" << 'B' << 3;
+  }
+
+  EXPECT_EQ(0, ostream.tellp());
+
+  const auto lines = Decode();
+  ASSERT_EQ(lines.size(), 2uz);
+  EXPECT_EQ(RemoveTimestamp(lines[0]), GetLineFormat("WARNING", "1 + 2 = 3"));
+  EXPECT_EQ(RemoveTimestamp(lines[1]), GetLineFormat("ERROR", "AB3"));
+}
+
+TEST_F(TraceLogTest, RecordsMessagesWrittenWhileFormattingArguments) {
+  {
+    vktf::TraceLog trace_log{GetCreateInfo()};
+    trace_log.Write(1, source_location_, "{} {}", NestedMessage{&trace_log, source_location_}, 42);
+  }
+
+  // nested messages are completed first and must not overwrite the arguments of the message being formatted
+  const auto lines = Decode();
+  ASSERT_EQ(lines.size(), 2uz);
+  EXPECT_EQ(RemoveTimestamp(lines[0]), GetLineFormat("INFO", "inner"));
+  EXPECT_EQ(RemoveTimestamp(lines[1]), GetLineFormat("WARNING", "outer 42"));
+}
+
+TEST_F(TraceLogTest, RecordsSitesForSuccessiveTraceLogs) {
+  for (auto index = 0; index < 3; ++index) {
+    {
+      vktf::TraceLog trace_log{GetCreateInfo()};
+      trace_log.Write(0, source_location_, "{}", index);
+    }
+
+    // sites cached by this thread for destroyed trace logs must not be reused by new trace logs
+    const auto lines = Decode();
+    ASSERT_EQ(lines.size(), 1uz);
+    EXPECT_EQ(RemoveTimestamp(lines[0]), GetLineFormat("INFO", std::to_string(index)));
+  }
+}
+
+TEST_F(TraceLogTest, ThrowsWhenDecodingInvalidTraceData) {
+  static constexpr std::array<std::byte, 64> kInvalidTraceData{};
+  std::ostringstream trace_ostream;
+  EXPECT_THROW(vktf::DecodeTrace(kInvalidTraceData, trace_ostream), std::runtime_error);
+}
+
+TEST_F(TraceLogTest, ThrowsWhenCreatedWithAnInvalidRingSize) {
+  EXPECT_THROW(const vktf::TraceLog trace_log{GetCreateInfo(kRingSize + 1)}, std::runtime_error);
+}
+
+}  // namespace
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+import bounding_box;
+import view_frustum;
+
+namespace {
+
+// =====================================================================================================================
+// Constants
+// =====================================================================================================================
+
+constexpr auto kEpsilon = 1.0e-5f;
+constexpr auto kVisibilityMaskBits = 64uz;
+
+// =====================================================================================================================
+// Helpers
+// =====================================================================================================================
+
+vktf::ViewFrustum CreateViewFrustum() {
+  const auto projection_transform = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+  const auto view_transform = glm::lookAt(glm::vec3{0.0f}, glm::vec3{0.0f, 0.0f, -1.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+  return vktf::ViewFrustum{projection_transform * view_transform};
+}
+
+std::vector<vktf::BoundingBox> CreateRandomBoundingBoxes(const std::size_t bounding_box_count) {
+  std::mt19937 random_engine{42};  // use a fixed seed for reproducible test results
+  std::uniform_real_distribution position_distribution{-150.0f, 150.0f};
+  std::uniform_real_distribution extent_distribution{0.0f, 10.0f};
+
+  std::vector<vktf::BoundingBox> bounding_boxes;
+  bounding_boxes.reserve(bounding_box_count);
+
+  for (auto index = 0uz; index < bounding_box_count; ++index) {
+    const glm::vec3 min{position_distribution(random_engine),
+                        position_distribution(random_engine),
+                        position_distribution(random_engine)};
+    const glm::vec3 extent{extent_distribution(random_engine),
+                           extent_distribution(random_engine),
+                           extent_distribution(random_engine)};
+    bounding_boxes.emplace_back(min, min + extent);
+  }
+
+  return bounding_boxes;
+}
+
+bool IsVisible(const std::vector<std::uint64_t>& visibility_mask, const std::size_t index) {
+  return ((visibility_mask[index / kVisibilityMaskBits] >> (index % kVisibilityMaskBits)) & 1u) != 0;
+}
+
+void ExpectNear(const glm::vec3& actual, const glm::vec3& expected) {
+  EXPECT_NEAR(actual.x, expected.x, kEpsilon);
+  EXPECT_NEAR(actual.y, expected.y, kEpsilon);
+  EXPECT_NEAR(actual.z, expected.z, kEpsilon);
+}
+
+// =====================================================================================================================
+// Bounding Box Tests
+// =====================================================================================================================
+
+TEST(BoundingBoxTest, TransformTranslatesBoundingBox) {
+  const vktf::BoundingBox bounding_box{.min = glm::vec3{-1.0f, -2.0f, -3.0f}, .max = glm::vec3{1.0f, 2.0f, 3.0f}};
+  const auto transform = glm::translate(glm::mat4{1.0f}, glm::vec3{10.0f, 20.0f, 30.0f});
+
+  const auto [min, max] = vktf::Transform(bounding_box, transform);
+
+  ExpectNear(min, glm::vec3{9.0f, 18.0f, 27.0f});
+  ExpectNear(max, glm::vec3{11.0f, 22.0f, 33.0f});
+}
+
+TEST(BoundingBoxTest, TransformEnclosesRotatedBoundingBox) {
+  const vktf::BoundingBox bounding_box{.min = glm::vec3{-1.0f, -2.0f, -3.0f}, .max = glm::vec3{1.0f, 2.0f, 3.0f}};
+  const auto transform = glm::rotate(glm::mat4{1.0f}, glm::radians(90.0f), glm::vec3{0.0f, 1.0f, 0.0f});
+
+  const auto [min, max] = vktf::Transform(bounding_box, transform);
+
+  ExpectNear(min, glm::vec3{-3.0f, -2.0f, -1.0f});
+  ExpectNear(max, glm::vec3{3.0f, 2.0f, 1.0f});
+}
+
+TEST(BoundingBoxTest, TransformPreservesBoundingBoxWithNegativeCoordinates) {
+  const vktf::BoundingBox bounding_box{.min = glm::vec3{-5.0f, -4.0f, -3.0f}, .max = glm::vec3{-2.0f, -1.0f, -0.5f}};
+
+  const auto [min, max] = vktf::Transform(bounding_box, glm::mat4{1.0f});
+
+  ExpectNear(min, bounding_box.min);
+  ExpectNear(max, bounding_box.max);
+}
+
+TEST(BoundingBoxTest, AddStoresBoundingBoxComponents) {
+  vktf::BoundingBoxes bounding_boxes;
+  bounding_boxes.Add(vktf::BoundingBox{.min = glm::vec3{1.0f, 2.0f, 3.0f}, .max = glm::vec3{4.0f, 5.0f, 6.0f}});
+
+  ASSERT_EQ(bounding_boxes.size(), 1uz);
+  EXPECT_EQ(bounding_boxes.min_x()[0], 1.0f);
+  EXPECT_EQ(bounding_boxes.min_y()[0], 2.0f);
+  EXPECT_EQ(bounding_boxes.min_z()[0], 3.0f);
+  EXPECT_EQ(bounding_boxes.max_x()[0], 4.0f);
+  EXPECT_EQ(bounding_boxes.max_y()[0], 5.0f);
+  EXPECT_EQ(bounding_boxes.max_z()[0], 6.0f);
+
+  bounding_boxes.Clear();
+  EXPECT_EQ(bounding_boxes.size(), 0uz);
+}
+
+// =====================================================================================================================
+// View Frustum Tests
+// =====================================================================================================================
+
+TEST(ViewFrustumTest, IntersectsBoundingBoxInsideViewFrustum) {
+  const auto view_frustum = CreateViewFrustum();
+  EXPECT_TRUE(view_frustum.Intersects(
+      vktf::BoundingBox{.min = glm::vec3{-1.0f, -1.0f, -11.0f}, .max = glm::vec3{1.0f, 1.0f, -9.0f}}));
+}
+
+TEST(ViewFrustumTest, DoesNotIntersectBoundingBoxBehindCamera) {
+  const auto view_frustum = CreateViewFrustum();
+  EXPECT_FALSE(view_frustum.Intersects(
+      vktf::BoundingBox{.min = glm::vec3{-1.0f, -1.0f, 9.0f}, .max = glm::vec3{1.0f, 1.0f, 11.0f}}));
+}
+
+class ViewFrustumBatchTest : public testing::TestWithParam<std::size_t> {};
+
+INSTANTIATE_TEST_SUITE_P(ViewFrustumBatchTest,
+                         ViewFrustumBatchTest,
+                         testing::Values(0uz, 1uz, 15uz, 16uz, 17uz, 63uz, 64uz, 65uz, 1'000uz));
+
+TEST_P(ViewFrustumBatchTest, BatchedIntersectsMatchesIndividualIntersects) {
+  const auto view_frustum = CreateViewFrustum();
+  const auto bounding_box_count = GetParam();
+  const auto bounding_boxes = CreateRandomBoundingBoxes(bounding_box_count);
+
+  vktf::BoundingBoxes world_bounding_boxes;
+  world_bounding_boxes.Reserve(bounding_box_count);
+  for (const auto& bounding_box : bounding_boxes) {
+    world_bounding_boxes.Add(bounding_box);
+  }
+
+  // initialize bits to verify the visibility mask is overwritten rather than accumulated
+  std::vector<std::uint64_t> visibility_mask((bounding_box_count + kVisibilityMaskBits - 1) / kVisibilityMaskBits,
+                                             ~std::uint64_t{0});
+  view_frustum.Intersects(world_bounding_boxes, visibility_mask);
+
+  for (auto index = 0uz; index < bounding_box_count; ++index) {
+    EXPECT_EQ(IsVisible(visibility_mask, index), view_frustum.Intersects(bounding_boxes[index]))
+        << "Bounding box " << index;
+  }
+}
+
+TEST_P(ViewFrustumBatchTest, RangeIntersectsMatchesIndividualIntersects) {
+  const auto view_frustum = CreateViewFrustum();
+  const auto bounding_box_count = GetParam();
+  const auto bounding_boxes = CreateRandomBoundingBoxes(bounding_box_count);
+
+  vktf::BoundingBoxes world_bounding_boxes;
+  for (const auto& bounding_box : bounding_boxes) {
+    world_bounding_boxes.Add(bounding_box);
+  }
+
+  // ranges start at an odd offset to verify batches do not assume aligned first indices
+  for (auto first_index = std::min(bounding_box_count, 3uz); first_index < bounding_box_count;
+       first_index += kVisibilityMaskBits) {
+    const auto count = std::min(kVisibilityMaskBits, bounding_box_count - first_index);
+    const auto range_mask = view_frustum.Intersects(world_bounding_boxes, first_index, count);
+    for (auto offset = 0uz; offset < count; ++offset) {
+      EXPECT_EQ((range_mask >> offset & 1u) != 0, view_frustum.Intersects(bounding_boxes[first_index + offset]))
+          << "Bounding box " << first_index + offset;
+    }
+  }
+}
+
+}  // namespace